@@ -122,6 +122,10 @@ FUNC_NORETURN void z_x86_cpu_init(struct x86_cpuboot *cpuboot)
 		arch_data_copy();
 	}
 
+#if defined(CONFIG_SMP) && defined(CONFIG_X86_MMU_LARGE_PAGES)
+	z_x86_mmu_cpu_online(cpuboot->cpu_id);
+#endif
+
 	z_loapic_enable(cpuboot->cpu_id);
 
 #ifdef CONFIG_USERSPACE
@@ -10,6 +10,7 @@
 #include <zephyr/kernel/mm.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/logging/log.h>
 #include <errno.h>
 #include <ctype.h>
@@ -404,6 +405,24 @@ static inline bool is_flipped_pte(pentry_t pte)
 #endif
 
 #if defined(CONFIG_SMP)
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+/* Incremented when each CPU enters and leaves z_x86_tlb_ipi(), odd while
+ * a flush is in progress. See stale_table_flushed().
+ */
+__pinned_bss
+static atomic_t tlb_ipi_count[CONFIG_MP_MAX_NUM_CPUS];
+
+/* CPUs that may have paging-structure caches to flush */
+__pinned_bss
+static atomic_t tlb_cpus_online;
+
+__pinned_func
+void z_x86_mmu_cpu_online(unsigned int cpu_id)
+{
+	(void)atomic_or(&tlb_cpus_online, BIT(cpu_id));
+}
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 __pinned_func
 void z_x86_tlb_ipi(const void *arg)
 {
@@ -411,6 +430,10 @@ void z_x86_tlb_ipi(const void *arg)
 
 	ARG_UNUSED(arg);
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+	(void)atomic_inc(&tlb_ipi_count[arch_curr_cpu()->id]);
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 #ifdef CONFIG_X86_KPTI
 	/* We're always on the kernel's set of page tables in this context
 	 * if KPTI is turned on
@@ -432,6 +455,10 @@ void z_x86_tlb_ipi(const void *arg)
 	LOG_DBG("%s on CPU %d\n", __func__, arch_curr_cpu()->id);
 
 	z_x86_cr3_set(ptables_phys);
+
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+	(void)atomic_inc(&tlb_ipi_count[arch_curr_cpu()->id]);
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
 }
 
 /* NOTE: This is not synchronous and the actual flush takes place some short
@@ -969,6 +996,283 @@ static inline pentry_t pte_atomic_update(pentry_t *pte, pentry_t update_val,
 	return old_val;
 }
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_X86_COMMON_PAGE_TABLE)
+static void *page_pool_get(void);
+#endif
+
+/* Page tables displaced by large pages, linked through their first entry.
+ * Setting up a large page in place of an unused page table leaves that
+ * table here, to be used again when a large page is split or un-mapped.
+ *
+ * x86_mmu_lock must be held.
+ */
+__pinned_bss
+static pentry_t *spare_tables;
+
+__pinned_func
+static void spare_table_put(pentry_t *table)
+{
+	table[0] = (pentry_t)POINTER_TO_UINT(spare_tables);
+	spare_tables = table;
+}
+
+#ifdef CONFIG_SMP
+/* Page tables displaced from a present page directory entry, which other
+ * CPUs may still walk through from their paging-structure caches until
+ * they have handled the TLB shootdown. Linked through their first entry;
+ * the next ones hold the CPU that displaced them, the CPUs online and the
+ * tlb_ipi_count of every CPU at that time.
+ *
+ * x86_mmu_lock must be held.
+ */
+__pinned_bss
+static pentry_t *stale_tables;
+
+#define STALE_CPU    1
+#define STALE_ONLINE 2
+#define STALE_COUNT  3
+
+__pinned_func
+static void stale_table_put(pentry_t *table)
+{
+	/* The page directory entry must be visible before the counts are
+	 * sampled
+	 */
+	barrier_dmem_fence_full();
+
+	table[STALE_CPU] = (pentry_t)arch_curr_cpu()->id;
+	table[STALE_ONLINE] = (pentry_t)(uint32_t)atomic_get(&tlb_cpus_online);
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		table[STALE_COUNT + i] = (pentry_t)(uint32_t)atomic_get(&tlb_ipi_count[i]);
+	}
+	table[0] = (pentry_t)POINTER_TO_UINT(stale_tables);
+	stale_tables = table;
+}
+
+/* Whether every other CPU ran a whole TLB flush since the table was put */
+__pinned_func
+static bool stale_table_flushed(const pentry_t *table)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		uint32_t then = (uint32_t)table[STALE_COUNT + i];
+		uint32_t now = (uint32_t)atomic_get(&tlb_ipi_count[i]);
+
+		if ((i == (unsigned int)table[STALE_CPU]) ||
+		    ((table[STALE_ONLINE] & BIT(i)) == 0U)) {
+			continue;
+		}
+
+		/* A flush in progress may have started before the table
+		 * was displaced, wait for the next one
+		 */
+		if ((now - then) < (2U + (then & 1U))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Move the stale tables all CPUs are done with to the spare tables */
+__pinned_func
+static void stale_tables_reclaim(void)
+{
+	pentry_t *prev = NULL;
+	pentry_t *table = stale_tables;
+
+	while (table != NULL) {
+		pentry_t *next = UINT_TO_POINTER((uintptr_t)table[0]);
+
+		if (stale_table_flushed(table)) {
+			if (prev == NULL) {
+				stale_tables = next;
+			} else {
+				prev[0] = table[0];
+			}
+			for (unsigned int i = 1; i < (STALE_COUNT + arch_num_cpus()); i++) {
+				table[i] = 0;
+			}
+			spare_table_put(table);
+		} else {
+			prev = table;
+		}
+		table = next;
+	}
+}
+#endif /* CONFIG_SMP */
+
+/* Return a zeroed page table, or NULL if none is left */
+__pinned_func
+static pentry_t *spare_table_get(void)
+{
+	pentry_t *table;
+
+#ifdef CONFIG_SMP
+	if (spare_tables == NULL) {
+		stale_tables_reclaim();
+	}
+#endif /* CONFIG_SMP */
+
+	table = spare_tables;
+	if (table != NULL) {
+		/* The other entries were all zero when it was put */
+		spare_tables = UINT_TO_POINTER((uintptr_t)table[0]);
+		table[0] = 0;
+	}
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_X86_COMMON_PAGE_TABLE)
+	else {
+		table = page_pool_get();
+	}
+#endif
+
+	return table;
+}
+
+/* Get the page directory entry for a virtual address, or NULL if there is
+ * none as some higher level entry is not present or a leaf.
+ */
+__pinned_func
+static pentry_t *pde_get(pentry_t *ptables, void *virt)
+{
+	pentry_t *table = ptables;
+
+	for (int level = 0; level < PDE_LEVEL; level++) {
+		pentry_t entry = get_entry(table, virt, level);
+
+		if (((entry & MMU_P) == 0U) || is_leaf(level, entry)) {
+			return NULL;
+		}
+		table = next_table(entry, level);
+	}
+
+	return get_entry_ptr(table, virt, PDE_LEVEL);
+}
+
+/**
+ * Split a large page
+ *
+ * The large page mapped by the page directory entry is replaced with a page
+ * table mapping the same memory with the same attributes, so that its pages
+ * can then be updated individually.
+ *
+ * @param entryp Page directory entry mapping a large page
+ * @param virt Virtual address within the large page
+ *
+ * @retval 0 if successful
+ * @retval -ENOMEM if no page table is available
+ */
+__pinned_func
+static int large_page_split(pentry_t *entryp, void *virt)
+{
+	pentry_t entry = atomic_pte_get(entryp);
+	uintptr_t phys = get_entry_phys(entry, PDE_LEVEL);
+	pentry_t flags = entry & ~(paging_levels[PDE_LEVEL].mask | MMU_PS);
+	pentry_t *table = spare_table_get();
+
+	if (table == NULL) {
+		LOG_ERR("no page table left to split large page at %p", virt);
+		return -ENOMEM;
+	}
+
+	for (size_t i = 0; i < get_num_entries(PTE_LEVEL); i++) {
+		table[i] = (pentry_t)(phys + (i * CONFIG_MMU_PAGE_SIZE)) | flags;
+	}
+
+	/* Every translation stays the same, only the page size changes, so
+	 * other CPUs may keep using the large page until they flush it.
+	 */
+	*entryp = ((pentry_t)k_mem_phys_addr(table) | INT_FLAGS);
+	tlb_flush_page(virt);
+
+	return 0;
+}
+
+/**
+ * Update a whole large page worth of a region at once
+ *
+ * New mappings of suitably aligned physical memory over an unused page table
+ * are made with a large page. Existing large pages are un-mapped or have
+ * their attributes updated in place. See range_map_ptables() for the
+ * parameters.
+ *
+ * @return Size of the region updated, or 0 if it must be updated page by page
+ */
+__pinned_func
+static size_t large_page_update(pentry_t *ptables, uint8_t *virt,
+				uintptr_t phys, size_t size,
+				pentry_t entry_flags, pentry_t mask,
+				uint32_t options)
+{
+	size_t scope = get_entry_scope(PDE_LEVEL);
+	bool clear = (options & OPTION_CLEAR) != 0U;
+	bool reset = (options & OPTION_RESET) != 0U;
+	pentry_t *entryp;
+	pentry_t *table;
+	pentry_t entry;
+
+	if ((size < scope) || ((POINTER_TO_UINT(virt) % scope) != 0U)) {
+		return 0;
+	}
+
+	entryp = pde_get(ptables, virt);
+	if (entryp == NULL) {
+		return 0;
+	}
+	entry = atomic_pte_get(entryp);
+
+	if ((entry & MMU_PS) != 0U) {
+		if (clear) {
+			table = spare_table_get();
+			if (table == NULL) {
+				return 0;
+			}
+			*entryp = ((pentry_t)k_mem_phys_addr(table) | INT_FLAGS);
+		} else if (reset ||
+			   ((mask & paging_levels[PDE_LEVEL].mask) == 0U)) {
+			/* Attributes apply to the large page as a whole */
+			(void)pte_atomic_update(entryp, entry_flags, mask,
+						options);
+		} else {
+			return 0;
+		}
+	} else {
+		if (clear || reset || (mask != MASK_ALL) ||
+		    ((entry & MMU_P) == 0U) || ((entry_flags & MMU_P) == 0U) ||
+		    ((phys % scope) != 0U)) {
+			return 0;
+		}
+
+		/* Only take the place of a page table mapping nothing */
+		table = next_table(entry, PDE_LEVEL);
+		for (size_t i = 0; i < get_num_entries(PTE_LEVEL); i++) {
+			if (table[i] != 0U) {
+				return 0;
+			}
+		}
+
+		*entryp = ((pentry_t)phys | entry_flags | MMU_PS);
+
+		/* No CPU may walk through the table once it is used again,
+		 * whatever the options
+		 */
+		tlb_flush_page(virt);
+#ifdef CONFIG_SMP
+		stale_table_put(table);
+		tlb_shootdown();
+#else
+		spare_table_put(table);
+#endif /* CONFIG_SMP */
+	}
+
+	if ((options & OPTION_FLUSH) != 0U) {
+		tlb_flush_page(virt);
+	}
+
+	return scope;
+}
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 /**
  * Low level page table update function for a virtual page
  *
@@ -999,6 +1303,7 @@ static inline pentry_t pte_atomic_update(pentry_t *pte, pentry_t update_val,
  *
  * @retval 0 if successful
  * @retval -EFAULT if large page encountered or missing page table level
+ * @retval -ENOMEM if no page table is available to split a large page
  */
 __pinned_func
 static int page_map_set(pentry_t *ptables, void *virt, pentry_t entry_val,
@@ -1025,6 +1330,15 @@ static int page_map_set(pentry_t *ptables, void *virt, pentry_t entry_val,
 			break;
 		}
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+		if ((level == PDE_LEVEL) && ((*entryp & MMU_PS) != 0U)) {
+			ret = large_page_split(entryp, virt);
+			if (ret != 0) {
+				goto out;
+			}
+		}
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 		/* We bail out early here due to no support for
 		 * splitting existing bigpage mappings.
 		 * If the PS bit is not supported at some level (like
@@ -1119,6 +1433,18 @@ static int range_map_ptables(pentry_t *ptables, void *virt, uintptr_t phys,
 		uint8_t *dest_virt = (uint8_t *)virt + offset;
 		pentry_t entry_val;
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+		size_t done = large_page_update(ptables, dest_virt,
+						phys + offset, size - offset,
+						entry_flags, mask, options);
+
+		if (done != 0U) {
+			/* Accounts for the increment of the loop */
+			offset += done - CONFIG_MMU_PAGE_SIZE;
+			continue;
+		}
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 		if (zero_entry) {
 			entry_val = 0;
 		} else {
@@ -1314,6 +1640,20 @@ void arch_mem_unmap(void *addr, size_t size)
 	ARG_UNUSED(ret);
 }
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+/* Align regions large enough to be mapped with large pages on them */
+size_t arch_virt_region_align(uintptr_t phys, size_t size)
+{
+	size_t scope = get_entry_scope(PDE_LEVEL);
+
+	if ((size >= scope) && ((phys % scope) == 0U)) {
+		return scope;
+	}
+
+	return CONFIG_MMU_PAGE_SIZE;
+}
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 #ifdef K_MEM_IS_VM_KERNEL
 __boot_func
 static void identity_map_remove(uint32_t level)
@@ -2076,7 +2416,9 @@ int arch_page_phys_get(void *virt, uintptr_t *phys)
 
 	if ((pte & MMU_P) != 0) {
 		if (phys != NULL) {
-			*phys = (uintptr_t)get_entry_phys(pte, PTE_LEVEL);
+			/* Add the offset of the page within a large page */
+			*phys = (uintptr_t)get_entry_phys(pte, level) +
+				(POINTER_TO_UINT(virt) & (get_entry_scope(level) - 1));
 		}
 		ret = 0;
 	} else {
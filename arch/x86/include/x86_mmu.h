@@ -226,6 +226,11 @@ static inline pentry_t *z_x86_thread_page_tables_get(struct k_thread *thread)
 #ifdef CONFIG_SMP
 /* Handling function for TLB shootdown inter-processor interrupts. */
 void z_x86_tlb_ipi(const void *arg);
+
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+/* Called by each CPU once it runs on the kernel page tables */
+void z_x86_mmu_cpu_online(unsigned int cpu_id);
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
 #endif
 
 #ifdef CONFIG_X86_COMMON_PAGE_TABLE
@@ -466,6 +466,11 @@ struct device_state {
 	 * invoked.
 	 */
 	bool initialized : 1;
+
+#if defined(CONFIG_DEVICE_NAME_HASH) || defined(__DOXYGEN__)
+	/** Next device in the same bucket of the device name hash table. */
+	device_handle_t name_next;
+#endif /* CONFIG_DEVICE_NAME_HASH */
 };
 
 struct pm_device_base;
@@ -818,8 +823,9 @@ int device_supported_foreach(const struct device *dev,
 /**
  * @brief Get a @ref device reference from its @ref device.name field.
  *
- * This function iterates through the devices on the system. If a device with
- * the given @p name field is found, and that device initialized successfully at
+ * This function iterates through the devices on the system, or looks them up
+ * in a hash table with @kconfig{CONFIG_DEVICE_NAME_HASH}. If a device with the
+ * given @p name field is found, and that device initialized successfully at
  * boot time, this function returns a pointer to the device.
  *
  * If no device has the given @p name, this function returns `NULL`.
@@ -1265,6 +1271,7 @@ device_get_dt_nodelabels(const struct device *dev)
 		Z_INIT_ENTRY_NAME(DEVICE_NAME_GET(dev_id)) = {                                     \
 			.init_fn = NULL,                                                           \
 			.dev = (const struct device *)&DEVICE_NAME_GET(dev_id),                    \
+			IF_ENABLED(CONFIG_DEVICE_INIT_PARALLEL, (.prio = (prio),))                 \
 		}
 
 /**
@@ -74,8 +74,44 @@ struct init_entry {
 	 * reference to it, otherwise it is set to NULL.
 	 */
 	const struct device *dev;
+#if defined(CONFIG_DEVICE_INIT_PARALLEL) || defined(__DOXYGEN__)
+	/**
+	 * Initialization priority of a device, so that only devices of the
+	 * same priority are initialized in parallel. Set to 0 for SYS_INIT.
+	 */
+	uint16_t prio;
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+};
+
+#if defined(CONFIG_INIT_TIMINGS) || defined(__DOXYGEN__)
+/**
+ * @brief Time taken by an init function.
+ */
+struct init_timing {
+	/** Init entry of the init function. */
+	const struct init_entry *entry;
+	/** Init level, as given by INIT_LEVEL_ORD(). */
+	uint16_t level;
+	/** Result of the init function. */
+	int16_t result;
+	/** Hardware cycles from the call of the init function to its return. */
+	uint32_t cycles;
 };
 
+/**
+ * @brief Get the times taken by the init functions run so far.
+ *
+ * Only the init functions of the POST_KERNEL and later levels are timed, in
+ * the order they returned, up to @kconfig{CONFIG_INIT_TIMINGS_MAX}. Only
+ * available if @kconfig{CONFIG_INIT_TIMINGS} is enabled.
+ *
+ * @param[out] count Number of timings.
+ *
+ * @return Array of @p count timings.
+ */
+const struct init_timing *sys_init_timings_get(size_t *count);
+#endif /* CONFIG_INIT_TIMINGS */
+
 /** @cond INTERNAL_HIDDEN */
 
 /* Helper definitions to evaluate level equality */
@@ -390,6 +390,50 @@ __syscall k_thread_stack_t *k_thread_stack_alloc(size_t size, int flags);
  */
 __syscall int k_thread_stack_free(k_thread_stack_t *stack);
 
+/**
+ * @brief Create a thread with a dynamically allocated object and stack.
+ *
+ * Allocate a thread object and a stack of at least @p stack_size bytes and
+ * create a supervisor thread with them, as with k_thread_create(). Once the
+ * thread has exited, it must be released with k_thread_dynamic_release().
+ *
+ * Released thread objects and stacks are kept for reuse by later threads of
+ * the same stack size class, up to @kconfig{CONFIG_DYNAMIC_THREAD_CACHE_SIZE}
+ * per class, which makes creating short-lived threads cheaper.
+ *
+ * @param stack_size Stack size in bytes.
+ * @param entry Thread entry function.
+ * @param p1 1st entry point parameter.
+ * @param p2 2nd entry point parameter.
+ * @param p3 3rd entry point parameter.
+ * @param prio Thread priority.
+ * @param options Thread options, except @ref K_USER.
+ * @param delay Scheduling delay, or K_NO_WAIT (for no delay).
+ *
+ * @retval ID of the new thread on success.
+ * @retval NULL if out of memory, if @p options has @ref K_USER, or if
+ * @kconfig{CONFIG_DYNAMIC_THREAD_ALLOC} is disabled.
+ *
+ * @see @kconfig{CONFIG_DYNAMIC_THREAD}
+ */
+k_tid_t k_thread_dynamic_create(size_t stack_size, k_thread_entry_t entry,
+				void *p1, void *p2, void *p3, int prio,
+				uint32_t options, k_timeout_t delay);
+
+/**
+ * @brief Release a thread created with k_thread_dynamic_create().
+ *
+ * @param thread Thread, which must have exited, for instance as seen by
+ * k_thread_join().
+ *
+ * @retval 0 on success.
+ * @retval -EBUSY if the thread has not exited.
+ * @retval -ENOSYS if @kconfig{CONFIG_DYNAMIC_THREAD_ALLOC} is disabled.
+ *
+ * @see @kconfig{CONFIG_DYNAMIC_THREAD}
+ */
+int k_thread_dynamic_release(k_tid_t thread);
+
 /**
  * @brief Create a thread.
  *
@@ -1021,6 +1065,45 @@ __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
  * @param deadline A timestamp, in cycle units
  */
 __syscall void k_thread_absolute_deadline_set(k_tid_t thread, int deadline);
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Reserve a CPU bandwidth for a thread
+ *
+ * This attaches a constant bandwidth server to the thread: it is allowed
+ * @a budget_us microseconds of CPU time every @a period_us microseconds,
+ * and its deadline is managed by the kernel from then on. Each time the
+ * thread becomes runnable with no usable budget left, its deadline is set
+ * one period away and its budget replenished. Each time it uses up its
+ * budget, its deadline is postponed by one period, so a thread running
+ * longer than it declared cannot delay the other deadline threads of its
+ * priority. The budget is enforced with a resolution of one tick.
+ *
+ * The request is refused if the sum of the bandwidths of all threads
+ * would exceed @kconfig{CONFIG_SCHED_DEADLINE_CBS_MAX_UTILIZATION} percent
+ * of each CPU. A budget of zero removes the reservation; the deadline of
+ * the thread is then left alone.
+ *
+ * The number of times the thread blocked past its deadline and the number
+ * of times it used up its budget are reported by
+ * k_thread_runtime_stats_get().
+ *
+ * @note Calling k_thread_deadline_set() on a thread with a reservation
+ * only changes its deadline until the next replenishment.
+ *
+ * @kconfig_dep{CONFIG_SCHED_DEADLINE_CBS}
+ *
+ * @param thread A thread to reserve a bandwidth for
+ * @param budget_us CPU time allowed per period, in microseconds
+ * @param period_us Period, in microseconds
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the budget exceeds the period or the period is too long
+ * @retval -EBUSY if the bandwidth is not available
+ */
+__syscall int k_thread_cbs_set(k_tid_t thread, uint32_t budget_us,
+			       uint32_t period_us);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 #endif
 
 /**
@@ -1668,6 +1751,11 @@ struct k_timer {
 	/* user-specific data, also used to support legacy features */
 	void *user_data;
 
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* ticks by which each expiry may be deferred */
+	uint32_t slack;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_timer)
 
 #ifdef CONFIG_OBJ_CORE_TIMER
@@ -1925,6 +2013,34 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
 	return timer->user_data;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Set the slack of a timer.
+ *
+ * Lets the kernel defer each expiry of @a timer by up to @a slack, so that
+ * it can expire on the same tick as other timeouts due around the same
+ * time. This reduces the number of wakeups when many timers with loose
+ * deadlines are running, at the cost of their precision. Since a periodic
+ * timer restarts from the time it actually expired, its expiries may drift
+ * by up to @a slack per period.
+ *
+ * The slack is applied the next time the timer is started or restarts
+ * itself. It defaults to K_NO_WAIT, which disables it.
+ *
+ * @param timer Address of timer.
+ * @param slack Maximum deferral of each expiry, a relative timeout.
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+
+static inline void z_impl_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	__ASSERT(Z_IS_TIMEOUT_RELATIVE(slack) && !K_TIMEOUT_EQ(slack, K_FOREVER),
+		 "slack must be a finite relative timeout");
+	timer->slack = (uint32_t)MIN(slack.ticks, UINT32_MAX);
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 /** @} */
 
 /**
@@ -2064,6 +2180,15 @@ struct k_queue {
 	struct k_spinlock lock;
 	_wait_q_t wait_q;
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	/* Nodes prepended without the lock, most recent first */
+	atomic_ptr_t prepend_list;
+	/* Nodes appended without the lock, most recent first */
+	atomic_ptr_t append_list;
+	/* Number of threads pending on the queue */
+	atomic_t waiters;
+#endif /* CONFIG_QUEUE_LOCKLESS */
+
 	Z_DECL_POLL_EVENT
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_queue)
@@ -2301,6 +2426,13 @@ __syscall int k_queue_is_empty(struct k_queue *queue);
 
 static inline int z_impl_k_queue_is_empty(struct k_queue *queue)
 {
+#ifdef CONFIG_QUEUE_LOCKLESS
+	if ((atomic_ptr_get(&queue->prepend_list) != NULL) ||
+	    (atomic_ptr_get(&queue->append_list) != NULL)) {
+		return 0;
+	}
+#endif /* CONFIG_QUEUE_LOCKLESS */
+
 	return sys_sflist_is_empty(&queue->data_q) ? 1 : 0;
 }
 
@@ -2443,6 +2575,7 @@ struct k_event {
  */
 	_wait_q_t         wait_q;
 	uint32_t          events;
+	uint32_t          wait_mask;
 	struct k_spinlock lock;
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_event)
@@ -2464,6 +2597,7 @@ struct k_event {
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
 	.events = 0, \
+	.wait_mask = 0, \
 	.lock = {}, \
 	}
 /**
@@ -3062,6 +3196,21 @@ struct k_stack {
 
 	uint8_t flags;
 
+#ifdef CONFIG_STACK_LOCKLESS
+	/* Next slot links of the lock-free slot stacks, NULL if the stack
+	 * is not lock-free
+	 */
+	uint16_t *links;
+	/* Lock-free stack of the slots holding data */
+	atomic_t used;
+	/* Lock-free stack of the released slots */
+	atomic_t free;
+	/* Number of slots used at least once */
+	atomic_t fresh;
+	/* Number of threads pending on the stack */
+	atomic_t waiters;
+#endif /* CONFIG_STACK_LOCKLESS */
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_stack)
 
 #ifdef CONFIG_OBJ_CORE_STACK
@@ -3070,11 +3219,35 @@ struct k_stack {
 };
 
 #define Z_STACK_INITIALIZER(obj, stack_buffer, stack_num_entries) \
+	Z_STACK_INITIALIZER_LINKS(obj, stack_buffer, NULL, stack_num_entries)
+
+#ifdef CONFIG_STACK_LOCKLESS
+/* Slot links hold a slot index plus one, zero ending a list */
+#define Z_STACK_LOCKLESS_MAX_ENTRIES UINT16_MAX
+
+#define Z_STACK_LINKS_DEFINE(name, stack_num_entries) \
+	static uint16_t __noinit \
+		_k_stack_links_##name[stack_num_entries];
+
+#define Z_STACK_LINKS(name) _k_stack_links_##name
+
+#define Z_STACK_LINKS_INIT(stack_links, stack_num_entries) \
+	.links = ((stack_num_entries) <= Z_STACK_LOCKLESS_MAX_ENTRIES) ? \
+		 (stack_links) : NULL,
+#else
+#define Z_STACK_LINKS_DEFINE(name, stack_num_entries)
+#define Z_STACK_LINKS(name) NULL
+#define Z_STACK_LINKS_INIT(stack_links, stack_num_entries)
+#endif /* CONFIG_STACK_LOCKLESS */
+
+#define Z_STACK_INITIALIZER_LINKS(obj, stack_buffer, stack_links, \
+				  stack_num_entries) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&(obj).wait_q),	\
 	.base = (stack_buffer), \
 	.next = (stack_buffer), \
 	.top = (stack_buffer) + (stack_num_entries), \
+	Z_STACK_LINKS_INIT(stack_links, stack_num_entries) \
 	}
 
 /**
@@ -3092,6 +3265,10 @@ struct k_stack {
  *
  * This routine initializes a stack object, prior to its first use.
  *
+ * @note With CONFIG_STACK_LOCKLESS, stacks initialized with this routine
+ * still take the stack lock to push and pop values. Use K_STACK_DEFINE()
+ * or k_stack_alloc_init() for lock-free stacks.
+ *
  * @param stack Address of the stack.
  * @param buffer Address of array used to hold stacked values.
  * @param num_entries Maximum number of values that can be stacked.
@@ -3181,9 +3358,11 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 #define K_STACK_DEFINE(name, stack_num_entries)                \
 	stack_data_t __noinit                                  \
 		_k_stack_buf_##name[stack_num_entries];        \
+	Z_STACK_LINKS_DEFINE(name, stack_num_entries)          \
 	STRUCT_SECTION_ITERABLE(k_stack, name) =               \
-		Z_STACK_INITIALIZER(name, _k_stack_buf_##name, \
-				    stack_num_entries)
+		Z_STACK_INITIALIZER_LINKS(name, _k_stack_buf_##name, \
+					  Z_STACK_LINKS(name),   \
+					  stack_num_entries)
 
 /** @} */
 
@@ -3193,6 +3372,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -3887,6 +4067,48 @@ void k_work_queue_start(struct k_work_q *queue,
  */
 void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *cfg);
 
+/** @brief Initialize a work queue served by a pool of threads.
+ *
+ * This behaves like k_work_queue_start() but animates the queue with @p
+ * num_workers threads.  Each worker keeps a private list of work it
+ * submitted itself (chained submissions) and takes new work from the shared
+ * queue, stealing from the other workers when both are empty.
+ *
+ * The work item API is unchanged: a work item never runs on more than one
+ * worker at a time, resubmission of a running item is executed by the
+ * worker running it, and flush, cancel, drain and stop operate on the queue
+ * as a whole.  Items are not guaranteed to complete in submission order.
+ *
+ * k_work_queue_thread_get() returns the first worker.
+ *
+ * @note Requires CONFIG_WORKQUEUE_POOL.
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param workers array of @p num_workers worker objects.
+ *
+ * @param stacks the worker thread stacks, defined with
+ *        K_THREAD_STACK_ARRAY_DEFINE() with @p num_workers elements of
+ *        @p stack_size bytes.
+ *
+ * @param num_workers number of worker threads, at least one.
+ *
+ * @param stack_size size of each worker thread stack area, in bytes.
+ *
+ * @param prio initial priority of the worker threads
+ *
+ * @param cfg optional additional configuration parameters, applied to every
+ * worker.  Pass @c NULL if not required, to use the defaults documented in
+ * k_work_queue_config.
+ */
+void k_work_queue_pool_start(struct k_work_q *queue,
+			     struct k_work_q_worker *workers,
+			     k_thread_stack_t *stacks, size_t num_workers,
+			     size_t stack_size, int prio,
+			     const struct k_work_queue_config *cfg);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3971,6 +4193,25 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout);
 void k_work_init_delayable(struct k_work_delayable *dwork,
 			   k_work_handler_t handler);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Set the slack of a delayable work item.
+ *
+ * Lets the kernel defer the submission of @a dwork by up to @a slack past
+ * the delay it is scheduled with, so that its timeout can expire on the
+ * same tick as other timeouts due around the same time. The slack applies
+ * from the next time the work item is scheduled.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork pointer to the delayable work item.
+ * @param slack maximum deferral, a relative timeout. K_NO_WAIT, the default,
+ * disables it.
+ */
+static inline void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+					      k_timeout_t slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 /**
  * @brief Get the parent delayable work structure from a work pointer.
  *
@@ -4348,6 +4589,11 @@ struct k_work_delayable {
 
 	/* The queue to which the work should be submitted. */
 	struct k_work_q *queue;
+
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks by which the timeout may be deferred. */
+	uint32_t slack;
+#endif
 };
 
 #define Z_WORK_DELAYABLE_INITIALIZER(work_handler) { \
@@ -4472,6 +4718,28 @@ struct k_work_queue_config {
 	uint32_t work_timeout_ms;
 };
 
+/** @brief A thread serving a work queue pool.
+ *
+ * @see k_work_queue_pool_start()
+ */
+struct k_work_q_worker {
+	/* The thread that animates the worker. */
+	struct k_thread thread;
+
+	/* The queue served by the worker. */
+	struct k_work_q *queue;
+
+	/* All the following fields must be accessed only while the
+	 * work module spinlock is held.
+	 */
+
+	/* Work submitted from this worker, or to an item it is running. */
+	sys_slist_t pending;
+
+	/* The work item being run, or NULL if idle. */
+	struct k_work *work;
+};
+
 /** @brief A structure used to hold work until it can be processed. */
 struct k_work_q {
 	/* The thread that animates the work. */
@@ -4498,6 +4766,20 @@ struct k_work_q {
 	/* Flags describing queue state. */
 	uint32_t flags;
 
+#if defined(CONFIG_WORKQUEUE_POOL)
+	/* Worker threads, or NULL if the queue runs on a single thread. */
+	struct k_work_q_worker *workers;
+
+	/* Number of workers. */
+	size_t num_workers;
+
+	/* Number of workers running a work item. */
+	size_t num_busy;
+
+	/* Number of workers that have not exited after a stop. */
+	size_t num_live;
+#endif /* defined(CONFIG_WORKQUEUE_POOL) */
+
 #if defined(CONFIG_WORKQUEUE_WORK_TIMEOUT)
 	struct _timeout work_timeout_record;
 	struct k_work *work;
@@ -4536,6 +4818,16 @@ static inline k_ticks_t k_work_delayable_remaining_get(
 	return z_timeout_remaining(&dwork->timeout);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static inline void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+					      k_timeout_t slack)
+{
+	__ASSERT(Z_IS_TIMEOUT_RELATIVE(slack) && !K_TIMEOUT_EQ(slack, K_FOREVER),
+		 "slack must be a finite relative timeout");
+	dwork->slack = (uint32_t)MIN(slack.ticks, UINT32_MAX);
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue)
 {
 	return queue->thread_id;
@@ -4903,6 +5195,15 @@ struct k_msgq {
 	/** Message queue */
 	uint8_t flags;
 
+#ifdef CONFIG_MSGQ_SPSC
+	/** Producer index of a single producer single consumer queue */
+	atomic_t spsc_in;
+	/** Consumer index of a single producer single consumer queue */
+	atomic_t spsc_out;
+	/** Number of threads pending on a single producer single consumer queue */
+	atomic_t spsc_waiters;
+#endif /* CONFIG_MSGQ_SPSC */
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_msgq)
 
 #ifdef CONFIG_OBJ_CORE_MSGQ
@@ -4915,6 +5216,9 @@ struct k_msgq {
 
 
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
+	Z_MSGQ_INITIALIZER_FLAGS(obj, q_buffer, q_msg_size, q_max_msgs, 0)
+
+#define Z_MSGQ_INITIALIZER_FLAGS(obj, q_buffer, q_msg_size, q_max_msgs, q_flags) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
 	.lock = {}, \
@@ -4926,15 +5230,29 @@ struct k_msgq {
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
 	Z_POLL_EVENT_OBJ_INIT(obj) \
-	.flags = 0, \
+	.flags = q_flags, \
 	}
 
+#ifdef CONFIG_MSGQ_SPSC
+/* Number of messages held by a single producer single consumer queue.
+ * Its indices run over [0, 2 * max_msgs).
+ */
+static inline uint32_t z_msgq_spsc_used(struct k_msgq *msgq)
+{
+	uint32_t in = (uint32_t)atomic_get(&msgq->spsc_in);
+	uint32_t out = (uint32_t)atomic_get(&msgq->spsc_out);
+
+	return (in >= out) ? (in - out) : (in + (2U * msgq->max_msgs) - out);
+}
+#endif /* CONFIG_MSGQ_SPSC */
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_SPSC	BIT(1)
 
 /**
  * @brief Message Queue Attributes
@@ -4974,6 +5292,27 @@ struct k_msgq_attrs {
 	       Z_MSGQ_INITIALIZER(q_name, _k_fifo_buf_##q_name,	\
 				  (q_msg_size), (q_max_msgs))
 
+/**
+ * @brief Statically define a single producer single consumer message queue.
+ *
+ * This is the static counterpart of k_msgq_spsc_init().
+ *
+ * @note Requires CONFIG_MSGQ_SPSC.
+ *
+ * @param q_name Name of the message queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued.
+ * @param q_align Alignment of the message queue's ring buffer (power of 2).
+ */
+#define K_MSGQ_SPSC_DEFINE(q_name, q_msg_size, q_max_msgs, q_align)	\
+	BUILD_ASSERT(IS_ENABLED(CONFIG_MSGQ_SPSC));			\
+	static char __noinit __aligned(q_align)				\
+		_k_fifo_buf_##q_name[(q_max_msgs) * (q_msg_size)];	\
+	STRUCT_SECTION_ITERABLE(k_msgq, q_name) =			\
+	       Z_MSGQ_INITIALIZER_FLAGS(q_name, _k_fifo_buf_##q_name,	\
+					(q_msg_size), (q_max_msgs),	\
+					K_MSGQ_FLAG_SPSC)
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4991,6 +5330,28 @@ struct k_msgq_attrs {
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs);
 
+/**
+ * @brief Initialize a single producer single consumer message queue.
+ *
+ * This routine initializes a message queue like k_msgq_init(), but with
+ * the promise that at any time at most one context puts messages and at
+ * most one context gets them.  Messages are then copied in and out without
+ * taking the queue lock, which is only needed to block a thread or to wake
+ * a blocked one.
+ *
+ * The consumer side owns k_msgq_get(), k_msgq_peek(), k_msgq_peek_at() and
+ * k_msgq_purge().  k_msgq_put_front() is not supported.
+ *
+ * @note Requires CONFIG_MSGQ_SPSC.
+ *
+ * @param msgq Address of the message queue.
+ * @param buffer Pointer to ring buffer that holds queued messages.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued.
+ */
+void k_msgq_spsc_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
+		      uint32_t max_msgs);
+
 /**
  * @brief Initialize a message queue.
  *
@@ -5070,6 +5431,7 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  *
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -ENOTSUP The queue is a single producer single consumer queue.
  */
 __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data);
 
@@ -5166,6 +5528,12 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		return msgq->max_msgs - z_msgq_spsc_used(msgq);
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	return msgq->max_msgs - msgq->used_msgs;
 }
 
@@ -5182,6 +5550,12 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		return z_msgq_spsc_used(msgq);
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	return msgq->used_msgs;
 }
 
@@ -5363,6 +5737,8 @@ __syscall void k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t buffer_s
 enum pipe_flags {
 	PIPE_FLAG_OPEN = BIT(0),
 	PIPE_FLAG_RESET = BIT(1),
+	PIPE_FLAG_WRITE_CLAIM = BIT(2),
+	PIPE_FLAG_READ_CLAIM = BIT(3),
 };
 
 struct k_pipe {
@@ -5453,6 +5829,96 @@ __syscall int k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len,
 __syscall int k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len,
 			  k_timeout_t timeout);
 
+/**
+ * @brief Claim space in a pipe to write data in place
+ *
+ * This routine reserves up to @a len contiguous bytes of the pipe's ring
+ * buffer, so that the caller can produce data directly in it instead of
+ * having it copied by k_pipe_write(). The data becomes visible to readers
+ * once k_pipe_write_finish() is called. If the pipe is full, the routine will
+ * block until space is available or the timeout expires.
+ *
+ * Less than @a len bytes may be claimed, e.g. when the free space wraps
+ * around the end of the ring buffer. Only one write claim may be outstanding
+ * on a pipe at a time, and k_pipe_write() fails with -EBUSY until it is
+ * finished.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed space.
+ * @param len Requested number of bytes.
+ * @param timeout Waiting period to wait for space to be available.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EAGAIN if no space became available before the timeout expired
+ * @retval -EBUSY if a write claim is already outstanding
+ * @retval -ECANCELED if the claim was interrupted by k_pipe_reset(..)
+ * @retval -EINVAL if @a len is zero or the pipe has no ring buffer
+ * @retval -EPIPE if the pipe was closed
+ */
+__syscall int k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+				 k_timeout_t timeout);
+
+/**
+ * @brief Finish writing data in place
+ *
+ * This routine makes the first @a len bytes of the space claimed with
+ * k_pipe_write_claim() available to readers, waking them up, and releases
+ * the rest of the claim. A @a len of zero cancels the claim.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes written.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @a len exceeds the claimed size, in which case the claim
+ * is kept, or if there is no outstanding claim, e.g. after k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed, which discards the claim
+ */
+__syscall int k_pipe_write_finish(struct k_pipe *pipe, size_t len);
+
+/**
+ * @brief Claim data in a pipe to read it in place
+ *
+ * This routine gives access to up to @a len contiguous bytes of data in the
+ * pipe's ring buffer, so that the caller can consume them directly instead of
+ * having them copied by k_pipe_read(). The space is returned to writers once
+ * k_pipe_read_finish() is called. If the pipe is empty, the routine will block
+ * until data is available or the timeout expires.
+ *
+ * Less than @a len bytes may be claimed, e.g. when the data wraps around the
+ * end of the ring buffer. Only one read claim may be outstanding on a pipe at
+ * a time, and k_pipe_read() fails with -EBUSY until it is finished.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed data.
+ * @param len Requested number of bytes.
+ * @param timeout Waiting period to wait for data to be available.
+ *
+ * @retval number of bytes claimed on success
+ * @retval -EAGAIN if no data became available before the timeout expired
+ * @retval -EBUSY if a read claim is already outstanding
+ * @retval -ECANCELED if the claim was interrupted by k_pipe_reset(..)
+ * @retval -EINVAL if @a len is zero or the pipe has no ring buffer
+ * @retval -EPIPE if the pipe was closed and holds no more data
+ */
+__syscall int k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+				k_timeout_t timeout);
+
+/**
+ * @brief Finish reading data in place
+ *
+ * This routine frees the first @a len bytes of the data claimed with
+ * k_pipe_read_claim(), waking up writers waiting for space. The rest of the
+ * claimed data is left in the pipe to be read again.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes consumed.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @a len exceeds the claimed size, in which case the claim
+ * is kept, or if there is no outstanding claim, e.g. after k_pipe_reset(..)
+ */
+__syscall int k_pipe_read_finish(struct k_pipe *pipe, size_t len);
+
 /**
  * @brief Reset a pipe
  * This routine resets the pipe, discarding any unread data and unblocking any threads waiting to
@@ -5485,13 +5951,43 @@ struct k_mem_slab_info {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	/* Only filled in when reading the object core raw statistics */
+	uint32_t num_cached;
+	uint32_t cache_hits;
+	uint32_t cache_misses;
+#endif
 };
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Magazines of different CPUs must not share a data cache line */
+#if defined(CONFIG_SMP) && defined(CONFIG_DCACHE_LINE_SIZE) && (CONFIG_DCACHE_LINE_SIZE > 0)
+#define Z_MEM_SLAB_MAGAZINE_ALIGN CONFIG_DCACHE_LINE_SIZE
+#elif defined(CONFIG_SMP)
+#define Z_MEM_SLAB_MAGAZINE_ALIGN 64
+#else
+#define Z_MEM_SLAB_MAGAZINE_ALIGN sizeof(void *)
+#endif
+
+/* Set in a magazine count while another CPU empties the magazine */
+#define Z_MEM_SLAB_MAGAZINE_RECLAIM BIT(30)
+
+struct k_mem_slab_magazine {
+	atomic_t count;
+	uint32_t hits;
+	uint32_t misses;
+	char *rounds[CONFIG_MEM_SLAB_MAGAZINE_SIZE];
+} __aligned(Z_MEM_SLAB_MAGAZINE_ALIGN);
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
+	/* With CONFIG_MEM_SLAB_MAGAZINE, num_used counts every block that is
+	 * not on free_list, including free blocks cached in the magazines.
+	 */
 	struct k_mem_slab_info info;
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
@@ -5499,6 +5995,11 @@ struct k_mem_slab {
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 	struct k_obj_core  obj_core;
 #endif
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	struct k_mem_slab_magazine magazines[CONFIG_MP_MAX_NUM_CPUS];
+	bool magazine_bypass;
+#endif
 };
 
 #define Z_MEM_SLAB_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
@@ -5511,6 +6012,23 @@ struct k_mem_slab {
 	.info = {_slab_num_blocks, _slab_block_size, 0}               \
 	}
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Number of free blocks cached in the per-CPU magazines. This is read
+ * without any lock, so it is only exact while the slab is not in use.
+ */
+static inline uint32_t z_mem_slab_num_cached(const struct k_mem_slab *slab)
+{
+	uint32_t num_cached = 0U;
+
+	for (unsigned int i = 0U; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		num_cached += (uint32_t)atomic_get(&slab->magazines[i].count) &
+			      ~Z_MEM_SLAB_MAGAZINE_RECLAIM;
+	}
+
+	return num_cached;
+}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 
 /**
  * INTERNAL_HIDDEN @endcond
@@ -5705,14 +6223,23 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	uint32_t num_used = slab->info.num_used;
+	uint32_t num_cached = z_mem_slab_num_cached(slab);
+
+	/* The two reads may straddle a magazine refill */
+	return (num_used > num_cached) ? (num_used - num_cached) : 0U;
+#else
 	return slab->info.num_used;
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
 }
 
 /**
  * @brief Get the number of maximum used blocks so far in a memory slab.
  *
  * This routine gets the maximum number of memory blocks that were
- * allocated in @a slab.
+ * allocated in @a slab. With CONFIG_MEM_SLAB_MAGAZINE, free blocks that
+ * were cached in the per-CPU magazines at the time count as allocated.
  *
  * @funcprops \isr_ok
  *
@@ -5744,7 +6271,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5922,7 +6449,14 @@ void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
-#define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 56 : 44)
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* The size class lists and counts, plus padding and the hit counters */
+#define Z_HEAP_CACHE_SIZE \
+	(((CONFIG_SYS_HEAP_CACHE_MAX_BYTES + 15) / 8) * 5 + 8 + 2 * sizeof(size_t))
+#else
+#define Z_HEAP_CACHE_SIZE 0
+#endif
+#define Z_HEAP_MIN_SIZE (((sizeof(void *) > 4) ? 56 : 44) + Z_HEAP_CACHE_SIZE)
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -6403,6 +6937,92 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+#if defined(CONFIG_POLL_SET) || defined(__DOXYGEN__)
+
+/**
+ * @brief Persistent set of poll events
+ *
+ * Events are registered with the polled objects once, when added to the set,
+ * and stay registered until removed. An object becoming available puts its
+ * event on the set's ready list, so waiting on the set costs time in the
+ * number of ready events rather than in the number of events in the set.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - events that are ready and not yet returned */
+	sys_dlist_t ready;
+
+	/** PRIVATE - events returned by the last wait, re-armed by the next */
+	sys_dlist_t consumed;
+
+	/** PRIVATE - threads waiting on the set */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set The poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized with k_poll_event_init() or one of
+ * the K_POLL_EVENT_*INITIALIZER() macros, and must not be part of another
+ * set or of an ongoing k_poll() call. It is owned by the set until it is
+ * removed with k_poll_set_remove(). If the polled object is already
+ * available, the event is immediately made ready.
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ *
+ * @retval 0 The event was added.
+ * @retval -EBUSY The event is already registered.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set The poll set.
+ * @param event The event to remove.
+ *
+ * @retval 0 The event was removed.
+ * @retval -EINVAL The event is not part of @a set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * Up to @a max ready events are returned in @a ready, with their state field
+ * describing what made them ready. The same rules as for k_poll() apply:
+ * the polled objects are not acquired on behalf of the caller.
+ *
+ * Events are level triggered. The events returned by one call are re-armed
+ * by the next call on the same set, at which point they are returned again
+ * if their object is still available. The state of a returned event is thus
+ * valid until the next call to k_poll_set_wait().
+ *
+ * @param set The poll set.
+ * @param ready Array receiving pointers to the ready events.
+ * @param max Number of entries in @a ready.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events returned, which is at least one.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a max is not positive.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max, k_timeout_t timeout);
+
+#endif /* CONFIG_POLL_SET */
+
 /** @} */
 
 /**
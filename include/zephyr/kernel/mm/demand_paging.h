@@ -59,6 +59,23 @@ struct k_mem_paging_stats_t {
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
 	} eviction;
+
+#if defined(CONFIG_DEMAND_PAGING_CLUSTER) || defined(__DOXYGEN__)
+	/** Clustered paging, system-wide only */
+	struct {
+		/** Number of pages read ahead of a page fault */
+		unsigned long			readahead;
+
+		/** Read-ahead pages found accessed when evicted or pinned */
+		unsigned long			readahead_hit;
+
+		/** Read-ahead pages evicted without having been accessed */
+		unsigned long			readahead_miss;
+
+		/** Number of dirty pages evicted along with a neighbor */
+		unsigned long			pageout;
+	} cluster;
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
@@ -27,6 +27,21 @@ struct k_cycle_stats {
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_THREAD_USAGE_HISTOGRAM is selected.
+	 * @{
+	 */
+	/**
+	 * Threads: cycles from being made ready to being switched in.
+	 * CPUs: threads in the run queue at each context switch.
+	 * Bucket 0 counts zero values, bucket n counts values in
+	 * [2^(n-1), 2^n) and the last bucket all larger values too.
+	 */
+	uint32_t  histogram[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS];
+	uint32_t  ready0;       /**< when the thread was made ready, 0 if not */
+	/** @} */
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
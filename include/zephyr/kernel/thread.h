@@ -42,6 +42,24 @@ struct __thread_entry {
 
 struct k_thread;
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Constant bandwidth server of a thread, times in cycles */
+struct _thread_cbs {
+	/* runtime budget per period, 0 if the thread has no server */
+	uint32_t budget;
+	uint32_t period;
+
+	/* budget left until the current deadline */
+	uint32_t remaining;
+
+	/* times the thread blocked after its deadline */
+	uint32_t deadline_misses;
+
+	/* times the thread used up its budget */
+	uint32_t budget_overruns;
+};
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
 struct _thread_base {
 
@@ -93,6 +111,10 @@ struct _thread_base {
 	int prio_deadline;
 #endif /* CONFIG_SCHED_DEADLINE */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	struct _thread_cbs cbs;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #if defined(CONFIG_SCHED_SCALABLE) || defined(CONFIG_WAITQ_SCALABLE)
 	uint32_t order_key;
 #endif
@@ -104,6 +126,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Set once cpu designates a run queue, even if the thread never ran */
+	uint8_t runq_placed;
+#endif
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -220,6 +247,26 @@ typedef struct k_thread_runtime_stats {
 	uint64_t average_cycles;      /* average # of non-idle cycles */
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	/*
+	 * For threads, a log2 histogram of the cycles elapsed between being
+	 * made ready and being switched in. For CPUs, a log2 histogram of
+	 * the number of threads in the run queue at each context switch.
+	 * See struct k_cycle_stats for the bucket boundaries.
+	 */
+	uint32_t histogram[CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS];
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/*
+	 * For threads with a bandwidth reserved by k_thread_cbs_set(), the
+	 * number of times the thread blocked after its deadline and the
+	 * number of times it used up its budget. Always zero for CPUs.
+	 */
+	uint32_t deadline_misses;
+	uint32_t budget_overruns;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	/*
 	 * This field is always zero for individual threads. It only comes
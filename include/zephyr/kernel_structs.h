@@ -140,6 +140,11 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	/* number of threads in runq */
+	uint32_t depth;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -157,7 +162,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -217,7 +222,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -236,6 +241,10 @@ struct z_kernel {
 	/* Identify CPUs to send IPIs to at the next scheduling point */
 	atomic_t pending_ipi;
 #endif
+#ifdef CONFIG_SCHED_IPI_COALESCE
+	/* CPUs sent an IPI that they have not yet processed */
+	atomic_t ipi_in_flight;
+#endif
 };
 
 typedef struct z_kernel _kernel_t;
@@ -207,7 +207,13 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	}
 #else
 	while (!atomic_cas(&l->locked, 0, 1)) {
-		arch_spin_relax();
+		/* Wait for the lock to look free before trying again, so
+		 * that waiters spin on a shared copy of the cache line
+		 * instead of bouncing it between CPUs with failed CAS.
+		 */
+		while (atomic_get(&l->locked) != 0) {
+			arch_spin_relax();
+		}
 	}
 #endif /* CONFIG_TICKET_SPINLOCKS */
 #endif /* CONFIG_SMP */
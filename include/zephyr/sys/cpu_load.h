@@ -8,6 +8,8 @@
 #define ZEPHYR_SUBSYS_CPU_LOAD_H_
 
 #include <stdint.h>
+#include <stddef.h>
+#include <zephyr/kernel.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +38,71 @@ extern "C" {
  */
 int cpu_load_get(int cpu_id);
 
+#if defined(CONFIG_CPU_LOAD_METRIC_THREADS) || defined(__DOXYGEN__)
+
+/** @brief CPU time used by a thread during a sampling window. */
+struct cpu_load_thread {
+	/** The thread, which may have exited since. */
+	k_tid_t thread;
+#if defined(CONFIG_THREAD_NAME) || defined(__DOXYGEN__)
+	/** Name of the thread when the window ended. */
+	char name[CONFIG_THREAD_MAX_NAME_LEN];
+#endif
+	/** Cycles the thread ran for during the window. */
+	uint64_t cycles;
+	/** Load of the thread, in per mille of one CPU. */
+	uint16_t load;
+};
+
+/** @brief Per-thread CPU load over a sampling window. */
+struct cpu_load_window {
+	/** Uptime at the end of the window, in milliseconds. */
+	int64_t end_ms;
+	/** Cycles elapsed on each CPU during the window. */
+	uint64_t cycles;
+	/** Hardware cycles spent taking the sample ending the window. */
+	uint32_t sample_cycles;
+	/** Part of @a sample_cycles spent with the thread list locked. */
+	uint32_t locked_cycles;
+	/** Number of valid entries in @a threads. */
+	uint16_t num_threads;
+	/** Number of threads left out because the tracking table was full. */
+	uint16_t untracked;
+	/** Threads that ran during the window, the busiest first. */
+	struct cpu_load_thread threads[CONFIG_CPU_LOAD_METRIC_THREADS_MAX];
+};
+
+/**
+ * @brief Get the per-thread CPU load of a past window.
+ *
+ * The CPU time used by each thread is sampled every
+ * @kconfig{CONFIG_CPU_LOAD_METRIC_THREADS_PERIOD} milliseconds, and the
+ * last @kconfig{CONFIG_CPU_LOAD_METRIC_THREADS_HISTORY} windows are kept.
+ *
+ * @param age Age of the window, 0 being the most recent one.
+ * @param window Where to copy the window.
+ *
+ * @retval 0 in case of success
+ * @retval -EAGAIN if no window that old was recorded yet.
+ * @retval -EINVAL if @a age exceeds the number of windows kept.
+ */
+int cpu_load_threads_get(unsigned int age, struct cpu_load_window *window);
+
+/**
+ * @brief Get the threads that used the most CPU time in a past window.
+ *
+ * @param age Age of the window, 0 being the most recent one.
+ * @param top Where to copy the threads, the busiest first.
+ * @param n Maximum number of threads to copy.
+ *
+ * @retval Number of threads copied in case of success
+ * @retval -EAGAIN if no window that old was recorded yet.
+ * @retval -EINVAL if @a age exceeds the number of windows kept.
+ */
+int cpu_load_threads_top(unsigned int age, struct cpu_load_thread *top, size_t n);
+
+#endif /* CONFIG_CPU_LOAD_METRIC_THREADS */
+
 /**
  * @}
  */
@@ -23,6 +23,7 @@
 #include <zephyr/sys/hash_map_cxx.h>
 #include <zephyr/sys/hash_map_oa_lp.h>
 #include <zephyr/sys/hash_map_sc.h>
+#include <zephyr/sys/hash_map_swiss.h>
 
 #ifdef __cplusplus
 extern "C" {
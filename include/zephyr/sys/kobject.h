@@ -78,6 +78,8 @@ enum k_objects {
 #define K_OBJ_FLAG_ALLOC	BIT(2)
 /** Driver Object */
 #define K_OBJ_FLAG_DRIVER	BIT(3)
+/** Object allocated at runtime */
+#define K_OBJ_FLAG_DYNAMIC	BIT(4)
 
 /**
  * Grant a thread access to a kernel object
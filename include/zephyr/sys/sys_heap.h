@@ -65,6 +65,8 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	uint64_t accumulated_alloc_cycles;
+	uint64_t accumulated_free_cycles;
 };
 
 /**
@@ -94,6 +96,26 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
  */
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
+/** Size-class cache statistics of a sys_heap */
+struct sys_heap_cache_stats {
+	/** Allocations served from the cache */
+	size_t hits;
+	/** Cacheable allocations that found their size class empty */
+	size_t misses;
+};
+
+/**
+ * @brief Get the size-class cache statistics of a sys_heap
+ *
+ * Only available with CONFIG_SYS_HEAP_CACHE and CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param heap Pointer to specified sys_heap
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+			     struct sys_heap_cache_stats *stats);
+
 /** @brief Initialize sys_heap
  *
  * Initializes a sys_heap struct to manage the specified memory.
@@ -268,7 +290,9 @@ static inline bool sys_heap_validate(struct sys_heap *heap)
  *                       random allocation choices will seek.  High
  *                       values will result in significant allocation
  *                       failures and a very fragmented heap.
- * @param result Struct into which to store test results.
+ * @param result Struct into which to store test results. The cycle
+ *               counts include the time spent in the callbacks, so
+ *               callbacks that only allocate and free measure the heap.
  */
 void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 		     void (*free_fn)(void *arg, void *p),
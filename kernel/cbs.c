@@ -0,0 +1,270 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * Constant bandwidth servers for deadline scheduling
+ *
+ * A thread given a budget and a period with k_thread_cbs_set() may use at
+ * most that budget of CPU time per period at its deadline. When it becomes
+ * runnable it gets a fresh budget and a deadline one period away, unless
+ * what is left of its current budget can still be used before the current
+ * deadline without exceeding its bandwidth. While it runs, a per-CPU timeout
+ * tracks the budget left; when the budget is used up the thread's deadline
+ * is postponed by one period and its budget replenished, so that it yields
+ * to the other threads of its priority having earlier deadlines.
+ *
+ * The sum of the bandwidths (budget over period) of all threads is bounded
+ * by CONFIG_SCHED_DEADLINE_CBS_MAX_UTILIZATION on each CPU.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/util.h>
+#include <ksched.h>
+#include <ipi.h>
+
+/* Bandwidths are kept in millionths of a CPU */
+#define CBS_UNIT 1000000ULL
+
+static uint64_t cbs_utilization;
+static struct _timeout cbs_timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static bool cbs_expired[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t cbs_start[CONFIG_MP_MAX_NUM_CPUS];
+
+static inline bool thread_has_cbs(struct k_thread *thread)
+{
+	return thread->base.cbs.budget != 0U;
+}
+
+static inline uint64_t cbs_bandwidth(uint32_t budget, uint32_t period)
+{
+	return ((uint64_t)budget * CBS_UNIT) / period;
+}
+
+static inline uint64_t cbs_max_utilization(void)
+{
+	return (CBS_UNIT * CONFIG_SCHED_DEADLINE_CBS_MAX_UTILIZATION *
+		arch_num_cpus()) / 100U;
+}
+
+static void cbs_timeout(struct _timeout *timeout)
+{
+	int cpu = ARRAY_INDEX(cbs_timeouts, timeout);
+
+	cbs_expired[cpu] = true;
+
+	/* We need an IPI if we just handled a budget expiration
+	 * for a different CPU.
+	 */
+	if (cpu != _current_cpu->id) {
+		flag_ipi(IPI_CPU_MASK(cpu));
+	}
+}
+
+/* Deduct the CPU time used since the thread was switched in or charged */
+static void cbs_charge(struct k_thread *thread, int cpu, uint32_t now)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+	uint32_t used = now - cbs_start[cpu];
+
+	cbs->remaining -= MIN(used, cbs->remaining);
+	cbs_start[cpu] = now;
+}
+
+static void cbs_arm(struct k_thread *thread, int cpu)
+{
+	z_abort_timeout(&cbs_timeouts[cpu]);
+	cbs_expired[cpu] = false;
+	if (thread_has_cbs(thread)) {
+		z_add_timeout(&cbs_timeouts[cpu], cbs_timeout,
+			      K_CYC(thread->base.cbs.remaining));
+	}
+}
+
+static void cbs_switch_out(struct k_thread *old_thread, int cpu, uint32_t now)
+{
+	if (thread_has_cbs(old_thread)) {
+		cbs_charge(old_thread, cpu, now);
+
+		/* Blocking ends the work it had to do by its deadline */
+		if (z_is_thread_prevented_from_running(old_thread) &&
+		    ((int32_t)(now - (uint32_t)old_thread->base.prio_deadline) > 0)) {
+			old_thread->base.cbs.deadline_misses++;
+		}
+	}
+}
+
+static void cbs_switch_in(struct k_thread *thread, int cpu, uint32_t now)
+{
+	cbs_start[cpu] = now;
+	cbs_arm(thread, cpu);
+}
+
+void z_cbs_switch(struct k_thread *thread)
+{
+	struct k_thread *old_thread = _current;
+	int cpu = _current_cpu->id;
+	uint32_t now;
+
+	if (old_thread == thread) {
+		return;
+	}
+
+	now = k_cycle_get_32();
+	cbs_switch_out(old_thread, cpu, now);
+	cbs_switch_in(thread, cpu, now);
+}
+
+#ifndef CONFIG_USE_SWITCH
+/*
+ * arch_swap() picks the next thread itself, so the old thread is charged
+ * when it is switched out and the budget of the new one armed when it is
+ * switched in.
+ */
+void z_cbs_switched_out(void)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		cbs_switch_out(_current, _current_cpu->id, k_cycle_get_32());
+	}
+}
+
+void z_cbs_switched_in(void)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		cbs_switch_in(_current, _current_cpu->id, k_cycle_get_32());
+	}
+}
+#endif /* !CONFIG_USE_SWITCH */
+
+void z_cbs_ready(struct k_thread *thread)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+	uint32_t now;
+	int32_t left;
+
+	if (!thread_has_cbs(thread)) {
+		return;
+	}
+
+	now = k_cycle_get_32();
+	left = (int32_t)((uint32_t)thread->base.prio_deadline - now);
+
+	/*
+	 * Keep the current deadline only if the budget left would not let
+	 * the thread exceed its bandwidth before that deadline, i.e. if
+	 * remaining / left <= budget / period.
+	 */
+	if ((left <= 0) ||
+	    ((uint64_t)cbs->remaining * cbs->period >
+	     (uint64_t)left * cbs->budget)) {
+		cbs->remaining = cbs->budget;
+		thread->base.prio_deadline = (int)(now + cbs->period);
+	}
+}
+
+void z_cbs_thread_exit(struct k_thread *thread)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+
+	if (thread_has_cbs(thread)) {
+		cbs_utilization -= cbs_bandwidth(cbs->budget, cbs->period);
+		cbs->budget = 0U;
+	}
+}
+
+/* Called out of each timer interrupt */
+void z_cbs_budget_check(void)
+{
+	K_SPINLOCK(&_sched_spinlock) {
+		int cpu = _current_cpu->id;
+		struct k_thread *curr = _current;
+		struct _thread_cbs *cbs = &curr->base.cbs;
+
+		if (!cbs_expired[cpu] || !thread_has_cbs(curr)) {
+			K_SPINLOCK_BREAK;
+		}
+
+		cbs_charge(curr, cpu, k_cycle_get_32());
+
+		/* The timeout may expire up to a tick early */
+		if (cbs->remaining == 0U) {
+			cbs->budget_overruns++;
+			cbs->remaining = cbs->budget;
+			z_sched_deadline_update(curr,
+				(int)((uint32_t)curr->base.prio_deadline + cbs->period));
+		}
+
+		cbs_arm(curr, cpu);
+	}
+}
+
+int z_impl_k_thread_cbs_set(k_tid_t thread, uint32_t budget_us,
+			    uint32_t period_us)
+{
+	uint32_t budget = 0U;
+	uint32_t period = 0U;
+	uint64_t bandwidth = 0U;
+	int ret = 0;
+
+	if (budget_us != 0U) {
+		if ((period_us == 0U) || (budget_us > period_us)) {
+			return -EINVAL;
+		}
+
+		budget = k_us_to_cyc_ceil32(budget_us);
+		period = k_us_to_cyc_ceil32(period_us);
+
+		/* Deadlines of runnable threads must stay within 2^31 cycles */
+		if (period > (uint32_t)INT32_MAX) {
+			return -EINVAL;
+		}
+
+		bandwidth = cbs_bandwidth(budget, period);
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		struct _thread_cbs *cbs = &thread->base.cbs;
+		uint64_t utilization = cbs_utilization;
+
+		if (thread_has_cbs(thread)) {
+			utilization -= cbs_bandwidth(cbs->budget, cbs->period);
+		}
+
+		if ((utilization + bandwidth) > cbs_max_utilization()) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		cbs_utilization = utilization + bandwidth;
+		cbs->budget = budget;
+		cbs->period = period;
+		cbs->remaining = budget;
+
+		if (budget != 0U) {
+			z_sched_deadline_update(thread,
+				(int)(k_cycle_get_32() + period));
+		}
+
+		if (thread == _current) {
+			cbs_start[_current_cpu->id] = k_cycle_get_32();
+			cbs_arm(thread, _current_cpu->id);
+		}
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_cbs_set(k_tid_t thread, uint32_t budget_us,
+					  uint32_t period_us)
+{
+	K_OOPS(K_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+
+	return z_impl_k_thread_cbs_set(thread, budget_us, period_us);
+}
+#include <zephyr/syscalls/k_thread_cbs_set_mrsh.c>
+#endif /* CONFIG_USERSPACE */
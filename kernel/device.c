@@ -93,8 +93,102 @@ static inline int z_vrfy_device_init(const struct device *dev)
 #endif
 
 
+#ifdef CONFIG_DEVICE_NAME_HASH
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_DEVICE_NAME_HASH_BUCKETS),
+	     "CONFIG_DEVICE_NAME_HASH_BUCKETS must be a power of two");
+
+/* Heads of the bucket chains, linked through device_state.name_next */
+static device_handle_t name_buckets[CONFIG_DEVICE_NAME_HASH_BUCKETS];
+static bool name_hash_ready;
+
+static device_handle_t *name_bucket(const char *name)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	for (const char *c = name; *c != '\0'; c++) {
+		hash = (hash ^ (uint8_t)*c) * 16777619U;
+	}
+
+	return &name_buckets[hash & (CONFIG_DEVICE_NAME_HASH_BUCKETS - 1U)];
+}
+
+/*
+ * Static devices are all known once the kernel starts, so the table is
+ * built once, from the order of the device section. Devices are never
+ * removed from it: deinitialized and deferred ones are found like others
+ * and then rejected as not ready.
+ */
+void z_device_name_hash_init(void)
+{
+	/* Insert in reverse, so that the first of devices sharing a name
+	 * is found first, as with a linear search.
+	 */
+	STRUCT_SECTION_START_EXTERN(device);
+	size_t numdev;
+
+	STRUCT_SECTION_COUNT(device, &numdev);
+
+	for (size_t i = numdev; i > 0; i--) {
+		const struct device *dev = &STRUCT_SECTION_START(device)[i - 1];
+		device_handle_t *head;
+
+		if (dev->name == NULL) {
+			continue;
+		}
+
+		head = name_bucket(dev->name);
+		dev->state->name_next = *head;
+		*head = device_handle_get(dev);
+	}
+
+	name_hash_ready = true;
+}
+
+static const struct device *device_name_hash_find(const char *name)
+{
+	device_handle_t handle = *name_bucket(name);
+
+	while (handle != DEVICE_HANDLE_NULL) {
+		const struct device *dev = device_from_handle(handle);
+
+		if ((dev->name == name) || (strcmp(name, dev->name) == 0)) {
+			return dev;
+		}
+
+		handle = dev->state->name_next;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
+static const struct device *device_name_find(const char *name)
+{
+#ifdef CONFIG_DEVICE_NAME_HASH
+	if (name_hash_ready) {
+		const struct device *dev = device_name_hash_find(name);
+
+		/* Mutable devices may have been renamed since */
+		if ((dev != NULL) || !IS_ENABLED(CONFIG_DEVICE_MUTABLE)) {
+			return dev;
+		}
+	}
+#endif /* CONFIG_DEVICE_NAME_HASH */
+
+	STRUCT_SECTION_FOREACH(device, dev) {
+		if ((dev->name == name) || (strcmp(name, dev->name) == 0)) {
+			return dev;
+		}
+	}
+
+	return NULL;
+}
+
 const struct device *z_impl_device_get_binding(const char *name)
 {
+	const struct device *dev;
+
 	/* A null string identifies no device.  So does an empty
 	 * string.
 	 */
@@ -103,13 +197,12 @@ const struct device *z_impl_device_get_binding(const char *name)
 	}
 
 	/* Return NULL if the device matching 'name' is not ready. */
-	STRUCT_SECTION_FOREACH(device, dev) {
-		if ((dev->name == name) || (strcmp(name, dev->name) == 0)) {
-			return z_impl_device_is_ready(dev) ? dev : NULL;
-		}
+	dev = device_name_find(name);
+	if ((dev != NULL) && !z_impl_device_is_ready(dev)) {
+		dev = NULL;
 	}
 
-	return NULL;
+	return dev;
 }
 
 #ifdef CONFIG_USERSPACE
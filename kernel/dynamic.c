@@ -6,8 +6,10 @@
 
 #include "kernel_internal.h"
 
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <ksched.h>
+#include <kswap.h>
 #include <zephyr/kernel/thread_stack.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/bitarray.h>
@@ -173,3 +175,204 @@ static inline int z_vrfy_k_thread_stack_free(k_thread_stack_t *stack)
 }
 #include <zephyr/syscalls/k_thread_stack_free_mrsh.c>
 #endif /* CONFIG_USERSPACE */
+
+#ifdef CONFIG_DYNAMIC_THREAD_ALLOC
+/* Stack size classes are powers of two from 512 bytes to 64 KiB */
+#define DYN_THREAD_CLASS_MIN_SHIFT 9
+#define DYN_THREAD_CLASSES         8
+#define DYN_THREAD_CLASS_SIZE(c)   (BIT(DYN_THREAD_CLASS_MIN_SHIFT) << (c))
+
+struct dyn_thread {
+	struct k_thread thread;
+	k_thread_stack_t *stack;
+	size_t stack_size;
+	/* In a cache */
+	sys_snode_t node;
+	/* Stack filled again for CONFIG_INIT_STACKS when released */
+	bool prefilled;
+};
+
+static sys_slist_t dyn_thread_cache[DYN_THREAD_CLASSES];
+static uint8_t dyn_thread_cache_len[DYN_THREAD_CLASSES];
+static struct k_spinlock dyn_thread_lock;
+
+static int dyn_thread_class(size_t size)
+{
+	for (int c = 0; c < DYN_THREAD_CLASSES; c++) {
+		if (size <= DYN_THREAD_CLASS_SIZE(c)) {
+			return c;
+		}
+	}
+
+	return -1;
+}
+
+static struct dyn_thread *dyn_thread_alloc(size_t stack_size)
+{
+	struct dyn_thread *dyn = z_thread_malloc(sizeof(*dyn));
+
+	if (dyn == NULL) {
+		return NULL;
+	}
+
+	dyn->stack = z_thread_aligned_alloc(Z_KERNEL_STACK_OBJ_ALIGN,
+					    K_KERNEL_STACK_LEN(stack_size));
+	if (dyn->stack == NULL) {
+		k_free(dyn);
+		return NULL;
+	}
+
+	dyn->stack_size = stack_size;
+	dyn->prefilled = false;
+
+	return dyn;
+}
+
+static void dyn_thread_free(struct dyn_thread *dyn)
+{
+	k_free(dyn->stack);
+	k_free(dyn);
+}
+
+#ifdef CONFIG_INIT_STACKS
+/* Fill again the part of the stack the thread used */
+static void dyn_thread_stack_refill(struct dyn_thread *dyn)
+{
+	uint8_t *start = (uint8_t *)dyn->thread.stack_info.start;
+	size_t size = dyn->thread.stack_info.size;
+	size_t unused;
+
+	if (IS_ENABLED(CONFIG_THREAD_STACK_MEM_MAPPED) ||
+	    (z_stack_space_get(start, size, &unused) != 0)) {
+		return;
+	}
+
+	/* The sentinel is written again when the stack is set up */
+	if (IS_ENABLED(CONFIG_STACK_SENTINEL)) {
+		unused += 4;
+	}
+
+	memset(start + unused, 0xaa, size - unused);
+	dyn->prefilled = true;
+}
+#endif /* CONFIG_INIT_STACKS */
+
+k_tid_t k_thread_dynamic_create(size_t stack_size, k_thread_entry_t entry,
+				void *p1, void *p2, void *p3, int prio,
+				uint32_t options, k_timeout_t delay)
+{
+	struct dyn_thread *dyn = NULL;
+	int c = dyn_thread_class(stack_size);
+
+	/* Cached stacks are not kernel objects, and keep the data of the
+	 * threads that used them
+	 */
+	if ((options & K_USER) != 0U) {
+		return NULL;
+	}
+
+	if (c >= 0) {
+		stack_size = DYN_THREAD_CLASS_SIZE(c);
+
+		K_SPINLOCK(&dyn_thread_lock) {
+			sys_snode_t *node = sys_slist_get(&dyn_thread_cache[c]);
+
+			if (node != NULL) {
+				dyn = CONTAINER_OF(node, struct dyn_thread, node);
+				dyn_thread_cache_len[c]--;
+			}
+		}
+	}
+
+	if (dyn == NULL) {
+		dyn = dyn_thread_alloc(stack_size);
+		if (dyn == NULL) {
+			LOG_DBG("unable to allocate thread of stack size %zu", stack_size);
+			return NULL;
+		}
+	}
+
+#ifdef CONFIG_INIT_STACKS
+	if (dyn->prefilled) {
+		dyn->prefilled = false;
+		return z_thread_create_stack_filled(&dyn->thread, dyn->stack,
+						    dyn->stack_size, entry, p1, p2, p3,
+						    prio, options, delay);
+	}
+#endif /* CONFIG_INIT_STACKS */
+
+	return k_thread_create(&dyn->thread, dyn->stack, dyn->stack_size, entry,
+			       p1, p2, p3, prio, options, delay);
+}
+
+int k_thread_dynamic_release(k_tid_t thread)
+{
+	struct dyn_thread *dyn = CONTAINER_OF(thread, struct dyn_thread, thread);
+	int c = dyn_thread_class(dyn->stack_size);
+	bool cached = false;
+
+	bool dead = false;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		dead = z_is_thread_dead(thread);
+		if (dead) {
+			/* On SMP, a thread is marked dead before it is switched
+			 * out for the last time, so its stack may still be in
+			 * use on another CPU.
+			 */
+			z_sched_switch_spin(thread);
+		}
+	}
+
+	if (!dead) {
+		LOG_ERR("tid %p is in use!", thread);
+		return -EBUSY;
+	}
+
+	if ((c < 0) || (CONFIG_DYNAMIC_THREAD_CACHE_SIZE == 0)) {
+		dyn_thread_free(dyn);
+		return 0;
+	}
+
+#ifdef CONFIG_INIT_STACKS
+	dyn_thread_stack_refill(dyn);
+#endif /* CONFIG_INIT_STACKS */
+
+	K_SPINLOCK(&dyn_thread_lock) {
+		if (dyn_thread_cache_len[c] < CONFIG_DYNAMIC_THREAD_CACHE_SIZE) {
+			sys_slist_prepend(&dyn_thread_cache[c], &dyn->node);
+			dyn_thread_cache_len[c]++;
+			cached = true;
+		}
+	}
+
+	if (!cached) {
+		dyn_thread_free(dyn);
+	}
+
+	return 0;
+}
+#else
+k_tid_t k_thread_dynamic_create(size_t stack_size, k_thread_entry_t entry,
+				void *p1, void *p2, void *p3, int prio,
+				uint32_t options, k_timeout_t delay)
+{
+	ARG_UNUSED(stack_size);
+	ARG_UNUSED(entry);
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+	ARG_UNUSED(prio);
+	ARG_UNUSED(options);
+	ARG_UNUSED(delay);
+
+	return NULL;
+}
+
+int k_thread_dynamic_release(k_tid_t thread)
+{
+	ARG_UNUSED(thread);
+
+	return -ENOSYS;
+}
+#endif /* CONFIG_DYNAMIC_THREAD_ALLOC */
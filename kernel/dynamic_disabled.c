@@ -23,3 +23,26 @@ int z_impl_k_thread_stack_free(k_thread_stack_t *stack)
 
 	return -ENOSYS;
 }
+
+k_tid_t k_thread_dynamic_create(size_t stack_size, k_thread_entry_t entry,
+				void *p1, void *p2, void *p3, int prio,
+				uint32_t options, k_timeout_t delay)
+{
+	ARG_UNUSED(stack_size);
+	ARG_UNUSED(entry);
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+	ARG_UNUSED(prio);
+	ARG_UNUSED(options);
+	ARG_UNUSED(delay);
+
+	return NULL;
+}
+
+int k_thread_dynamic_release(k_tid_t thread)
+{
+	ARG_UNUSED(thread);
+
+	return -ENOSYS;
+}
@@ -15,6 +15,13 @@
  * conditions match the current set of events now belonging to the event object
  * are awakened.
  *
+ * A thread only pends when its wait conditions are not met, and every post
+ * wakes all threads whose wait conditions are met. A post can thus only wake
+ * threads waiting on at least one of the events it newly sets. The event
+ * object keeps the union of the events its threads wait on, so that posts not
+ * setting any of them (such as clearing events, or setting events that are
+ * already set or that no thread waits on) skip processing the waiting threads.
+ *
  * Threads waiting on an event object have the option of either waking once
  * any or all of the events it desires have been posted to the event object.
  *
@@ -45,6 +52,8 @@ struct event_walk_data {
 	struct k_thread  *head;
 	uint32_t events;
 	uint32_t clear_events;
+	uint32_t new_events;
+	uint32_t wait_mask;
 };
 
 #ifdef CONFIG_OBJ_CORE_EVENT
@@ -56,6 +65,7 @@ void z_impl_k_event_init(struct k_event *event)
 	__ASSERT_NO_MSG(!arch_is_in_isr());
 
 	event->events = 0;
+	event->wait_mask = 0;
 	event->lock = (struct k_spinlock) {};
 
 	SYS_PORT_TRACING_OBJ_INIT(k_event, event);
@@ -110,6 +120,12 @@ static int event_walk_op(struct k_thread *thread, void *data)
 	unsigned int wait_condition;
 	struct event_walk_data *event_data = data;
 
+	if ((thread->events & event_data->new_events) == 0) {
+		/* None of the desired events were just set: still unmet */
+		event_data->wait_mask |= thread->events;
+		return 0;
+	}
+
 	wait_condition = thread->event_options & K_EVENT_WAIT_MASK;
 
 	match = are_wait_conditions_met(thread->events, event_data->events,
@@ -139,6 +155,8 @@ static int event_walk_op(struct k_thread *thread, void *data)
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 		z_abort_timeout(&thread->base.timeout);
 #endif /* CONFIG_SYS_CLOCK_EXISTS */
+	} else {
+		event_data->wait_mask |= thread->events;
 	}
 
 	return 0;
@@ -170,11 +188,21 @@ static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
 	 * 1. Walk the waitq and create a linked list of threads to unpend.
 	 * 2. Unpend each of the threads in the linked list
 	 * 3. Ready each of the threads in the linked list
+	 *
+	 * The walk is skipped if no waiting thread desires any of the newly
+	 * set events. Threads that stopped waiting (e.g. on a timeout) may
+	 * leave stale bits in the wait mask, so the walk rebuilds it from
+	 * the threads still waiting.
 	 */
 
 	data.events = events;
 	data.clear_events = 0;
-	z_sched_waitq_walk(&event->wait_q, event_walk_op, &data);
+	data.new_events = events & ~event->events;
+	if ((data.new_events & event->wait_mask) != 0) {
+		data.wait_mask = 0;
+		z_sched_waitq_walk(&event->wait_q, event_walk_op, &data);
+		event->wait_mask = data.wait_mask;
+	}
 
 	if (data.head != NULL) {
 		thread = data.head;
@@ -307,6 +335,7 @@ static uint32_t k_event_wait_internal(struct k_event *event, uint32_t events,
 
 	thread->events = events;
 	thread->event_options = options;
+	event->wait_mask |= events;
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_event, wait, event, events,
 					   options, timeout);
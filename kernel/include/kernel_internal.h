@@ -123,6 +123,17 @@ extern uint8_t *z_priv_stack_find(k_thread_stack_t *stack);
 /* Calculate stack usage. */
 int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_ptr);
 
+#if defined(CONFIG_DYNAMIC_THREAD_ALLOC) && defined(CONFIG_INIT_STACKS)
+/* As k_thread_create(), for a recycled stack that is already filled for
+ * CONFIG_INIT_STACKS, which is then left as is.
+ */
+k_tid_t z_thread_create_stack_filled(struct k_thread *new_thread,
+				     k_thread_stack_t *stack,
+				     size_t stack_size, k_thread_entry_t entry,
+				     void *p1, void *p2, void *p3,
+				     int prio, uint32_t options, k_timeout_t delay);
+#endif /* CONFIG_DYNAMIC_THREAD_ALLOC && CONFIG_INIT_STACKS */
+
 #ifdef CONFIG_USERSPACE
 bool z_stack_is_user_capable(k_thread_stack_t *stack);
 
@@ -224,6 +235,25 @@ void z_paging_histogram_inc(struct k_mem_paging_histogram_t *hist,
 			    uint32_t cycles);
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+#if defined(CONFIG_DEMAND_PAGING_STATS) && defined(CONFIG_DEMAND_PAGING_CLUSTER)
+/**
+ * Account for a page read ahead of a page fault.
+ */
+void z_paging_stats_readahead_inc(void);
+
+/**
+ * Account for a read-ahead page being evicted or pinned.
+ *
+ * @param hit Whether the page had been accessed.
+ */
+void z_paging_stats_readahead_done(bool hit);
+
+/**
+ * Account for a dirty page evicted along with a neighbor.
+ */
+void z_paging_stats_cluster_pageout_inc(void);
+#endif /* CONFIG_DEMAND_PAGING_STATS && CONFIG_DEMAND_PAGING_CLUSTER */
+
 #ifdef CONFIG_OBJ_CORE_STATS_THREAD
 int z_thread_stats_raw(struct k_obj_core *obj_core, void *stats);
 int z_thread_stats_query(struct k_obj_core *obj_core, void *stats);
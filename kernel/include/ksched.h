@@ -76,6 +76,19 @@ struct k_thread *z_swap_next_thread(void);
 void move_thread_to_end_of_prio_q(struct k_thread *thread);
 bool thread_is_sliceable(struct k_thread *thread);
 
+#ifdef CONFIG_SCHED_DEADLINE
+void z_sched_deadline_update(struct k_thread *thread, int deadline);
+#endif /* CONFIG_SCHED_DEADLINE */
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+void z_cbs_switch(struct k_thread *thread);
+void z_cbs_ready(struct k_thread *thread);
+void z_cbs_thread_exit(struct k_thread *thread);
+void z_cbs_budget_check(void);
+void z_cbs_switched_out(void);
+void z_cbs_switched_in(void);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 static inline void z_reschedule_unlocked(void)
 {
 	(void) z_reschedule_irqlock(arch_irq_lock());
@@ -330,6 +343,20 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+/**
+ * @brief Timestamp a thread being made ready, for its scheduling latency
+ */
+void z_sched_usage_ready(struct k_thread *thread);
+
+/**
+ * @brief Number of threads in the run queue of the current CPU
+ */
+uint32_t z_sched_runq_depth(void);
+#else
+#define z_sched_usage_ready(thread) do { } while (false)
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
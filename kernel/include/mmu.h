@@ -158,6 +158,12 @@
  */
 #define K_MEM_PAGE_FRAME_BACKED		BIT(5)
 
+/**
+ * This page frame was read ahead of a page fault, and has not been
+ * checked for accesses yet
+ */
+#define K_MEM_PAGE_FRAME_READAHEAD	BIT(6)
+
 /**
  * Data structure for physical page frames
  *
@@ -220,6 +226,11 @@ static inline bool k_mem_page_frame_is_backed(struct k_mem_page_frame *pf)
 	return (pf->va_and_flags & K_MEM_PAGE_FRAME_BACKED) != 0U;
 }
 
+static inline bool k_mem_page_frame_is_readahead(struct k_mem_page_frame *pf)
+{
+	return (pf->va_and_flags & K_MEM_PAGE_FRAME_READAHEAD) != 0U;
+}
+
 static inline bool k_mem_page_frame_is_evictable(struct k_mem_page_frame *pf)
 {
 	return (!k_mem_page_frame_is_free(pf) &&
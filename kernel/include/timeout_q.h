@@ -36,6 +36,12 @@ static inline void z_init_timeout(struct _timeout *to)
  */
 k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout);
 
+/* As z_add_timeout(), but the expiry may be deferred by up to @a slack
+ * ticks to coalesce it with other timeouts (only with CONFIG_TIMEOUT_SLACK).
+ */
+k_ticks_t z_add_timeout_slack(struct _timeout *to, _timeout_func_t fn,
+			      k_timeout_t timeout, uint32_t slack);
+
 int z_abort_timeout(struct _timeout *to);
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+#define ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+
+/**
+ * @file
+ * @brief Hierarchical timing wheel backend for the kernel timeout queue
+ *
+ * Each level of the wheel has 2^CONFIG_TIMEOUT_WHEEL_SLOT_BITS slots. A
+ * timeout lives on the lowest level whose span still contains both its
+ * expiry tick and the current wheel time; timeouts beyond the span of the
+ * top level are kept on a sorted overflow list. Slots are cascaded to the
+ * lower levels as the wheel time advances into them.
+ *
+ * None of these functions take locks: callers must hold the timeout lock.
+ * Timeouts expiring on the same tick are returned in insertion order.
+ */
+
+#include <zephyr/kernel.h>
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Insert @a to to expire at absolute tick @a expiry (> current wheel time) */
+void z_timeout_wheel_insert(struct _timeout *to, uint64_t expiry);
+
+/* Remove a linked timeout from the wheel */
+void z_timeout_wheel_remove(struct _timeout *to);
+
+/* Absolute expiry tick of a linked timeout */
+uint64_t z_timeout_wheel_expiry(const struct _timeout *to);
+
+/* Earliest expiry tick of all pending timeouts, false if there are none */
+bool z_timeout_wheel_next(uint64_t *expiry);
+
+/* Advance the wheel to @a expiry (the value returned by
+ * z_timeout_wheel_next()) and unlink the first timeout expiring on it.
+ */
+struct _timeout *z_timeout_wheel_pop(uint64_t expiry);
+
+/* Advance the wheel time to @a now, which must not be past the earliest
+ * pending expiry.
+ */
+void z_timeout_wheel_advance(uint64_t now);
+
+/* Move the wheel time to an arbitrary @a now, preserving the remaining
+ * ticks of every pending timeout.
+ */
+void z_timeout_wheel_rebase(uint64_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_ */
@@ -38,6 +38,12 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 	return (struct k_thread *)rb_get_min(&w->waitq.tree);
 }
 
+/* Cheap enough to poll without the lock protecting the queue, as a hint */
+static inline bool z_waitq_is_empty(_wait_q_t *w)
+{
+	return w->waitq.tree.root == NULL;
+}
+
 #else /* !CONFIG_WAITQ_SCALABLE: */
 
 #define _WAIT_Q_FOR_EACH(wq, thread_ptr) \
@@ -54,6 +60,11 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 	return (struct k_thread *)sys_dlist_peek_head(&w->waitq);
 }
 
+static inline bool z_waitq_is_empty(_wait_q_t *w)
+{
+	return sys_dlist_is_empty(&w->waitq);
+}
+
 #endif /* !CONFIG_WAITQ_SCALABLE */
 
 #ifdef __cplusplus
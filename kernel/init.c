@@ -192,6 +192,9 @@ bool z_sys_post_kernel;
 
 /* defined in device.c */
 extern int do_device_init(const struct device *dev);
+#ifdef CONFIG_DEVICE_NAME_HASH
+extern void z_device_name_hash_init(void);
+#endif /* CONFIG_DEVICE_NAME_HASH */
 
 /**
  * @brief Initialize state for all static devices.
@@ -204,7 +207,264 @@ static void z_device_state_init(void)
 	STRUCT_SECTION_FOREACH(device, dev) {
 		k_object_init(dev);
 	}
+
+#ifdef CONFIG_DEVICE_NAME_HASH
+	z_device_name_hash_init();
+#endif /* CONFIG_DEVICE_NAME_HASH */
+}
+
+#ifdef CONFIG_INIT_TIMINGS
+static struct init_timing init_timings[CONFIG_INIT_TIMINGS_MAX];
+static atomic_t init_timings_count;
+
+const struct init_timing *sys_init_timings_get(size_t *count)
+{
+	*count = MIN((size_t)atomic_get(&init_timings_count),
+		     ARRAY_SIZE(init_timings));
+
+	return init_timings;
+}
+
+static void init_timing_record(const struct init_entry *entry,
+			       enum init_level level, int result,
+			       uint32_t cycles)
+{
+	atomic_val_t idx = atomic_inc(&init_timings_count);
+
+	if ((size_t)idx < ARRAY_SIZE(init_timings)) {
+		init_timings[idx].entry = entry;
+		init_timings[idx].level = level;
+		init_timings[idx].result = result;
+		init_timings[idx].cycles = cycles;
+	}
+}
+
+static void init_timings_log(void)
+{
+	size_t count;
+	const struct init_timing *timings = sys_init_timings_get(&count);
+
+	for (size_t i = 0; i < count; i++) {
+		const struct init_entry *entry = timings[i].entry;
+		uint32_t us = k_cyc_to_us_ceil32(timings[i].cycles);
+
+		if (entry->dev != NULL) {
+			LOG_INF("init %s: %u us, result %d", entry->dev->name,
+				us, timings[i].result);
+		} else {
+			LOG_INF("init %p: %u us, result %d", (void *)entry->init_fn,
+				us, timings[i].result);
+		}
+	}
+
+	if ((size_t)atomic_get(&init_timings_count) > count) {
+		LOG_WRN("%u init functions not timed",
+			(unsigned int)(atomic_get(&init_timings_count) - count));
+	}
 }
+#endif /* CONFIG_INIT_TIMINGS */
+
+static void init_entry_run(const struct init_entry *entry,
+			   enum init_level level)
+{
+	const struct device *dev = entry->dev;
+	int result = 0;
+
+#ifdef CONFIG_INIT_TIMINGS
+	/* The system clock may not be running before */
+	uint32_t start = (level >= INIT_LEVEL_POST_KERNEL) ? k_cycle_get_32() : 0U;
+#endif /* CONFIG_INIT_TIMINGS */
+
+	sys_trace_sys_init_enter(entry, level);
+	if (dev != NULL) {
+		if ((dev->flags & DEVICE_FLAG_INIT_DEFERRED) == 0U) {
+			result = do_device_init(dev);
+		}
+	} else {
+		result = entry->init_fn();
+	}
+	sys_trace_sys_init_exit(entry, level, result);
+
+#ifdef CONFIG_INIT_TIMINGS
+	if (level >= INIT_LEVEL_POST_KERNEL) {
+		init_timing_record(entry, level, result, k_cycle_get_32() - start);
+	}
+#endif /* CONFIG_INIT_TIMINGS */
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+/*
+ * Runs of consecutive device init entries of the same priority are handed
+ * out in order to the main thread and a pool of worker threads. An entry waits for those of its
+ * device's dependencies that are part of the same run. The linker orders
+ * dependencies first, so the entries waited on have always been handed out
+ * already and run to completion without waiting on later ones.
+ */
+static K_KERNEL_STACK_ARRAY_DEFINE(init_worker_stacks,
+				  CONFIG_DEVICE_INIT_PARALLEL_THREADS,
+				  CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_workers[CONFIG_DEVICE_INIT_PARALLEL_THREADS];
+static bool init_workers_started;
+
+static K_MUTEX_DEFINE(init_mutex);
+static K_CONDVAR_DEFINE(init_condvar);
+
+/* Protected by init_mutex */
+static struct {
+	const struct init_entry *start;
+	const struct init_entry *next;
+	const struct init_entry *end;
+	enum init_level level;
+	/* Entries handed out and not done */
+	unsigned int running;
+	bool exit;
+} init_batch;
+
+static bool init_batch_has(const struct device *dev)
+{
+	if ((dev->flags & DEVICE_FLAG_INIT_DEFERRED) != 0U) {
+		return false;
+	}
+
+	for (const struct init_entry *entry = init_batch.start;
+	     entry < init_batch.end; entry++) {
+		if (entry->dev == dev) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool init_deps_done(const struct device *dev)
+{
+	size_t count = 0;
+	const device_handle_t *handles = device_required_handles_get(dev, &count);
+
+	for (size_t i = 0; i < count; i++) {
+		const struct device *dep = device_from_handle(handles[i]);
+
+		if ((dep != NULL) && !dep->state->initialized &&
+		    init_batch_has(dep)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Must be called with init_mutex held, which is released while the entry runs */
+static void init_batch_run_next(void)
+{
+	const struct init_entry *entry = init_batch.next;
+
+	init_batch.next++;
+	init_batch.running++;
+
+	while (!init_deps_done(entry->dev)) {
+		(void)k_condvar_wait(&init_condvar, &init_mutex, K_FOREVER);
+	}
+
+	k_mutex_unlock(&init_mutex);
+	init_entry_run(entry, init_batch.level);
+	(void)k_mutex_lock(&init_mutex, K_FOREVER);
+
+	init_batch.running--;
+	(void)k_condvar_broadcast(&init_condvar);
+}
+
+static void init_worker(void *unused1, void *unused2, void *unused3)
+{
+	ARG_UNUSED(unused1);
+	ARG_UNUSED(unused2);
+	ARG_UNUSED(unused3);
+
+	(void)k_mutex_lock(&init_mutex, K_FOREVER);
+	while (!init_batch.exit) {
+		if (init_batch.next < init_batch.end) {
+			init_batch_run_next();
+		} else {
+			(void)k_condvar_wait(&init_condvar, &init_mutex, K_FOREVER);
+		}
+	}
+	k_mutex_unlock(&init_mutex);
+}
+
+static void init_workers_start(void)
+{
+	for (int i = 0; i < CONFIG_DEVICE_INIT_PARALLEL_THREADS; i++) {
+		k_tid_t tid = k_thread_create(&init_workers[i], init_worker_stacks[i],
+					      K_KERNEL_STACK_SIZEOF(init_worker_stacks[i]),
+					      init_worker, NULL, NULL, NULL,
+					      CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+
+		(void)k_thread_name_set(tid, "init");
+	}
+
+	init_workers_started = true;
+}
+
+static void init_workers_stop(void)
+{
+	if (!init_workers_started) {
+		return;
+	}
+
+	(void)k_mutex_lock(&init_mutex, K_FOREVER);
+	init_batch.exit = true;
+	(void)k_condvar_broadcast(&init_condvar);
+	k_mutex_unlock(&init_mutex);
+
+	for (int i = 0; i < CONFIG_DEVICE_INIT_PARALLEL_THREADS; i++) {
+		(void)k_thread_join(&init_workers[i], K_FOREVER);
+	}
+
+	init_workers_started = false;
+}
+
+static void init_run_parallel(const struct init_entry *start,
+			      const struct init_entry *end,
+			      enum init_level level)
+{
+	if (!init_workers_started) {
+		init_workers_start();
+	}
+
+	(void)k_mutex_lock(&init_mutex, K_FOREVER);
+	init_batch.start = start;
+	init_batch.next = start;
+	init_batch.end = end;
+	init_batch.level = level;
+	(void)k_condvar_broadcast(&init_condvar);
+
+	/* The main thread takes its share of the entries */
+	while (init_batch.next < init_batch.end) {
+		init_batch_run_next();
+	}
+
+	while (init_batch.running > 0U) {
+		(void)k_condvar_wait(&init_condvar, &init_mutex, K_FOREVER);
+	}
+	k_mutex_unlock(&init_mutex);
+}
+
+/* Returns the end of the run of device entries of the same priority starting
+ * at start. Devices of a lower priority may rely on those of a higher one
+ * without a devicetree dependency, so they are never run at the same time.
+ */
+static const struct init_entry *init_device_run_end(const struct init_entry *start,
+						     const struct init_entry *level_end)
+{
+	const struct init_entry *entry = start;
+
+	while ((entry < level_end) && (entry->dev != NULL) &&
+	       (entry->prio == start->prio)) {
+		entry++;
+	}
+
+	return entry;
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
 
 /**
  * @brief Execute all the init entry initialization functions at a given level
@@ -215,6 +475,9 @@ static void z_device_state_init(void)
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_PARALLEL, runs of device init entries of the same
+ * priority of the POST_KERNEL and APPLICATION levels are executed in parallel.
+ *
  * @param level init level to run.
  */
 static void z_sys_init_run_level(enum init_level level)
@@ -231,21 +494,25 @@ static void z_sys_init_run_level(enum init_level level)
 		/* End marker */
 		__init_end,
 	};
-	const struct init_entry *entry;
-
-	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
-		int result = 0;
-
-		sys_trace_sys_init_enter(entry, level);
-		if (dev != NULL) {
-			if ((dev->flags & DEVICE_FLAG_INIT_DEFERRED) == 0U) {
-				result = do_device_init(dev);
+	const struct init_entry *entry = levels[level];
+
+	while (entry < levels[level+1]) {
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+		if ((level == INIT_LEVEL_POST_KERNEL) ||
+		    (level == INIT_LEVEL_APPLICATION)) {
+			const struct init_entry *end =
+				init_device_run_end(entry, levels[level+1]);
+
+			if ((end - entry) > 1) {
+				init_run_parallel(entry, end, level);
+				entry = end;
+				continue;
 			}
-		} else {
-			result = entry->init_fn();
 		}
-		sys_trace_sys_init_exit(entry, level, result);
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
+		init_entry_run(entry, level);
+		entry++;
 	}
 }
 
@@ -317,6 +584,14 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 	/* Final init level before app starts */
 	z_sys_init_run_level(INIT_LEVEL_APPLICATION);
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	init_workers_stop();
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
+#ifdef CONFIG_INIT_TIMINGS
+	init_timings_log();
+#endif /* CONFIG_INIT_TIMINGS */
+
 	z_init_static_threads();
 
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -33,11 +33,16 @@ atomic_val_t ipi_mask_create(struct k_thread *thread)
 	uint32_t  ipi_mask = 0;
 	uint32_t  num_cpus = (uint32_t)arch_num_cpus();
 	uint32_t  id = _current_cpu->id;
+	uint32_t  pending = (uint32_t)atomic_get(&_kernel.pending_ipi);
 	struct k_thread *cpu_thread;
 	bool   executable_on_cpu = true;
 
 	for (uint32_t i = 0; i < num_cpus; i++) {
-		if (id == i) {
+		/*
+		 * CPUs already flagged (e.g. for another thread readied in
+		 * the same batch) will reschedule at the next flush anyway.
+		 */
+		if ((id == i) || ((pending & BIT(i)) != 0)) {
 			continue;
 		}
 
@@ -67,6 +72,23 @@ atomic_val_t ipi_mask_create(struct k_thread *thread)
 	return (atomic_val_t)ipi_mask;
 }
 
+#ifdef CONFIG_SCHED_IPI_COALESCE
+/*
+ * Claim the CPUs in <cpu_bitmap> as having an IPI in flight, and return
+ * those that did not already have one. A CPU that has not yet entered
+ * z_sched_ipi() for an earlier IPI will see everything flagged so far
+ * when it does, so there is no need to interrupt it again.
+ */
+static uint32_t ipi_in_flight_claim(uint32_t cpu_bitmap)
+{
+	uint32_t others = cpu_bitmap & ~BIT(_current_cpu->id);
+	uint32_t old = (uint32_t)atomic_or(&_kernel.ipi_in_flight,
+					   (atomic_val_t)others);
+
+	return cpu_bitmap & ~old;
+}
+#endif /* CONFIG_SCHED_IPI_COALESCE */
+
 void signal_pending_ipi(void)
 {
 	/* Synchronization note: you might think we need to lock these
@@ -82,6 +104,11 @@ void signal_pending_ipi(void)
 		uint32_t  cpu_bitmap;
 
 		cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+#ifdef CONFIG_SCHED_IPI_COALESCE
+		if (cpu_bitmap != 0) {
+			cpu_bitmap = ipi_in_flight_claim(cpu_bitmap);
+		}
+#endif /* CONFIG_SCHED_IPI_COALESCE */
 		if (cpu_bitmap != 0) {
 #ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
 			arch_sched_directed_ipi(cpu_bitmap);
@@ -184,6 +211,11 @@ void z_sched_ipi(void)
 	/* NOTE: When adding code to this, make sure this is called
 	 * at appropriate location when !CONFIG_SCHED_IPI_SUPPORTED.
 	 */
+#ifdef CONFIG_SCHED_IPI_COALESCE
+	/* Must precede anything that looks at what was flagged */
+	atomic_clear_bit(&_kernel.ipi_in_flight, _current_cpu->id);
+#endif /* CONFIG_SCHED_IPI_COALESCE */
+
 #ifdef CONFIG_TRACE_SCHED_IPI
 	z_trace_sched_ipi();
 #endif /* CONFIG_TRACE_SCHED_IPI */
@@ -194,6 +226,10 @@ void z_sched_ipi(void)
 	}
 #endif /* CONFIG_TIMESLICING */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	z_cbs_budget_check();
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #ifdef CONFIG_ARCH_IPI_LAZY_COPROCESSORS_SAVE
 	arch_ipi_lazy_coprocessors_save();
 #endif
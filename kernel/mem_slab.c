@@ -18,6 +18,173 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/*
+ * Each slab keeps a magazine of free blocks per CPU in front of its free
+ * list. A magazine is only used by its own CPU with interrupts locked, and
+ * without any lock on the allocation and free paths. The only other user is
+ * a CPU reclaiming the blocks of all magazines with the slab lock held:
+ * the count is updated with compare-and-swap so that either side notices
+ * the other, and the reclaiming CPU flags it while it empties the magazine.
+ *
+ * When the free list runs out, all magazines are emptied into it before
+ * giving up or pending. From then on magazine_bypass sends frees to the
+ * free list, where they can be handed to a pending thread, until no thread
+ * is left waiting.
+ */
+
+#define MAGAZINE_SIZE	CONFIG_MEM_SLAB_MAGAZINE_SIZE
+#define MAGAZINE_BATCH	(MAGAZINE_SIZE / 2U)
+#define MAGAZINE_RECLAIM Z_MEM_SLAB_MAGAZINE_RECLAIM
+
+/* Must be called with interrupts locked */
+static inline struct k_mem_slab_magazine *magazine_get(struct k_mem_slab *slab)
+{
+	return &slab->magazines[_current_cpu->id];
+}
+
+static bool magazine_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int key = arch_irq_lock();
+	struct k_mem_slab_magazine *mag = magazine_get(slab);
+	atomic_val_t count;
+	char *p;
+
+	do {
+		count = atomic_get(&mag->count);
+		if ((count == 0) || ((count & MAGAZINE_RECLAIM) != 0)) {
+			arch_irq_unlock(key);
+			return false;
+		}
+		p = mag->rounds[count - 1];
+	} while (!atomic_cas(&mag->count, count, count - 1));
+
+	mag->hits++;
+	arch_irq_unlock(key);
+
+	*mem = p;
+
+	return true;
+}
+
+static bool magazine_free(struct k_mem_slab *slab, void *mem)
+{
+	unsigned int key = arch_irq_lock();
+	struct k_mem_slab_magazine *mag = magazine_get(slab);
+	atomic_val_t count;
+
+	do {
+		count = atomic_get(&mag->count);
+		if (slab->magazine_bypass || (count >= MAGAZINE_SIZE)) {
+			/* Also when MAGAZINE_RECLAIM is set */
+			arch_irq_unlock(key);
+			return false;
+		}
+		mag->rounds[count] = mem;
+	} while (!atomic_cas(&mag->count, count, count + 1));
+
+	/* A reclaim may have started, and even finished, between the check
+	 * of magazine_bypass above and the CAS, leaving the block here while
+	 * a thread pends on the slab. The reclaim sets magazine_bypass before
+	 * it touches any count, so it is seen now. Take the block back for the
+	 * free list, unless a reclaim in progress has flagged the count, in
+	 * which case it is moving the block there itself.
+	 */
+	if (slab->magazine_bypass &&
+	    atomic_cas(&mag->count, count + 1, count)) {
+		arch_irq_unlock(key);
+		return false;
+	}
+
+	mag->hits++;
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+/* Top up the current CPU's magazine from the free list. Must be called
+ * with the slab lock held, which also keeps the thread on its CPU and
+ * other CPUs from reclaiming the magazine.
+ */
+static void magazine_refill(struct k_mem_slab *slab)
+{
+	struct k_mem_slab_magazine *mag = magazine_get(slab);
+	atomic_val_t count = atomic_get(&mag->count);
+
+	mag->misses++;
+	while ((count < MAGAZINE_BATCH) && (slab->free_list != NULL)) {
+		mag->rounds[count++] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+		slab->info.num_used++;
+	}
+	atomic_set(&mag->count, count);
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = MAX(slab->info.num_used, slab->info.max_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+
+/* Return half of the current CPU's magazine to the free list if it is
+ * full. Must be called with the slab lock held.
+ */
+static void magazine_flush(struct k_mem_slab *slab)
+{
+	struct k_mem_slab_magazine *mag = magazine_get(slab);
+	atomic_val_t count = atomic_get(&mag->count);
+
+	mag->misses++;
+	if (count == MAGAZINE_SIZE) {
+		while (count > (MAGAZINE_SIZE - MAGAZINE_BATCH)) {
+			char *p = mag->rounds[--count];
+
+			*(char **)p = slab->free_list;
+			slab->free_list = p;
+			slab->info.num_used--;
+		}
+		atomic_set(&mag->count, count);
+	}
+}
+
+/* Move the blocks cached by all CPUs to the free list. Must be called with
+ * the slab lock held.
+ */
+static void magazine_reclaim(struct k_mem_slab *slab)
+{
+	/* Set first, so that frees racing with the loop below either see it
+	 * before parking their block, or take the block back after (see
+	 * magazine_free()).
+	 */
+	slab->magazine_bypass = true;
+
+	for (unsigned int i = 0U; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct k_mem_slab_magazine *mag = &slab->magazines[i];
+		atomic_val_t count;
+
+		/* Keep the owner off the rounds while they are taken */
+		do {
+			count = atomic_get(&mag->count);
+		} while ((count != 0) &&
+			 !atomic_cas(&mag->count, count, count | MAGAZINE_RECLAIM));
+
+		while (count > 0) {
+			char *p = mag->rounds[--count];
+
+			*(char **)p = slab->free_list;
+			slab->free_list = p;
+			slab->info.num_used--;
+		}
+
+		atomic_set(&mag->count, 0);
+	}
+}
+
+/* Must be called with the slab lock held */
+static void magazine_update_bypass(struct k_mem_slab *slab)
+{
+	slab->magazine_bypass = (z_waitq_head(&slab->wait_q) != NULL);
+}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -33,6 +200,27 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	struct k_mem_slab_info *info = stats;
+
+	info->num_cached = 0U;
+	info->cache_hits = 0U;
+	info->cache_misses = 0U;
+
+	for (unsigned int i = 0U; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct k_mem_slab_magazine *mag = &slab->magazines[i];
+
+		/* The owners update these without the slab lock */
+		info->num_cached += (uint32_t)atomic_get(&mag->count);
+		info->cache_hits += mag->hits;
+		info->cache_misses += mag->misses;
+	}
+
+	/* Report cached blocks as free */
+	info->num_used -= MIN(info->num_used, info->num_cached);
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -48,9 +236,8 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -75,6 +262,14 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	slab->info.max_used = slab->info.num_used;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	for (unsigned int i = 0U; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		/* May race with the owner counting a hit, which is lost */
+		slab->magazines[i].hits = 0U;
+		slab->magazines[i].misses = 0U;
+	}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -184,6 +379,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	(void)memset(slab->magazines, 0, sizeof(slab->magazines));
+	slab->magazine_bypass = false;
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -221,11 +421,26 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (magazine_alloc(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (slab->free_list == NULL) {
+		magazine_reclaim(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -241,6 +456,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 					  slab->info.max_used);
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+		magazine_refill(slab);
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
 		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -261,6 +480,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		return result;
 	}
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	magazine_update_bypass(slab);
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 	k_spin_unlock(&slab->lock, key);
@@ -276,6 +499,15 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	if (magazine_free(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -283,6 +515,10 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
 		if (unlikely(pending_thread != NULL)) {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+			magazine_update_bypass(slab);
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 			z_thread_return_value_set_with_data(pending_thread, 0, mem);
@@ -295,6 +531,12 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 	slab->free_list = (char *) mem;
 	slab->info.num_used--;
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	/* No thread can be waiting with a block on the free list */
+	slab->magazine_bypass = false;
+	magazine_flush(slab);
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 	k_spin_unlock(&slab->lock, key);
@@ -308,9 +550,8 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			    slab->info.block_size;
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) * slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
 				     slab->info.block_size;
@@ -191,8 +191,19 @@ void k_mem_page_frames_dump(void)
  * Note that bit #0 is the highest address so that allocation is
  * done in reverse from highest address.
  */
-SYS_BITARRAY_DEFINE_STATIC(virt_region_bitmap,
-			   CONFIG_KERNEL_VM_SIZE / CONFIG_MMU_PAGE_SIZE);
+#define VIRT_REGION_BITS	(CONFIG_KERNEL_VM_SIZE / CONFIG_MMU_PAGE_SIZE)
+
+SYS_BITARRAY_DEFINE_STATIC(virt_region_bitmap, VIRT_REGION_BITS);
+
+/* Summary of the bitmap above with one bit per block of pages, set unless
+ * every page of the block is free. Large regions are allocated from this
+ * summary instead of scanning the bitmap page by page.
+ */
+#define VIRT_REGION_BLOCK_PAGES	32U
+#define VIRT_REGION_BLOCK_SIZE	(VIRT_REGION_BLOCK_PAGES * CONFIG_MMU_PAGE_SIZE)
+#define VIRT_REGION_BLOCKS	DIV_ROUND_UP(VIRT_REGION_BITS, VIRT_REGION_BLOCK_PAGES)
+
+SYS_BITARRAY_DEFINE_STATIC(virt_region_blocks, VIRT_REGION_BLOCKS);
 
 static bool virt_region_inited;
 
@@ -211,6 +222,38 @@ static inline size_t virt_to_bitmap_offset(void *vaddr, size_t size)
 		- POINTER_TO_UINT(vaddr) - size) / CONFIG_MMU_PAGE_SIZE;
 }
 
+/* Mark the blocks holding bitmap bits offset to offset + num_bits - 1 as used */
+static void virt_region_blocks_mark(size_t offset, size_t num_bits)
+{
+	size_t first = offset / VIRT_REGION_BLOCK_PAGES;
+	size_t last = (offset + num_bits - 1) / VIRT_REGION_BLOCK_PAGES;
+
+	(void)sys_bitarray_set_region(&virt_region_blocks, last - first + 1, first);
+}
+
+/* Mark the blocks holding bitmap bits offset to offset + num_bits - 1 as
+ * free if none of their pages are allocated anymore.
+ */
+static void virt_region_blocks_update(size_t offset, size_t num_bits)
+{
+	size_t first = offset / VIRT_REGION_BLOCK_PAGES;
+	size_t last = (offset + num_bits - 1) / VIRT_REGION_BLOCK_PAGES;
+
+	for (size_t block = first; block <= last; block++) {
+		size_t start = block * VIRT_REGION_BLOCK_PAGES;
+
+		/* A partial last block is never considered free */
+		if ((start + VIRT_REGION_BLOCK_PAGES) > VIRT_REGION_BITS) {
+			continue;
+		}
+
+		if (sys_bitarray_is_region_cleared(&virt_region_bitmap,
+						   VIRT_REGION_BLOCK_PAGES, start)) {
+			(void)sys_bitarray_clear_region(&virt_region_blocks, 1, block);
+		}
+	}
+}
+
 static void virt_region_init(void)
 {
 	size_t offset, num_bits;
@@ -225,6 +268,7 @@ static void virt_region_init(void)
 		num_bits = K_MEM_VM_RESERVED / CONFIG_MMU_PAGE_SIZE;
 		(void)sys_bitarray_set_region(&virt_region_bitmap,
 					      num_bits, 0);
+		virt_region_blocks_mark(0, num_bits);
 	}
 
 	/* Mark all bits up to Z_FREE_VM_START as allocated */
@@ -234,6 +278,12 @@ static void virt_region_init(void)
 	num_bits /= CONFIG_MMU_PAGE_SIZE;
 	(void)sys_bitarray_set_region(&virt_region_bitmap,
 				      num_bits, offset);
+	virt_region_blocks_mark(offset, num_bits);
+
+	if ((VIRT_REGION_BITS % VIRT_REGION_BLOCK_PAGES) != 0U) {
+		(void)sys_bitarray_set_region(&virt_region_blocks, 1,
+					      VIRT_REGION_BLOCKS - 1);
+	}
 
 	virt_region_inited = true;
 }
@@ -264,6 +314,7 @@ static void virt_region_free(void *vaddr, size_t size)
 	offset = virt_to_bitmap_offset(vaddr, size);
 	num_bits = size / CONFIG_MMU_PAGE_SIZE;
 	(void)sys_bitarray_free(&virt_region_bitmap, num_bits, offset);
+	virt_region_blocks_update(offset, num_bits);
 #else /* !CONFIG_KERNEL_DIRECT_MAP */
 	/* With K_MEM_DIRECT_MAP, the region can be outside of the virtual
 	 * memory space, wholly within it, or overlap partially.
@@ -282,22 +333,75 @@ static void virt_region_free(void *vaddr, size_t size)
 		offset = virt_to_bitmap_offset(adjusted_start, adjusted_sz);
 		num_bits = adjusted_sz / CONFIG_MMU_PAGE_SIZE;
 		(void)sys_bitarray_free(&virt_region_bitmap, num_bits, offset);
+		virt_region_blocks_update(offset, num_bits);
 	}
 #endif /* !CONFIG_KERNEL_DIRECT_MAP */
 }
 
+/* Allocate a region spanning at least one block from the block summary.
+ * Only wholly free blocks are considered, so this may fail where
+ * virt_region_alloc() scanning the bitmap would succeed.
+ */
+static void *virt_region_alloc_blocks(size_t size, size_t align)
+{
+	uintptr_t blocks_end, blocks_start, dest_addr;
+	size_t num_blocks, block, offset, slack;
+
+	/* Blocks are aligned if the end of the address space is */
+	if ((align <= VIRT_REGION_BLOCK_SIZE) &&
+	    ((POINTER_TO_UINT(K_MEM_VIRT_RAM_END) % VIRT_REGION_BLOCK_SIZE) == 0U)) {
+		slack = 0;
+	} else {
+		slack = align - CONFIG_MMU_PAGE_SIZE;
+	}
+
+	num_blocks = DIV_ROUND_UP(size + slack, VIRT_REGION_BLOCK_SIZE);
+	if (sys_bitarray_alloc(&virt_region_blocks, num_blocks, &block) != 0) {
+		return NULL;
+	}
+
+	/* Remember that bit #0 corresponds to the highest virtual address,
+	 * so the region is placed at the top of the blocks.
+	 */
+	blocks_end = virt_from_bitmap_offset(block * VIRT_REGION_BLOCK_PAGES, 0);
+	blocks_start = blocks_end - (num_blocks * VIRT_REGION_BLOCK_SIZE);
+	dest_addr = ROUND_DOWN(blocks_end - size, align);
+
+	__ASSERT_NO_MSG(dest_addr >= blocks_start);
+	__ASSERT_NO_MSG(dest_addr >= POINTER_TO_UINT(Z_VIRT_REGION_START_ADDR));
+	ARG_UNUSED(blocks_start);
+
+	offset = virt_to_bitmap_offset(UINT_TO_POINTER(dest_addr), size);
+	(void)sys_bitarray_set_region(&virt_region_bitmap,
+				      size / CONFIG_MMU_PAGE_SIZE, offset);
+
+	/* Give back the blocks left untouched by the alignment */
+	virt_region_blocks_update(block * VIRT_REGION_BLOCK_PAGES,
+				  num_blocks * VIRT_REGION_BLOCK_PAGES);
+
+	return UINT_TO_POINTER(dest_addr);
+}
+
 static void *virt_region_alloc(size_t size, size_t align)
 {
 	uintptr_t dest_addr;
 	size_t alloc_size;
 	size_t offset;
 	size_t num_bits;
+	void *dest;
 	int ret;
 
 	if (unlikely(!virt_region_inited)) {
 		virt_region_init();
 	}
 
+	if (size >= VIRT_REGION_BLOCK_SIZE) {
+		dest = virt_region_alloc_blocks(size, align);
+		if (dest != NULL) {
+			return dest;
+		}
+	}
+
 	/* Possibly request more pages to ensure we can get an aligned virtual address */
 	num_bits = (size + align - CONFIG_MMU_PAGE_SIZE) / CONFIG_MMU_PAGE_SIZE;
 	alloc_size = num_bits * CONFIG_MMU_PAGE_SIZE;
@@ -307,6 +411,7 @@ static void *virt_region_alloc(size_t size, size_t align)
 			size);
 		return NULL;
 	}
+	virt_region_blocks_mark(offset, num_bits);
 
 	/* Remember that bit #0 in bitmap corresponds to the highest
 	 * virtual address. So here we need to go downwards (backwards?)
@@ -362,6 +467,7 @@ static void *virt_region_alloc(size_t size, size_t align)
 	/* Need to make sure this does not step into kernel memory */
 	if (dest_addr < POINTER_TO_UINT(Z_VIRT_REGION_START_ADDR)) {
 		(void)sys_bitarray_free(&virt_region_bitmap, num_bits, offset);
+		virt_region_blocks_update(offset, num_bits);
 		return NULL;
 	}
 
@@ -941,6 +1047,7 @@ void k_mem_map_phys_bare(uint8_t **virt_ptr, uintptr_t phys, size_t size, uint32
 			    &virt_region_bitmap, num_bits, offset, true)) {
 				goto fail;
 			}
+			virt_region_blocks_mark(offset, num_bits);
 		}
 	} else {
 		/* Obtain an appropriately sized chunk of virtual memory */
@@ -1068,6 +1175,7 @@ static void z_paging_ondemand_section_map(void)
 		arch_mem_map(addr, location, CONFIG_MMU_PAGE_SIZE, flags);
 		sys_bitarray_set_region(&virt_region_bitmap, 1,
 					virt_to_bitmap_offset(addr, CONFIG_MMU_PAGE_SIZE));
+		virt_region_blocks_mark(virt_to_bitmap_offset(addr, CONFIG_MMU_PAGE_SIZE), 1);
 	}
 
 	size = (uintptr_t)lnkr_ondemand_rodata_size;
@@ -1077,6 +1185,7 @@ static void z_paging_ondemand_section_map(void)
 		arch_mem_map(addr, location, CONFIG_MMU_PAGE_SIZE, flags);
 		sys_bitarray_set_region(&virt_region_bitmap, 1,
 					virt_to_bitmap_offset(addr, CONFIG_MMU_PAGE_SIZE));
+		virt_region_blocks_mark(virt_to_bitmap_offset(addr, CONFIG_MMU_PAGE_SIZE), 1);
 	}
 }
 #endif /* CONFIG_LINKER_USE_ONDEMAND_SECTION */
@@ -1299,6 +1408,19 @@ static void virt_region_foreach(void *addr, size_t size,
 	}
 }
 
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+/* Account for a read-ahead page frame being put to use or evicted */
+static void readahead_done_locked(struct k_mem_page_frame *pf, bool hit)
+{
+	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_READAHEAD);
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	z_paging_stats_readahead_done(hit);
+#else
+	ARG_UNUSED(hit);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
+
 /*
  * Perform some preparatory steps before paging out. The provided page frame
  * must be evicted to the backing store immediately after this is called
@@ -1339,6 +1461,15 @@ static int page_frame_prepare_locked(struct k_mem_page_frame *pf, bool *dirty_pt
 	 */
 	if (k_mem_page_frame_is_mapped(pf)) {
 		dirty = dirty || !k_mem_page_frame_is_backed(pf);
+
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+		if (k_mem_page_frame_is_readahead(pf)) {
+			uintptr_t flags = arch_page_info_get(k_mem_page_frame_to_virt(pf),
+							     NULL, false);
+
+			readahead_done_locked(pf, (flags & ARCH_DATA_PAGE_ACCESSED) != 0);
+		}
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 	}
 
 	if (dirty || page_fault) {
@@ -1611,6 +1742,123 @@ static inline struct k_mem_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+/*
+ * Evict the dirty pages following <evicted> in virtual memory, stopping at
+ * the first one that is not dirty, has been accessed recently or cannot be
+ * evicted. Called at the end of a page fault that evicted the dirty page
+ * <evicted>, once the scratch page is no longer in use, so that the freed
+ * page frames can serve the next page faults without further evictions.
+ */
+static void cluster_page_out_locked(uint8_t *evicted, k_spinlock_key_t *key)
+{
+	struct k_mem_page_frame *pf;
+	uintptr_t flags, phys, location;
+	uint8_t *addr = evicted;
+	bool dirty;
+
+	for (int i = 1; i < CONFIG_DEMAND_PAGING_CLUSTER_SIZE; i++) {
+		addr += CONFIG_MMU_PAGE_SIZE;
+		if (addr >= (uint8_t *)K_MEM_VIRT_RAM_END) {
+			break;
+		}
+
+		flags = arch_page_info_get(addr, &phys, false);
+		if (((flags & ARCH_DATA_PAGE_LOADED) == 0) ||
+		    ((flags & ARCH_DATA_PAGE_DIRTY) == 0) ||
+		    ((flags & ARCH_DATA_PAGE_ACCESSED) != 0)) {
+			break;
+		}
+
+		pf = k_mem_phys_to_page_frame(phys);
+		if (!k_mem_page_frame_is_evictable(pf)) {
+			break;
+		}
+
+		dirty = true;
+		if (page_frame_prepare_locked(pf, &dirty, false, &location) != 0) {
+			/* Backing store is full */
+			break;
+		}
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		k_spin_unlock(&z_mm_lock, *key);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+		do_backing_store_page_out(location);
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		*key = k_spin_lock(&z_mm_lock);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+		page_frame_free_locked(pf);
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+		z_paging_stats_cluster_pageout_inc();
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+	}
+}
+
+/*
+ * Page in the paged out pages following <addr> in virtual memory into free
+ * page frames, stopping at the first page that is not paged out to the
+ * backing store or when there are no free page frames left. Nothing is
+ * evicted to make room for read-ahead.
+ */
+static void cluster_read_ahead_locked(void *addr, k_spinlock_key_t *key)
+{
+	struct k_mem_page_frame *pf;
+	uintptr_t location, phys;
+	uint8_t *next = (uint8_t *)ROUND_DOWN(addr, CONFIG_MMU_PAGE_SIZE);
+
+	for (int i = 1; i < CONFIG_DEMAND_PAGING_CLUSTER_SIZE; i++) {
+		next += CONFIG_MMU_PAGE_SIZE;
+		if (next >= (uint8_t *)K_MEM_VIRT_RAM_END) {
+			break;
+		}
+
+		if (arch_page_location_get(next, &location) != ARCH_PAGE_LOCATION_PAGED_OUT) {
+			break;
+		}
+
+#ifdef CONFIG_DEMAND_MAPPING
+		/* Never touched anonymous memory, nothing to read */
+		if ((location == ARCH_UNPAGED_ANON_ZERO) ||
+		    (location == ARCH_UNPAGED_ANON_UNINIT)) {
+			break;
+		}
+#endif /* CONFIG_DEMAND_MAPPING */
+
+		pf = free_page_frame_list_get();
+		if (pf == NULL) {
+			break;
+		}
+
+		phys = k_mem_page_frame_to_phys(pf);
+		arch_mem_scratch(phys);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		k_mem_page_frame_set(pf, K_MEM_PAGE_FRAME_BUSY);
+		k_spin_unlock(&z_mm_lock, *key);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+		do_backing_store_page_in(location);
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		*key = k_spin_lock(&z_mm_lock);
+		k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_BUSY);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+		frame_mapped_set(pf, next);
+		k_mem_page_frame_set(pf, K_MEM_PAGE_FRAME_READAHEAD);
+		arch_mem_page_in(next, phys);
+		k_mem_paging_backing_store_page_finalize(pf, location);
+		if (IS_ENABLED(CONFIG_EVICTION_TRACKING)) {
+			k_mem_paging_eviction_add(pf);
+		}
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+		z_paging_stats_readahead_inc();
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct k_mem_page_frame *pf;
@@ -1621,6 +1869,9 @@ static bool do_page_fault(void *addr, bool pin)
 	bool dirty = false;
 	struct k_thread *faulting_thread;
 	int ret;
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+	void *evicted = NULL;
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
 		 addr);
@@ -1697,6 +1948,11 @@ static bool do_page_fault(void *addr, bool pin)
 				}
 				k_mem_page_frame_set(pf, K_MEM_PAGE_FRAME_PINNED);
 			}
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+			if (k_mem_page_frame_is_readahead(pf)) {
+				readahead_done_locked(pf, true);
+			}
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 		}
 
 		/* This if-block is to pin the page if it is
@@ -1721,6 +1977,9 @@ static bool do_page_fault(void *addr, bool pin)
 			k_mem_page_frame_to_phys(pf));
 
 		paging_stats_eviction_inc(faulting_thread, dirty);
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+		evicted = k_mem_page_frame_to_virt(pf);
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 	}
 	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
 	__ASSERT(ret == 0, "failed to prepare page frame");
@@ -1752,6 +2011,15 @@ static bool do_page_fault(void *addr, bool pin)
 	if (IS_ENABLED(CONFIG_EVICTION_TRACKING) && (!pin)) {
 		k_mem_paging_eviction_add(pf);
 	}
+
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+	if (dirty && (evicted != NULL)) {
+		cluster_page_out_locked(evicted, &key);
+	}
+	if (!pin) {
+		cluster_read_ahead_locked(addr, &key);
+	}
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 out:
 	k_spin_unlock(&z_mm_lock, key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -24,6 +24,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <kernel_internal.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/barrier.h>
 
 #ifdef CONFIG_OBJ_CORE_MSGQ
 static struct k_obj_type obj_type_msgq;
@@ -66,6 +67,216 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	k_object_init(msgq);
 }
 
+#ifdef CONFIG_MSGQ_SPSC
+/*
+ * Single producer single consumer queues use the index scheme of
+ * <zephyr/sys/spsc_lockfree.h>: the producer owns spsc_in and the consumer
+ * owns spsc_out, so each side copies its message without the lock and then
+ * publishes its index. The indices run over [0, 2 * max_msgs) so that a full
+ * queue can be told from an empty one without requiring a power of two size.
+ *
+ * The lock is only taken to pend or to wake a pending thread. A thread about
+ * to pend counts itself in spsc_waiters under the lock before checking the
+ * indices again, while the other side checks spsc_waiters after publishing
+ * its index, so at least one of them sees the other. A pending thread always
+ * waits on the opposite side of the queue, which lets the waker move the
+ * pending thread's index on its behalf.
+ */
+
+void k_msgq_spsc_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
+		      uint32_t max_msgs)
+{
+	__ASSERT_NO_MSG(max_msgs <= (UINT32_MAX / 2U));
+
+	k_msgq_init(msgq, buffer, msg_size, max_msgs);
+	msgq->flags = K_MSGQ_FLAG_SPSC;
+	atomic_set(&msgq->spsc_in, 0);
+	atomic_set(&msgq->spsc_out, 0);
+	atomic_set(&msgq->spsc_waiters, 0);
+}
+
+static inline uint32_t spsc_index_add(struct k_msgq *msgq, uint32_t idx,
+				      uint32_t n)
+{
+	idx += n;
+
+	return (idx >= (2U * msgq->max_msgs)) ? (idx - (2U * msgq->max_msgs)) : idx;
+}
+
+static inline char *spsc_slot(struct k_msgq *msgq, uint32_t idx)
+{
+	if (idx >= msgq->max_msgs) {
+		idx -= msgq->max_msgs;
+	}
+
+	return msgq->buffer_start + (idx * msgq->msg_size);
+}
+
+/* Copy a message in and publish it. The queue must not be full. */
+static inline void spsc_write(struct k_msgq *msgq, const void *data)
+{
+	uint32_t in = (uint32_t)atomic_get(&msgq->spsc_in);
+
+	(void)memcpy(spsc_slot(msgq, in), data, msgq->msg_size);
+	(void)atomic_set(&msgq->spsc_in, spsc_index_add(msgq, in, 1U));
+}
+
+/* Copy the oldest message out and release its slot. The queue must not be
+ * empty.
+ */
+static inline void spsc_read(struct k_msgq *msgq, void *data)
+{
+	uint32_t out = (uint32_t)atomic_get(&msgq->spsc_out);
+
+	(void)memcpy(data, spsc_slot(msgq, out), msgq->msg_size);
+	(void)atomic_set(&msgq->spsc_out, spsc_index_add(msgq, out, 1U));
+}
+
+/* Hand over to a pending thread, if any, after a message was published
+ * (@a put) or a slot released.
+ */
+static void spsc_wake(struct k_msgq *msgq, bool put)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	struct k_thread *pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	bool resched = false;
+
+	if (pending_thread != NULL) {
+		if (put) {
+			/* the consumer waits for the message just published */
+			spsc_read(msgq, pending_thread->base.swap_data);
+		} else {
+			/* the producer waits for the slot just released */
+			spsc_write(msgq, pending_thread->base.swap_data);
+		}
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+	} else if (put) {
+		resched = handle_poll_events(msgq);
+	} else {
+		/* Nothing to hand over */
+	}
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+static inline bool spsc_wake_needed(struct k_msgq *msgq, bool put)
+{
+	if (atomic_get(&msgq->spsc_waiters) != 0) {
+		return true;
+	}
+
+#ifdef CONFIG_POLL
+	if (put) {
+		/* Pairs with the fence in k_poll() event registration */
+		barrier_dmem_fence_full();
+		return !sys_dlist_is_empty(&msgq->poll_events);
+	}
+#endif /* CONFIG_POLL */
+
+	return false;
+}
+
+static int spsc_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	if (z_msgq_spsc_used(msgq) < msgq->max_msgs) {
+		spsc_write(msgq, data);
+		if (spsc_wake_needed(msgq, true)) {
+			spsc_wake(msgq, true);
+		}
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -ENOMSG;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+	(void)atomic_inc(&msgq->spsc_waiters);
+
+	if (z_msgq_spsc_used(msgq) < msgq->max_msgs) {
+		/* the consumer released a slot meanwhile */
+		(void)atomic_dec(&msgq->spsc_waiters);
+		k_spin_unlock(&msgq->lock, key);
+		spsc_write(msgq, data);
+		if (spsc_wake_needed(msgq, true)) {
+			spsc_wake(msgq, true);
+		}
+		return 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+	_current->base.swap_data = (void *)data;
+	result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+	(void)atomic_dec(&msgq->spsc_waiters);
+
+	return result;
+}
+
+static int spsc_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	if (z_msgq_spsc_used(msgq) > 0U) {
+		spsc_read(msgq, data);
+		if (spsc_wake_needed(msgq, false)) {
+			spsc_wake(msgq, false);
+		}
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -ENOMSG;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+	(void)atomic_inc(&msgq->spsc_waiters);
+
+	if (z_msgq_spsc_used(msgq) > 0U) {
+		/* the producer published a message meanwhile */
+		(void)atomic_dec(&msgq->spsc_waiters);
+		k_spin_unlock(&msgq->lock, key);
+		spsc_read(msgq, data);
+		if (spsc_wake_needed(msgq, false)) {
+			spsc_wake(msgq, false);
+		}
+		return 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+	_current->base.swap_data = data;
+	result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+	(void)atomic_dec(&msgq->spsc_waiters);
+
+	return result;
+}
+
+static int spsc_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
+{
+	uint32_t out = (uint32_t)atomic_get(&msgq->spsc_out);
+
+	if (z_msgq_spsc_used(msgq) <= idx) {
+		return -ENOMSG;
+	}
+
+	(void)memcpy(data, spsc_slot(msgq, spsc_index_add(msgq, out, idx)),
+		     msgq->msg_size);
+
+	return 0;
+}
+#endif /* CONFIG_MSGQ_SPSC */
+
 int z_impl_k_msgq_alloc_init(struct k_msgq *msgq, size_t msg_size,
 			    uint32_t max_msgs)
 {
@@ -134,6 +345,23 @@ static inline int put_msg_in_queue(struct k_msgq *msgq, const void *data,
 	int result;
 	bool resched = false;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		if (put_at_back) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+			result = spsc_put(msgq, data, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		} else {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_front, msgq, timeout);
+			/* the front of the queue belongs to the consumer */
+			result = -ENOTSUP;
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_front, msgq, timeout, result);
+		}
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (put_at_back) {
@@ -258,7 +486,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_impl_k_msgq_num_used_get(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -281,6 +509,16 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	int result;
 	bool resched = false;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+		result = spsc_get(msgq, data, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -358,6 +596,15 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		result = spsc_peek_at(msgq, data, 0);
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0U) {
@@ -395,6 +642,15 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 	uint32_t byte_offset;
 	char *start_addr;
 
+#ifdef CONFIG_MSGQ_SPSC
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		result = spsc_peek_at(msgq, data, idx);
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > idx) {
@@ -455,6 +711,13 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
 
+#ifdef CONFIG_MSGQ_SPSC
+	/* Called by the consumer, so the consumer index can move */
+	if ((msgq->flags & K_MSGQ_FLAG_SPSC) != 0U) {
+		(void)atomic_set(&msgq->spsc_out, atomic_get(&msgq->spsc_in));
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
 	if (resched) {
 		z_reschedule(&msgq->lock, key);
 	} else {
@@ -102,6 +102,82 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static inline bool owner_running(struct k_thread *owner)
+{
+	/* Only a hint, the owner may be switched out right after. The
+	 * spinning thread is running too, so this is another CPU.
+	 */
+	return _kernel.cpus[owner->base.cpu].current == owner;
+}
+
+/*
+ * Spin without the mutex lock until the mutex looks free or changes owner,
+ * reading its state as hints only. Returns false when spinning should stop
+ * for good: another thread pends on the mutex, since unlocking hands the
+ * mutex over to the pending threads in priority order, the owner stops
+ * running, or the spin budget from start is used up.
+ */
+static bool mutex_spin_wait(struct k_mutex *mutex, struct k_thread *owner,
+			    uint32_t start, uint32_t limit)
+{
+	while (true) {
+		/* Read the mutex state again on every iteration */
+		compiler_barrier();
+
+		if ((mutex->lock_count == 0U) || (mutex->owner != owner)) {
+			return true;
+		}
+
+		if (!z_waitq_is_empty(&mutex->wait_q) || !owner_running(owner) ||
+		    ((k_cycle_get_32() - start) >= limit)) {
+			return false;
+		}
+
+		arch_spin_relax();
+	}
+}
+
+/*
+ * Wait for a mutex owned by a thread running on another CPU to be released,
+ * for a bounded time, rather than paying for two context switches when the
+ * critical section is short. The mutex lock is only taken again to retry
+ * the acquire. The caller pends and applies priority inheritance as usual
+ * if this fails.
+ *
+ * Called and returns with the mutex lock held, returns true if the mutex is
+ * free to take.
+ */
+static bool mutex_spin_on_owner(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	uint32_t limit = k_us_to_cyc_ceil32(CONFIG_MUTEX_ADAPTIVE_SPIN_US);
+	uint32_t start = k_cycle_get_32();
+	bool retry;
+
+	do {
+		struct k_thread *owner = mutex->owner;
+
+		k_spin_unlock(&lock, *key);
+		retry = mutex_spin_wait(mutex, owner, start, limit);
+		*key = k_spin_lock(&lock);
+
+		if (mutex->lock_count == 0U) {
+			return true;
+		}
+	} while (retry);
+
+	return false;
+}
+#else
+static inline bool mutex_spin_on_owner(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(key);
+
+	return false;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -114,7 +190,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current)) ||
+	    (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) && mutex_spin_on_owner(mutex, &key))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
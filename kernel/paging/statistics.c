@@ -134,6 +134,27 @@ void z_vrfy_k_mem_paging_thread_stats_get(struct k_thread *thread,
 
 #endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
 
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+void z_paging_stats_readahead_inc(void)
+{
+	paging_stats.cluster.readahead++;
+}
+
+void z_paging_stats_readahead_done(bool hit)
+{
+	if (hit) {
+		paging_stats.cluster.readahead_hit++;
+	} else {
+		paging_stats.cluster.readahead_miss++;
+	}
+}
+
+void z_paging_stats_cluster_pageout_inc(void)
+{
+	paging_stats.cluster.pageout++;
+}
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
+
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
 void z_paging_histogram_init(void)
 {
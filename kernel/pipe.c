@@ -24,6 +24,11 @@ static inline bool pipe_resetting(struct k_pipe *pipe)
 	return (pipe->flags & PIPE_FLAG_RESET) != 0;
 }
 
+static inline bool pipe_claimed(struct k_pipe *pipe, uint8_t claim_flag)
+{
+	return (pipe->flags & claim_flag) != 0;
+}
+
 static inline bool pipe_full(struct k_pipe *pipe)
 {
 	return ring_buf_space_get(&pipe->buf) == 0;
@@ -165,6 +170,11 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 			break;
 		}
 
+		if (unlikely(pipe_claimed(pipe, PIPE_FLAG_WRITE_CLAIM))) {
+			rc = written ? written : -EBUSY;
+			break;
+		}
+
 		if (pipe_empty(pipe)) {
 			if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
 				/*
@@ -233,6 +243,11 @@ int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout
 	}
 
 	for (;;) {
+		if (unlikely(pipe_claimed(pipe, PIPE_FLAG_READ_CLAIM))) {
+			rc = buf.used ? buf.used : -EBUSY;
+			break;
+		}
+
 		if (pipe_full(pipe)) {
 			/* One or more pending writers may exist. */
 			need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
@@ -270,11 +285,185 @@ exit:
 	return rc;
 }
 
+int z_impl_k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+			      k_timeout_t timeout)
+{
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely((len == 0) || (ring_buf_capacity_get(&pipe->buf) == 0))) {
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		if (unlikely(pipe_claimed(pipe, PIPE_FLAG_WRITE_CLAIM))) {
+			rc = -EBUSY;
+			break;
+		}
+
+		rc = ring_buf_put_claim(&pipe->buf, data, MIN(len, (size_t)INT_MAX));
+		if (likely(rc != 0)) {
+			pipe->flags |= PIPE_FLAG_WRITE_CLAIM;
+			break;
+		}
+
+		rc = wait_for(&pipe->space, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int z_impl_k_pipe_write_finish(struct k_pipe *pipe, size_t len)
+{
+	int rc = 0;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely(!pipe_claimed(pipe, PIPE_FLAG_WRITE_CLAIM))) {
+		rc = pipe_closed(pipe) ? -EPIPE : -EINVAL;
+		goto exit;
+	}
+
+	if (unlikely(ring_buf_put_finish(&pipe->buf, MIN(len, UINT32_MAX)) != 0)) {
+		/* More than was claimed, the claim is left as it is */
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	pipe->flags &= ~PIPE_FLAG_WRITE_CLAIM;
+
+	if (len != 0) {
+		/* Readers pick the data up from the ring buffer */
+		need_resched = z_sched_wake_all(&pipe->data, 0, NULL);
+#ifdef CONFIG_POLL
+		need_resched |= z_handle_obj_poll_events(&pipe->poll_events,
+							 K_POLL_STATE_PIPE_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int z_impl_k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+			     k_timeout_t timeout)
+{
+	/* An empty direct copy spec, so that writers wake us up without
+	 * handing us any data: it is taken from the ring buffer.
+	 */
+	struct pipe_buf_spec buf = { pipe->buf.buffer, 0, 0 };
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+
+	if (unlikely((len == 0) || (ring_buf_capacity_get(&pipe->buf) == 0))) {
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+		goto exit;
+	}
+
+	for (;;) {
+		if (unlikely(pipe_claimed(pipe, PIPE_FLAG_READ_CLAIM))) {
+			rc = -EBUSY;
+			break;
+		}
+
+		rc = ring_buf_get_claim(&pipe->buf, data, MIN(len, (size_t)INT_MAX));
+		if (likely(rc != 0)) {
+			pipe->flags |= PIPE_FLAG_READ_CLAIM;
+			break;
+		}
+
+		if (unlikely(pipe_closed(pipe))) {
+			rc = -EPIPE;
+			break;
+		}
+
+		_current->base.swap_data = &buf;
+
+		rc = wait_for(&pipe->data, pipe, &key, end, &need_resched);
+		if (rc != 0) {
+			break;
+		}
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int z_impl_k_pipe_read_finish(struct k_pipe *pipe, size_t len)
+{
+	int rc = 0;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+	bool was_full = pipe_full(pipe);
+
+	if (unlikely(!pipe_claimed(pipe, PIPE_FLAG_READ_CLAIM))) {
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	if (unlikely(ring_buf_get_finish(&pipe->buf, MIN(len, UINT32_MAX)) != 0)) {
+		/* More than was claimed, the claim is left as it is */
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	pipe->flags &= ~PIPE_FLAG_READ_CLAIM;
+
+	if (was_full && (len != 0)) {
+		/* One or more pending writers may exist. */
+		need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
+	}
+exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
 void z_impl_k_pipe_reset(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, reset, pipe);
 	K_SPINLOCK(&pipe->lock) {
 		ring_buf_reset(&pipe->buf);
+		pipe->flags &= ~(PIPE_FLAG_WRITE_CLAIM | PIPE_FLAG_READ_CLAIM);
 		if (likely(pipe->waiting != 0)) {
 			pipe->flags |= PIPE_FLAG_RESET;
 			z_sched_wake_all(&pipe->data, 0, NULL);
@@ -288,7 +477,12 @@ void z_impl_k_pipe_close(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, close, pipe);
 	K_SPINLOCK(&pipe->lock) {
-		pipe->flags = 0;
+		if (pipe_claimed(pipe, PIPE_FLAG_WRITE_CLAIM)) {
+			/* Drop the claimed space, nothing can be written anymore */
+			(void)ring_buf_put_finish(&pipe->buf, 0);
+		}
+		/* An outstanding read claim can still be finished */
+		pipe->flags &= PIPE_FLAG_READ_CLAIM;
 		z_sched_wake_all(&pipe->data, 0, NULL);
 		z_sched_wake_all(&pipe->space, 0, NULL);
 	}
@@ -323,6 +517,62 @@ int z_vrfy_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 }
 #include <zephyr/syscalls/k_pipe_write_mrsh.c>
 
+int z_vrfy_k_pipe_write_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+			      k_timeout_t timeout)
+{
+	uint8_t *claimed;
+	int rc;
+
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	/* The claimed area lies somewhere in the ring buffer */
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(pipe->buf.buffer, pipe->buf.size));
+
+	rc = z_impl_k_pipe_write_claim(pipe, &claimed, len, timeout);
+	if (rc > 0) {
+		*data = claimed;
+	}
+
+	return rc;
+}
+#include <zephyr/syscalls/k_pipe_write_claim_mrsh.c>
+
+int z_vrfy_k_pipe_write_finish(struct k_pipe *pipe, size_t len)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_write_finish(pipe, len);
+}
+#include <zephyr/syscalls/k_pipe_write_finish_mrsh.c>
+
+int z_vrfy_k_pipe_read_claim(struct k_pipe *pipe, uint8_t **data, size_t len,
+			     k_timeout_t timeout)
+{
+	uint8_t *claimed;
+	int rc;
+
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	/* The claimed area lies somewhere in the ring buffer */
+	K_OOPS(K_SYSCALL_MEMORY_READ(pipe->buf.buffer, pipe->buf.size));
+
+	rc = z_impl_k_pipe_read_claim(pipe, &claimed, len, timeout);
+	if (rc > 0) {
+		*data = claimed;
+	}
+
+	return rc;
+}
+#include <zephyr/syscalls/k_pipe_read_claim_mrsh.c>
+
+int z_vrfy_k_pipe_read_finish(struct k_pipe *pipe, size_t len)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_read_finish(pipe, len);
+}
+#include <zephyr/syscalls/k_pipe_read_finish_mrsh.c>
+
 void z_vrfy_k_pipe_reset(struct k_pipe *pipe)
 {
 	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
@@ -24,6 +24,7 @@
 #include <zephyr/sys/dlist.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/__assert.h>
+#include <zephyr/sys/barrier.h>
 #include <stdbool.h>
 
 /* Single subsystem lock.  Locking per-event would be better on highly
@@ -35,10 +36,13 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+#ifdef CONFIG_POLL_SET
+static void signal_set(struct k_poll_event *event, uint32_t state);
+#endif /* CONFIG_POLL_SET */
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -82,7 +86,7 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		if (event->msgq->used_msgs > 0) {
+		if (z_impl_k_msgq_num_used_get(event->msgq) > 0) {
 			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
 			return true;
 		}
@@ -108,22 +112,32 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Poll sets have no thread of their own: they queue behind polling threads */
+static inline bool poller_precedes(struct z_poller *poller,
+				   struct z_poller *pending)
+{
+	if (IS_ENABLED(CONFIG_POLL_SET) &&
+	    ((poller->mode == MODE_SET) || (pending->mode == MODE_SET))) {
+		return (poller->mode != MODE_SET) && (pending->mode == MODE_SET);
+	}
+
+	return z_sched_prio_cmp(poller_thread(poller),
+				poller_thread(pending)) > 0;
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || !poller_precedes(poller, pending->poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (poller_precedes(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -226,6 +240,36 @@ static inline void set_event_ready(struct k_poll_event *event, uint32_t state)
 	event->state |= state;
 }
 
+/* must be called with interrupts locked */
+static inline bool is_condition_met_late(struct k_poll_event *event, uint32_t *state)
+{
+#ifdef CONFIG_MSGQ_SPSC
+	/* Messages are put into a single producer single consumer queue
+	 * without its lock, so look again once the event is registered. The
+	 * fence pairs with the one the producer issues before checking for
+	 * registered events.
+	 */
+	if ((event->type == K_POLL_TYPE_MSGQ_DATA_AVAILABLE) &&
+	    ((event->msgq->flags & K_MSGQ_FLAG_SPSC) != 0U)) {
+		barrier_dmem_fence_full();
+		return is_condition_met(event, state);
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
+#ifdef CONFIG_QUEUE_LOCKLESS
+	/* Likewise for nodes put into a queue without its lock */
+	if (event->type == K_POLL_TYPE_DATA_AVAILABLE) {
+		barrier_dmem_fence_full();
+		return is_condition_met(event, state);
+	}
+#endif /* CONFIG_QUEUE_LOCKLESS */
+
+	ARG_UNUSED(event);
+	ARG_UNUSED(state);
+
+	return false;
+}
+
 static inline int register_events(struct k_poll_event *events,
 				  int num_events,
 				  struct z_poller *poller,
@@ -243,7 +287,13 @@ static inline int register_events(struct k_poll_event *events,
 			poller->is_polling = false;
 		} else if (!just_check && poller->is_polling) {
 			register_event(&events[ii], poller);
-			events_registered += 1;
+			if (is_condition_met_late(&events[ii], &state)) {
+				clear_event_registration(&events[ii]);
+				set_event_ready(&events[ii], state);
+				poller->is_polling = false;
+			} else {
+				events_registered += 1;
+			}
 		} else {
 			/* Event is not one of those identified in is_condition_met()
 			 * catching non-polling events, or is marked for just check,
@@ -436,6 +486,14 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+#ifdef CONFIG_POLL_SET
+	if ((poller != NULL) && (poller->mode == MODE_SET)) {
+		/* The event stays owned by its set */
+		signal_set(event, state);
+		return 0;
+	}
+#endif /* CONFIG_POLL_SET */
+
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -808,3 +866,164 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+#ifdef CONFIG_POLL_SET
+/* must be called with interrupts locked */
+static bool set_wake_waiter(struct k_poll_set *set)
+{
+	struct k_thread *thread = z_unpend_first_thread(&set->wait_q);
+
+	if (thread == NULL) {
+		return false;
+	}
+
+	arch_thread_return_value_set(thread, 0);
+	z_ready_thread(thread);
+
+	return true;
+}
+
+/* must be called with interrupts locked */
+static void signal_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller, struct k_poll_set,
+					      poller);
+
+	/* The object already unlinked the event from its poll_events list */
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+	(void)set_wake_waiter(set);
+}
+
+/*
+ * Put an unlinked event either on the ready list, if its object is
+ * available, or on the poll_events list of its object.
+ *
+ * must be called with interrupts locked
+ */
+static bool set_arm_event(struct k_poll_set *set, struct k_poll_event *event)
+{
+	uint32_t state;
+
+	event->poller = &set->poller;
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (!is_condition_met(event, &state)) {
+		register_event(event, &set->poller);
+		if (!is_condition_met_late(event, &state)) {
+			return false;
+		}
+		sys_dlist_remove(&event->_node);
+	}
+
+	event->state = state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	return true;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->consumed);
+	z_waitq_init(&set->wait_q);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	sys_dnode_init(&event->_node);
+	if (set_arm_event(set, event) && set_wake_waiter(set)) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	/* Linked to its object, to the ready list or to the consumed list */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	sys_dnode_t *node;
+	int num_ready = 0;
+
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+	__ASSERT(ready != NULL, "NULL ready\n");
+
+	if (max <= 0) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Level triggered: events returned last time are armed again, and
+	 * are immediately ready if their object is still available.
+	 */
+	while ((node = sys_dlist_get(&set->consumed)) != NULL) {
+		(void)set_arm_event(set, CONTAINER_OF(node, struct k_poll_event,
+						      _node));
+	}
+
+	while (sys_dlist_is_empty(&set->ready)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EAGAIN;
+		}
+
+		if (z_pend_curr(&lock, key, &set->wait_q, timeout) != 0) {
+			return -EAGAIN;
+		}
+
+		/* Another waiter may have consumed the events meanwhile */
+		timeout = sys_timepoint_timeout(end);
+		key = k_spin_lock(&lock);
+	}
+
+	while ((num_ready < max) &&
+	       ((node = sys_dlist_get(&set->ready)) != NULL)) {
+		ready[num_ready++] = CONTAINER_OF(node, struct k_poll_event,
+						  _node);
+		sys_dlist_append(&set->consumed, node);
+	}
+
+	/* Hand what is left over to the next waiter */
+	if (!sys_dlist_is_empty(&set->ready) && set_wake_waiter(set)) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return num_ready;
+}
+#endif /* CONFIG_POLL_SET */
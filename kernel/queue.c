@@ -21,6 +21,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <kernel_internal.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/barrier.h>
 
 struct alloc_node {
 	sys_sfnode_t node;
@@ -60,6 +61,11 @@ void z_impl_k_queue_init(struct k_queue *queue)
 	sys_sflist_init(&queue->data_q);
 	queue->lock = (struct k_spinlock) {};
 	z_waitq_init(&queue->wait_q);
+#ifdef CONFIG_QUEUE_LOCKLESS
+	atomic_ptr_set(&queue->prepend_list, NULL);
+	atomic_ptr_set(&queue->append_list, NULL);
+	atomic_set(&queue->waiters, 0);
+#endif /* CONFIG_QUEUE_LOCKLESS */
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&queue->poll_events);
 #endif
@@ -96,6 +102,141 @@ static inline bool handle_poll_events(struct k_queue *queue, uint32_t state)
 #endif /* CONFIG_POLL */
 }
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+/*
+ * k_queue_append() and k_queue_prepend(), and so k_fifo_put() and
+ * k_lifo_put(), push their node onto one of two lists without taking the
+ * queue lock. Producers only ever push a node with a compare-and-swap and
+ * the lists are only ever taken as a whole with an atomic exchange, so the
+ * ABA problem of lock-free list removal cannot arise. Every operation that
+ * takes the queue lock first moves these nodes into data_q, prepended nodes
+ * to its head and appended nodes to its tail, so that nodes never overtake
+ * each other: the consumer side is serialized by the lock, making this a
+ * multiple producer single consumer queue.
+ *
+ * The lock is only taken by producers to hand nodes to pending threads or
+ * to signal pollers. A thread about to pend counts itself in waiters under
+ * the lock before looking at the lists again, while a producer checks
+ * waiters after pushing its node, so at least one of them sees the other.
+ */
+
+static void lockless_push(atomic_ptr_t *list, void *node)
+{
+	atomic_ptr_val_t head;
+
+	do {
+		head = atomic_ptr_get(list);
+		*(void **)node = head;
+	} while (!atomic_ptr_cas(list, head, node));
+}
+
+/* must be called with the queue lock held */
+static void lockless_collect(struct k_queue *queue)
+{
+	void *node = atomic_ptr_clear(&queue->prepend_list);
+	void *prev = NULL;
+	void *next;
+
+	/* Most recent first, which is the order they go to the head in */
+	while (node != NULL) {
+		next = *(void **)node;
+		sys_sfnode_init(node, 0x0);
+		sys_sflist_insert(&queue->data_q, prev, node);
+		prev = node;
+		node = next;
+	}
+
+	/* Most recent first too, so reverse them before appending */
+	node = atomic_ptr_clear(&queue->append_list);
+	prev = NULL;
+	while (node != NULL) {
+		next = *(void **)node;
+		*(void **)node = prev;
+		prev = node;
+		node = next;
+	}
+
+	while (prev != NULL) {
+		next = *(void **)prev;
+		sys_sfnode_init(prev, 0x0);
+		sys_sflist_append(&queue->data_q, prev);
+		prev = next;
+	}
+}
+
+/* Collect the nodes pushed without the lock, for unlocked readers */
+static void lockless_collect_unlocked(struct k_queue *queue)
+{
+	k_spinlock_key_t key;
+
+	if ((atomic_ptr_get(&queue->prepend_list) == NULL) &&
+	    (atomic_ptr_get(&queue->append_list) == NULL)) {
+		return;
+	}
+
+	key = k_spin_lock(&queue->lock);
+	lockless_collect(queue);
+	k_spin_unlock(&queue->lock, key);
+}
+
+static inline bool lockless_wake_needed(struct k_queue *queue)
+{
+	if (atomic_get(&queue->waiters) != 0) {
+		return true;
+	}
+
+#ifdef CONFIG_POLL
+	/* Pairs with the fence in k_poll() event registration */
+	barrier_dmem_fence_full();
+	return !sys_dlist_is_empty(&queue->poll_events);
+#else
+	return false;
+#endif /* CONFIG_POLL */
+}
+
+/* Hand the nodes pushed without the lock to pending threads or pollers */
+static void lockless_wake(struct k_queue *queue)
+{
+	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	struct k_thread *pending_thread;
+	sys_sfnode_t *node;
+	bool resched = false;
+
+	lockless_collect(queue);
+
+	while (!sys_sflist_is_empty(&queue->data_q)) {
+		pending_thread = z_unpend_first_thread(&queue->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		node = sys_sflist_get_not_empty(&queue->data_q);
+		prepare_thread_to_run(pending_thread, z_queue_node_peek(node, true));
+		resched = true;
+	}
+
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		resched = handle_poll_events(queue, K_POLL_STATE_DATA_AVAILABLE) || resched;
+	}
+
+	if (resched) {
+		z_reschedule(&queue->lock, key);
+	} else {
+		k_spin_unlock(&queue->lock, key);
+	}
+}
+#else
+static inline void lockless_collect(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+
+static inline void lockless_collect_unlocked(struct k_queue *queue)
+{
+	ARG_UNUSED(queue);
+}
+#endif /* CONFIG_QUEUE_LOCKLESS */
+
 void z_impl_k_queue_cancel_wait(struct k_queue *queue)
 {
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, cancel_wait, queue);
@@ -133,12 +274,32 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 			    bool alloc, bool is_append)
 {
 	struct k_thread *first_pending_thread;
-	k_spinlock_key_t key = k_spin_lock(&queue->lock);
+	k_spinlock_key_t key;
 	int32_t result = 0;
 	bool resched = false;
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	if (!alloc && (is_append || (prev == NULL))) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, queue_insert, queue, alloc);
+
+		lockless_push(is_append ? &queue->append_list : &queue->prepend_list,
+			      data);
+		if (lockless_wake_needed(queue)) {
+			lockless_wake(queue);
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, queue_insert, queue, alloc, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_QUEUE_LOCKLESS */
+
+	key = k_spin_lock(&queue->lock);
+
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, queue_insert, queue, alloc);
 
+	lockless_collect(queue);
+
 	if (is_append) {
 		prev = sys_sflist_peek_tail(&queue->data_q);
 	}
@@ -269,6 +430,8 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	k_spinlock_key_t key = k_spin_lock(&queue->lock);
 	struct k_thread *thread = NULL;
 
+	lockless_collect(queue);
+
 	if (head != NULL) {
 		thread = z_unpend_first_thread(&queue->wait_q);
 	}
@@ -339,6 +502,8 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, get, queue, timeout);
 
+	lockless_collect(queue);
+
 	if (likely(!sys_sflist_is_empty(&queue->data_q))) {
 		sys_sfnode_t *node;
 
@@ -361,8 +526,28 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 		return NULL;
 	}
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	(void)atomic_inc(&queue->waiters);
+	lockless_collect(queue);
+
+	if (!sys_sflist_is_empty(&queue->data_q)) {
+		/* a node was pushed meanwhile */
+		(void)atomic_dec(&queue->waiters);
+		data = z_queue_node_peek(sys_sflist_get_not_empty(&queue->data_q), true);
+		k_spin_unlock(&queue->lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, data);
+
+		return data;
+	}
+#endif /* CONFIG_QUEUE_LOCKLESS */
+
 	int ret = z_pend_curr(&queue->lock, key, &queue->wait_q, timeout);
 
+#ifdef CONFIG_QUEUE_LOCKLESS
+	(void)atomic_dec(&queue->waiters);
+#endif /* CONFIG_QUEUE_LOCKLESS */
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout,
 		(ret != 0) ? NULL : _current->base.swap_data);
 
@@ -373,6 +558,8 @@ bool k_queue_remove(struct k_queue *queue, void *data)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_queue, remove, queue);
 
+	lockless_collect_unlocked(queue);
+
 	bool ret = sys_sflist_find_and_remove(&queue->data_q, (sys_sfnode_t *)data);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, remove, queue, ret);
@@ -386,6 +573,8 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 	sys_sfnode_t *test;
 
+	lockless_collect_unlocked(queue);
+
 	SYS_SFLIST_FOR_EACH_NODE(&queue->data_q, test) {
 		if (test == (sys_sfnode_t *) data) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, unique_append, queue, false);
@@ -403,6 +592,8 @@ bool k_queue_unique_append(struct k_queue *queue, void *data)
 
 void *z_impl_k_queue_peek_head(struct k_queue *queue)
 {
+	lockless_collect_unlocked(queue);
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_head(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_head, queue, ret);
@@ -412,6 +603,8 @@ void *z_impl_k_queue_peek_head(struct k_queue *queue)
 
 void *z_impl_k_queue_peek_tail(struct k_queue *queue)
 {
+	lockless_collect_unlocked(queue);
+
 	void *ret = z_queue_node_peek(sys_sflist_peek_tail(&queue->data_q), false);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_queue, peek_tail, queue, ret);
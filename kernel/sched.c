@@ -59,6 +59,14 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	/* Threads are queued on the CPU they last ran on, or on one
+	 * picked by runq_place(). The field is only rewritten when the
+	 * thread is switched in or about to be queued, i.e. while it is
+	 * not in a queue, so it also identifies the queue holding a
+	 * queued thread.
+	 */
+	return &_kernel.cpus[thread->base.cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -67,18 +75,86 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
 }
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Number of threads a CPU would have to go through before running one more */
+static inline uint32_t cpu_load(struct _cpu *cpu)
+{
+	return cpu->ready_q.depth + (cpu->current->base.is_idle ? 0U : 1U);
+}
+
+/* Queue a thread that never ran, or that may no longer run on the CPU it
+ * last ran on, on the least loaded CPU it may run on, preferring the
+ * current one.
+ */
+static void runq_place(struct k_thread *thread)
+{
+	struct _cpu *best = NULL;
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		unsigned int id = (_current_cpu->id + i) % num_cpus;
+		struct _cpu *cpu = &_kernel.cpus[id];
+
+		/* Not started, nobody would run the thread there */
+		if (cpu->current == NULL) {
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(id)) == 0) {
+			continue;
+		}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+		if ((best == NULL) || (cpu_load(cpu) < cpu_load(best))) {
+			best = cpu;
+		}
+	}
+
+	thread->base.cpu = (best != NULL) ? (best - _kernel.cpus) : _current_cpu->id;
+	thread->base.runq_placed = 1U;
+}
+
+/* Whether a thread may stay queued on the CPU it last ran on. Its CPU mask
+ * may have been changed since, while it was not runnable.
+ */
+static inline bool runq_placed_ok(struct k_thread *thread)
+{
+	if (!thread->base.runq_placed) {
+		return false;
+	}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((thread->base.cpu_mask & BIT(thread->base.cpu)) == 0) {
+		return false;
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	return true;
+}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	if (!runq_placed_ok(thread)) {
+		runq_place(thread);
+	}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 	_priq_run_add(thread_runq(thread), thread);
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	CONTAINER_OF(thread_runq(thread), struct _ready_q, runq)->depth++;
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
@@ -86,6 +162,9 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
 	_priq_run_remove(thread_runq(thread), thread);
+#if defined(CONFIG_SCHED_THREAD_USAGE_HISTOGRAM) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	CONTAINER_OF(thread_runq(thread), struct _ready_q, runq)->depth--;
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_yield(void)
@@ -93,9 +172,47 @@ static ALWAYS_INLINE void runq_yield(void)
 	_priq_run_yield(curr_cpu_runq());
 }
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Best thread of the local run queue, unless another CPU's queue holds a
+ * thread of strictly higher priority, in which case that one is stolen.
+ * Remote queues are visited starting with the next CPU so that stealing
+ * pressure is spread evenly; ties always favor the local queue. All queues
+ * are protected by _sched_spinlock.
+ */
+static struct k_thread *runq_best_or_steal(void)
+{
+	struct _cpu *curr = arch_curr_cpu();
+	unsigned int num_cpus = arch_num_cpus();
+	struct k_thread *best = _priq_run_best(&curr->ready_q.runq);
+
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		unsigned int id = (curr->id + i) % num_cpus;
+		struct _cpu *cpu = &_kernel.cpus[id];
+		struct k_thread *thread;
+
+		/* Nothing to steal, don't touch the queue */
+		if (cpu->ready_q.depth == 0U) {
+			continue;
+		}
+
+		thread = _priq_run_best(&cpu->ready_q.runq);
+		if ((thread != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
+}
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	return runq_best_or_steal();
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -334,6 +451,10 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_usage_ready(thread);
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+		z_cbs_ready(thread);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 		queue_thread(thread);
 		update_cache(0);
 
@@ -860,6 +981,9 @@ void *z_get_next_switch_handle(void *interrupted)
 		new_thread = next_up();
 
 		z_sched_usage_switch(new_thread);
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+		z_cbs_switch(new_thread);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 
 		if (old_thread != new_thread) {
 			uint8_t  cpu_id;
@@ -911,6 +1035,9 @@ void *z_get_next_switch_handle(void *interrupted)
 	return ret;
 #else
 	z_sched_usage_switch(_kernel.ready_q.cache);
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	z_cbs_switch(_kernel.ready_q.cache);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 	_current->switch_handle = interrupted;
 	set_current(_kernel.ready_q.cache);
 	return _current->switch_handle;
@@ -932,6 +1059,13 @@ int z_unpend_all(_wait_q_t *wait_q)
 	return need_sched;
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+uint32_t z_sched_runq_depth(void)
+{
+	return CONTAINER_OF(curr_cpu_runq(), struct _ready_q, runq)->depth;
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 void init_ready_q(struct _ready_q *ready_q)
 {
 	_priq_run_init(&ready_q->runq);
@@ -939,13 +1073,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_PER_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -981,24 +1115,37 @@ static inline void z_vrfy_k_thread_priority_set(k_tid_t thread, int prio)
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_SCHED_DEADLINE
-void z_impl_k_thread_absolute_deadline_set(k_tid_t tid, int deadline)
+static void deadline_set(struct k_thread *thread, int deadline)
 {
-	struct k_thread *thread = tid;
-
 	/* The prio_deadline field changes the sorting order, so can't
 	 * change it while the thread is in the run queue (dlists
 	 * actually are benign as long as we requeue it before we
 	 * release the lock, but an rbtree will blow up if we break
 	 * sorting!)
 	 */
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(thread);
+		thread->base.prio_deadline = deadline;
+		queue_thread(thread);
+	} else {
+		thread->base.prio_deadline = deadline;
+	}
+}
+
+void z_sched_deadline_update(struct k_thread *thread, int deadline)
+{
+	deadline_set(thread, deadline);
+	if (z_is_thread_queued(thread) || (thread == _current)) {
+		update_cache(thread == _current);
+	}
+}
+
+void z_impl_k_thread_absolute_deadline_set(k_tid_t tid, int deadline)
+{
+	struct k_thread *thread = tid;
+
 	K_SPINLOCK(&_sched_spinlock) {
-		if (z_is_thread_queued(thread)) {
-			dequeue_thread(thread);
-			thread->base.prio_deadline = deadline;
-			queue_thread(thread);
-		} else {
-			thread->base.prio_deadline = deadline;
-		}
+		deadline_set(thread, deadline);
 	}
 }
 
@@ -1257,6 +1404,9 @@ static ALWAYS_INLINE void halt_thread(struct k_thread *thread, uint8_t new_state
 				unpend_thread_no_timeout(thread);
 			}
 			z_abort_thread_timeout(thread);
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+			z_cbs_thread_exit(thread);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 			unpend_all(&thread->join_queue);
 
 			/* Edge case: aborting _current from within an
@@ -32,6 +32,13 @@ void k_stack_init(struct k_stack *stack, stack_data_t *buffer,
 	stack->next = buffer;
 	stack->base = buffer;
 	stack->top = stack->base + num_entries;
+#ifdef CONFIG_STACK_LOCKLESS
+	stack->links = NULL;
+	atomic_set(&stack->used, 0);
+	atomic_set(&stack->free, 0);
+	atomic_set(&stack->fresh, 0);
+	atomic_set(&stack->waiters, 0);
+#endif /* CONFIG_STACK_LOCKLESS */
 
 	SYS_PORT_TRACING_OBJ_INIT(k_stack, stack);
 	k_object_init(stack);
@@ -41,17 +48,207 @@ void k_stack_init(struct k_stack *stack, stack_data_t *buffer,
 #endif /* CONFIG_OBJ_CORE_STACK */
 }
 
+#ifdef CONFIG_STACK_LOCKLESS
+/*
+ * Stacks with slot links, defined with K_STACK_DEFINE() or allocated with
+ * k_stack_alloc_init(), push and pop values without taking the stack lock.
+ * The slots of the buffer are kept on two Treiber stacks, one of the slots
+ * holding a value and one of the released slots. Each head packs the index
+ * of its top slot plus one with a tag bumped on every update, so that a
+ * slot popped and pushed back between the read and the compare-and-swap of
+ * a head cannot pass for an unchanged head (the ABA problem). Slots past the
+ * fresh count were never used, which spares linking the slots of statically
+ * defined stacks at boot.
+ *
+ * The lock is only taken to pend or to hand values to pending threads. A
+ * thread about to pend counts itself in waiters under the lock before
+ * looking at the stack again, while a pusher checks waiters after
+ * publishing its value, so at least one of them sees the other.
+ */
+
+#define SLOT_MASK ((uintptr_t)Z_STACK_LOCKLESS_MAX_ENTRIES)
+#define SLOT_TAG  (SLOT_MASK + 1U)
+
+static int slot_pop(struct k_stack *stack, atomic_t *head)
+{
+	uintptr_t old;
+	uintptr_t new;
+	uint16_t top;
+
+	do {
+		old = (uintptr_t)atomic_get(head);
+		top = (uint16_t)(old & SLOT_MASK);
+		if (top == 0U) {
+			return -1;
+		}
+		/* A stale link only matters if the tag did not change */
+		new = ((old + SLOT_TAG) & ~SLOT_MASK) | stack->links[top - 1U];
+	} while (!atomic_cas(head, (atomic_val_t)old, (atomic_val_t)new));
+
+	return top - 1;
+}
+
+static void slot_push(struct k_stack *stack, atomic_t *head, int slot)
+{
+	uintptr_t old;
+	uintptr_t new;
+
+	do {
+		old = (uintptr_t)atomic_get(head);
+		stack->links[slot] = (uint16_t)(old & SLOT_MASK);
+		new = ((old + SLOT_TAG) & ~SLOT_MASK) | (uintptr_t)(slot + 1);
+	} while (!atomic_cas(head, (atomic_val_t)old, (atomic_val_t)new));
+}
+
+static int slot_alloc(struct k_stack *stack)
+{
+	atomic_val_t num_entries = stack->top - stack->base;
+	atomic_val_t fresh;
+	int slot = slot_pop(stack, &stack->free);
+
+	if (slot >= 0) {
+		return slot;
+	}
+
+	do {
+		fresh = atomic_get(&stack->fresh);
+		if (fresh == num_entries) {
+			return -1;
+		}
+	} while (!atomic_cas(&stack->fresh, fresh, fresh + 1));
+
+	return (int)fresh;
+}
+
+static bool lockless_pop(struct k_stack *stack, stack_data_t *data)
+{
+	int slot = slot_pop(stack, &stack->used);
+
+	if (slot < 0) {
+		return false;
+	}
+
+	*data = stack->base[slot];
+	slot_push(stack, &stack->free, slot);
+
+	return true;
+}
+
+/* Hand the values pushed without the lock to the pending threads */
+static void lockless_wake(struct k_stack *stack)
+{
+	k_spinlock_key_t key = k_spin_lock(&stack->lock);
+	struct k_thread *pending_thread;
+	bool resched = false;
+	int slot;
+
+	for (;;) {
+		slot = slot_pop(stack, &stack->used);
+		if (slot < 0) {
+			break;
+		}
+
+		pending_thread = z_unpend_first_thread(&stack->wait_q);
+		if (pending_thread == NULL) {
+			/* the waiters timed out or got a value meanwhile */
+			slot_push(stack, &stack->used, slot);
+			break;
+		}
+
+		z_thread_return_value_set_with_data(pending_thread, 0,
+						    (void *)stack->base[slot]);
+		slot_push(stack, &stack->free, slot);
+		z_ready_thread(pending_thread);
+		resched = true;
+	}
+
+	if (resched) {
+		z_reschedule(&stack->lock, key);
+	} else {
+		k_spin_unlock(&stack->lock, key);
+	}
+}
+
+static int lockless_push(struct k_stack *stack, stack_data_t data)
+{
+	int slot = slot_alloc(stack);
+
+	if (slot < 0) {
+		return -ENOMEM;
+	}
+
+	stack->base[slot] = data;
+	slot_push(stack, &stack->used, slot);
+
+	if (atomic_get(&stack->waiters) != 0) {
+		lockless_wake(stack);
+	}
+
+	return 0;
+}
+
+static int lockless_pop_wait(struct k_stack *stack, stack_data_t *data,
+			     k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	if (lockless_pop(stack, data)) {
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+	key = k_spin_lock(&stack->lock);
+	(void)atomic_inc(&stack->waiters);
+
+	if (lockless_pop(stack, data)) {
+		/* a value was pushed meanwhile */
+		(void)atomic_dec(&stack->waiters);
+		k_spin_unlock(&stack->lock, key);
+		return 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_stack, pop, stack, timeout);
+
+	result = z_pend_curr(&stack->lock, key, &stack->wait_q, timeout);
+	(void)atomic_dec(&stack->waiters);
+	if (result == -EAGAIN) {
+		return -EAGAIN;
+	}
+
+	*data = (stack_data_t)_current->base.swap_data;
+
+	return 0;
+}
+#endif /* CONFIG_STACK_LOCKLESS */
+
 int32_t z_impl_k_stack_alloc_init(struct k_stack *stack, uint32_t num_entries)
 {
 	void *buffer;
+	size_t size = num_entries * sizeof(stack_data_t);
 	int32_t ret;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_stack, alloc_init, stack);
 
-	buffer = z_thread_malloc(num_entries * sizeof(stack_data_t));
+#ifdef CONFIG_STACK_LOCKLESS
+	/* Slot links go right after the values */
+	if (num_entries <= Z_STACK_LOCKLESS_MAX_ENTRIES) {
+		size += num_entries * sizeof(uint16_t);
+	}
+#endif /* CONFIG_STACK_LOCKLESS */
+
+	buffer = z_thread_malloc(size);
 	if (buffer != NULL) {
 		k_stack_init(stack, buffer, num_entries);
 		stack->flags = K_STACK_FLAG_ALLOC;
+#ifdef CONFIG_STACK_LOCKLESS
+		if (num_entries <= Z_STACK_LOCKLESS_MAX_ENTRIES) {
+			stack->links = (uint16_t *)stack->top;
+		}
+#endif /* CONFIG_STACK_LOCKLESS */
 		ret = 0;
 	} else {
 		ret = -ENOMEM;
@@ -91,6 +288,9 @@ int k_stack_cleanup(struct k_stack *stack)
 		k_free(stack->base);
 		stack->base = NULL;
 		stack->flags &= ~K_STACK_FLAG_ALLOC;
+#ifdef CONFIG_STACK_LOCKLESS
+		stack->links = NULL;
+#endif /* CONFIG_STACK_LOCKLESS */
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_stack, cleanup, stack, 0);
@@ -102,7 +302,19 @@ int z_impl_k_stack_push(struct k_stack *stack, stack_data_t data)
 {
 	struct k_thread *first_pending_thread;
 	int ret = 0;
-	k_spinlock_key_t key = k_spin_lock(&stack->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_STACK_LOCKLESS
+	if (stack->links != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_stack, push, stack);
+		ret = lockless_push(stack, data);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_stack, push, stack, ret);
+
+		return ret;
+	}
+#endif /* CONFIG_STACK_LOCKLESS */
+
+	key = k_spin_lock(&stack->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_stack, push, stack);
 
@@ -151,6 +363,16 @@ int z_impl_k_stack_pop(struct k_stack *stack, stack_data_t *data,
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_STACK_LOCKLESS
+	if (stack->links != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_stack, pop, stack, timeout);
+		result = lockless_pop_wait(stack, data, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_stack, pop, stack, timeout, result);
+
+		return result;
+	}
+#endif /* CONFIG_STACK_LOCKLESS */
+
 	key = k_spin_lock(&stack->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_stack, pop, stack, timeout);
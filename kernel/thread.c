@@ -381,7 +381,8 @@ static size_t random_offset(size_t stack_size)
 #endif /* CONFIG_STACK_POINTER_RANDOM */
 
 static char *setup_thread_stack(struct k_thread *new_thread,
-				k_thread_stack_t *stack, size_t stack_size)
+				k_thread_stack_t *stack, size_t stack_size,
+				bool stack_filled)
 {
 	size_t stack_obj_size, stack_buf_size;
 	char *stack_ptr, *stack_buf_start;
@@ -459,7 +460,11 @@ static char *setup_thread_stack(struct k_thread *new_thread,
 		stack_buf_size, (void *)stack_ptr);
 
 #ifdef CONFIG_INIT_STACKS
-	memset(stack_buf_start, 0xaa, stack_buf_size);
+	if (!stack_filled) {
+		memset(stack_buf_start, 0xaa, stack_buf_size);
+	}
+#else
+	ARG_UNUSED(stack_filled);
 #endif /* CONFIG_INIT_STACKS */
 #ifdef CONFIG_STACK_SENTINEL
 	/* Put the stack sentinel at the lowest 4 bytes of the stack area.
@@ -570,11 +575,12 @@ static void setup_shadow_stack(struct k_thread *new_thread,
  * K_THREAD_STACK_SIZEOF(stack), or the size value passed to the instance
  * of K_THREAD_STACK_DEFINE() which defined 'stack'.
  */
-char *z_setup_new_thread(struct k_thread *new_thread,
-			 k_thread_stack_t *stack, size_t stack_size,
-			 k_thread_entry_t entry,
-			 void *p1, void *p2, void *p3,
-			 int prio, uint32_t options, const char *name)
+static char *setup_new_thread(struct k_thread *new_thread,
+			      k_thread_stack_t *stack, size_t stack_size,
+			      k_thread_entry_t entry,
+			      void *p1, void *p2, void *p3,
+			      int prio, uint32_t options, const char *name,
+			      bool stack_filled)
 {
 	char *stack_ptr;
 
@@ -609,7 +615,7 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 
 	/* Initialize various struct k_thread members */
 	z_init_thread_base(&new_thread->base, prio, _THREAD_SLEEPING, options);
-	stack_ptr = setup_thread_stack(new_thread, stack, stack_size);
+	stack_ptr = setup_thread_stack(new_thread, stack, stack_size, stack_filled);
 
 #ifdef CONFIG_HW_SHADOW_STACK
 	setup_shadow_stack(new_thread, stack);
@@ -717,16 +723,27 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 }
 
 
-k_tid_t z_impl_k_thread_create(struct k_thread *new_thread,
-			      k_thread_stack_t *stack,
-			      size_t stack_size, k_thread_entry_t entry,
-			      void *p1, void *p2, void *p3,
-			      int prio, uint32_t options, k_timeout_t delay)
+char *z_setup_new_thread(struct k_thread *new_thread,
+			 k_thread_stack_t *stack, size_t stack_size,
+			 k_thread_entry_t entry,
+			 void *p1, void *p2, void *p3,
+			 int prio, uint32_t options, const char *name)
+{
+	return setup_new_thread(new_thread, stack, stack_size, entry, p1, p2, p3,
+				prio, options, name, false);
+}
+
+static k_tid_t thread_create(struct k_thread *new_thread,
+			     k_thread_stack_t *stack,
+			     size_t stack_size, k_thread_entry_t entry,
+			     void *p1, void *p2, void *p3,
+			     int prio, uint32_t options, k_timeout_t delay,
+			     bool stack_filled)
 {
 	__ASSERT(!arch_is_in_isr(), "Threads may not be created in ISRs");
 
-	z_setup_new_thread(new_thread, stack, stack_size, entry, p1, p2, p3,
-			  prio, options, NULL);
+	setup_new_thread(new_thread, stack, stack_size, entry, p1, p2, p3,
+			 prio, options, NULL, stack_filled);
 
 	if (!K_TIMEOUT_EQ(delay, K_FOREVER)) {
 		thread_schedule_new(new_thread, delay);
@@ -735,6 +752,28 @@ k_tid_t z_impl_k_thread_create(struct k_thread *new_thread,
 	return new_thread;
 }
 
+k_tid_t z_impl_k_thread_create(struct k_thread *new_thread,
+			      k_thread_stack_t *stack,
+			      size_t stack_size, k_thread_entry_t entry,
+			      void *p1, void *p2, void *p3,
+			      int prio, uint32_t options, k_timeout_t delay)
+{
+	return thread_create(new_thread, stack, stack_size, entry, p1, p2, p3,
+			     prio, options, delay, false);
+}
+
+#if defined(CONFIG_DYNAMIC_THREAD_ALLOC) && defined(CONFIG_INIT_STACKS)
+k_tid_t z_thread_create_stack_filled(struct k_thread *new_thread,
+				     k_thread_stack_t *stack,
+				     size_t stack_size, k_thread_entry_t entry,
+				     void *p1, void *p2, void *p3,
+				     int prio, uint32_t options, k_timeout_t delay)
+{
+	return thread_create(new_thread, stack, stack_size, entry, p1, p2, p3,
+			     prio, options, delay, true);
+}
+#endif /* CONFIG_DYNAMIC_THREAD_ALLOC && CONFIG_INIT_STACKS */
+
 #ifdef CONFIG_USERSPACE
 bool z_stack_is_user_capable(k_thread_stack_t *stack)
 {
@@ -824,11 +863,19 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->is_idle = 0;
 #endif /* CONFIG_SMP */
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	thread_base->runq_placed = 0U;
+#endif /* CONFIG_SCHED_PER_CPU_RUNQ */
+
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 	thread_base->slice_ticks = 0;
 	thread_base->slice_expired = NULL;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	thread_base->cbs = (struct _thread_cbs) {};
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -988,6 +1035,10 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif /* CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_SCHED_DEADLINE_CBS) && !defined(CONFIG_USE_SWITCH)
+	z_cbs_switched_in();
+#endif /* CONFIG_SCHED_DEADLINE_CBS && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif /* CONFIG_TRACING */
@@ -999,6 +1050,10 @@ void z_thread_mark_switched_out(void)
 	z_sched_usage_stop();
 #endif /*CONFIG_SCHED_THREAD_USAGE && !CONFIG_USE_SWITCH */
 
+#if defined(CONFIG_SCHED_DEADLINE_CBS) && !defined(CONFIG_USE_SWITCH)
+	z_cbs_switched_out();
+#endif /* CONFIG_SCHED_DEADLINE_CBS && !CONFIG_USE_SWITCH */
+
 #ifdef CONFIG_TRACING
 #ifdef CONFIG_THREAD_LOCAL_STORAGE
 	/* Dummy thread won't have TLS set up to run arbitrary code */
@@ -1023,6 +1078,10 @@ int k_thread_runtime_stats_get(k_tid_t thread,
 	z_sched_thread_usage(thread, stats);
 #else
 	*stats = (k_thread_runtime_stats_t) {};
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	stats->deadline_misses = thread->base.cbs.deadline_misses;
+	stats->budget_overruns = thread->base.cbs.budget_overruns;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
 
 	return 0;
@@ -1056,6 +1115,11 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+		for (unsigned int j = 0; j < ARRAY_SIZE(stats->histogram); j++) {
+			stats->histogram[j] += tmp_stats.histogram[j];
+		}
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
 
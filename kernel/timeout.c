@@ -11,10 +11,19 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#include <timeout_wheel.h>
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+/* Most due timeouts claimed from the queue per lock release */
+#define EXPIRED_BATCH 16
 
 /*
  * The timeout code shall take no locks other than its own (timeout_lock), nor
@@ -37,6 +46,7 @@ static inline unsigned int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifndef CONFIG_TIMEOUT_QUEUE_WHEEL
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +69,22 @@ static void remove_timeout(struct _timeout *t)
 
 	sys_dlist_remove(&t->node);
 }
+#endif /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Number of ticks to defer an @a expiry by, at most @a slack, to land on
+ * the tick of the window with the most trailing zero bits. Timeouts whose
+ * windows overlap thus tend to be moved to the same tick.
+ */
+static k_ticks_t slack_delay(uint64_t expiry, uint32_t slack)
+{
+	uint64_t limit = expiry + slack;
+	uint64_t diff = (expiry - 1U) ^ limit;
+	uint64_t mask = BIT64(63U - u64_count_leading_zeros(diff)) - 1U;
+
+	return (k_ticks_t)((limit & ~mask) - expiry);
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
 
 static int32_t elapsed(void)
 {
@@ -81,6 +107,27 @@ static int32_t elapsed(void)
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+static int32_t next_timeout(int32_t ticks_elapsed)
+{
+	uint64_t expiry;
+	int64_t dticks;
+	int32_t ret;
+
+	if (!z_timeout_wheel_next(&expiry)) {
+		return SYS_CLOCK_MAX_WAIT;
+	}
+
+	dticks = (int64_t)(expiry - curr_tick);
+	if ((dticks - ticks_elapsed) > (int64_t)INT_MAX) {
+		ret = SYS_CLOCK_MAX_WAIT;
+	} else {
+		ret = MAX(0, dticks - ticks_elapsed);
+	}
+
+	return ret;
+}
+#else
 static int32_t next_timeout(int32_t ticks_elapsed)
 {
 	struct _timeout *to = first();
@@ -95,8 +142,15 @@ static int32_t next_timeout(int32_t ticks_elapsed)
 
 	return ret;
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 
 k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t timeout)
+{
+	return z_add_timeout_slack(to, fn, timeout, 0);
+}
+
+k_ticks_t z_add_timeout_slack(struct _timeout *to, _timeout_func_t fn,
+			      k_timeout_t timeout, uint32_t slack)
 {
 	k_ticks_t ticks = 0;
 
@@ -112,9 +166,9 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
 		int32_t ticks_elapsed;
 		bool has_elapsed = false;
+		bool is_first;
 
 		if (Z_IS_TIMEOUT_RELATIVE(timeout)) {
 			ticks_elapsed = elapsed();
@@ -128,6 +182,26 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 			ticks = timeout.ticks;
 		}
 
+#ifdef CONFIG_TIMEOUT_SLACK
+		if (slack != 0U) {
+			k_ticks_t delay = slack_delay(curr_tick + to->dticks, slack);
+
+			to->dticks += delay;
+			ticks += delay;
+		}
+#else
+		ARG_UNUSED(slack);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		uint64_t next_expiry;
+		uint64_t expiry = curr_tick + to->dticks;
+
+		is_first = !z_timeout_wheel_next(&next_expiry) || (expiry < next_expiry);
+		z_timeout_wheel_insert(to, expiry);
+#else
+		struct _timeout *t;
+
 		for (t = first(); t != NULL; t = next(t)) {
 			if (t->dticks > to->dticks) {
 				t->dticks -= to->dticks;
@@ -141,7 +215,10 @@ k_ticks_t z_add_timeout(struct _timeout *to, _timeout_func_t fn, k_timeout_t tim
 			sys_dlist_append(&timeout_list, &to->node);
 		}
 
-		if (to == first() && announce_remaining == 0) {
+		is_first = (to == first());
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+		if (is_first && announce_remaining == 0) {
 			if (!has_elapsed) {
 				/* In case of absolute timeout that is first to expire
 				 * elapsed need to be read from the system clock.
@@ -160,16 +237,27 @@ int z_abort_timeout(struct _timeout *to)
 	int ret = -EINVAL;
 
 	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			bool is_first = (to == first());
-
-			remove_timeout(to);
-			to->dticks = TIMEOUT_DTICKS_ABORTED;
-			ret = 0;
-			if (is_first) {
-				sys_clock_set_timeout(next_timeout(elapsed()), false);
-			}
+		if (!sys_dnode_is_linked(&to->node)) {
+			break;
+		}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		uint64_t next_expiry;
+		bool is_first = z_timeout_wheel_next(&next_expiry) &&
+				(z_timeout_wheel_expiry(to) == next_expiry);
+
+		z_timeout_wheel_remove(to);
+#else
+		bool is_first = (to == first());
+
+		remove_timeout(to);
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+		if (is_first) {
+			sys_clock_set_timeout(next_timeout(elapsed()), false);
 		}
+
+		to->dticks = TIMEOUT_DTICKS_ABORTED;
+		ret = 0;
 	}
 
 	return ret;
@@ -178,6 +266,9 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	return (k_ticks_t)(z_timeout_wheel_expiry(timeout) - curr_tick);
+#else
 	k_ticks_t ticks = 0;
 
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
@@ -188,6 +279,7 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 	}
 
 	return ticks;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -227,6 +319,61 @@ int32_t z_get_next_timeout_expiry(void)
 	return ret;
 }
 
+/* Unlink up to EXPIRED_BATCH timeouts due on curr_tick into @a batch, in
+ * queue order. Must be locked.
+ */
+static int expired_claim(struct _timeout **batch)
+{
+	int n = 0;
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t expiry;
+
+	while ((n < EXPIRED_BATCH) && z_timeout_wheel_next(&expiry) &&
+	       (expiry == curr_tick)) {
+		batch[n] = z_timeout_wheel_pop(expiry);
+		batch[n++]->dticks = 0;
+	}
+#else
+	struct _timeout *t;
+
+	while ((n < EXPIRED_BATCH) && ((t = first()) != NULL) &&
+	       (t->dticks == 0)) {
+		remove_timeout(t);
+		batch[n++] = t;
+	}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+	return n;
+}
+
+/* Run the callbacks of the timeouts due on curr_tick. Each batch is taken
+ * off the queue in one go, then its callbacks run back to back with the lock
+ * released once. Claimed timeouts are unlinked, so like a firing timeout
+ * they can no longer be aborted. A member restarted by an earlier callback
+ * of the batch is linked again (or aborted after that, which leaves non-zero
+ * dticks) and is skipped: the restart supersedes the pending expiry.
+ */
+static void fire_expired(k_spinlock_key_t *key)
+{
+	struct _timeout *batch[EXPIRED_BATCH];
+	int n;
+
+	while ((n = expired_claim(batch)) > 0) {
+		k_spin_unlock(&timeout_lock, *key);
+
+		for (int i = 0; i < n; i++) {
+			struct _timeout *t = batch[i];
+
+			if (!sys_dnode_is_linked(&t->node) && (t->dticks == 0)) {
+				t->fn(t);
+			}
+		}
+
+		*key = k_spin_lock(&timeout_lock);
+	}
+}
+
 void sys_clock_announce(int32_t ticks)
 {
 	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
@@ -245,6 +392,21 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	uint64_t expiry;
+
+	while (z_timeout_wheel_next(&expiry) &&
+	       ((int64_t)(expiry - curr_tick) <= announce_remaining)) {
+		int dt = (int)(expiry - curr_tick);
+
+		curr_tick = expiry;
+		fire_expired(&key);
+		announce_remaining -= dt;
+	}
+
+	curr_tick += announce_remaining;
+	z_timeout_wheel_advance(curr_tick);
+#else
 	struct _timeout *t;
 
 	for (t = first();
@@ -254,11 +416,7 @@ void sys_clock_announce(int32_t ticks)
 
 		curr_tick += dt;
 		t->dticks = 0;
-		remove_timeout(t);
-
-		k_spin_unlock(&timeout_lock, key);
-		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
+		fire_expired(&key);
 		announce_remaining -= dt;
 	}
 
@@ -267,6 +425,7 @@ void sys_clock_announce(int32_t ticks)
 	}
 
 	curr_tick += announce_remaining;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(0), false);
@@ -276,6 +435,10 @@ void sys_clock_announce(int32_t ticks)
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
 #endif /* CONFIG_TIMESLICING */
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	z_cbs_budget_check();
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 }
 
 int64_t sys_clock_tick_get(void)
@@ -350,7 +513,14 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	K_SPINLOCK(&timeout_lock) {
+		z_timeout_wheel_rebase(tick);
+		curr_tick = tick;
+	}
+#else
 	curr_tick = tick;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -0,0 +1,277 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/math_extras.h>
+#include <timeout_wheel.h>
+
+#define WHEEL_LEVELS	CONFIG_TIMEOUT_WHEEL_LEVELS
+#define SLOT_BITS	CONFIG_TIMEOUT_WHEEL_SLOT_BITS
+#define WHEEL_SLOTS	BIT(SLOT_BITS)
+#define SLOT_MASK	((uint64_t)WHEEL_SLOTS - 1U)
+
+BUILD_ASSERT(WHEEL_SLOTS <= 32, "slot occupancy is tracked in a 32 bit mask");
+
+/* Slot lists are only initialized when they become occupied, so the
+ * occupancy bit is authoritative and an unoccupied list is never touched.
+ */
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint32_t occupied[WHEEL_LEVELS];
+
+/* Timeouts beyond the top level, sorted by expiry */
+static sys_dlist_t overflow = SYS_DLIST_STATIC_INIT(&overflow);
+
+static uint64_t wheel_now;
+
+/* Cached result of z_timeout_wheel_next(), UINT64_MAX when empty */
+static uint64_t next_expiry = UINT64_MAX;
+static bool next_valid = true;
+
+static inline struct _timeout *to_timeout(sys_dnode_t *node)
+{
+	return CONTAINER_OF(node, struct _timeout, node);
+}
+
+uint64_t z_timeout_wheel_expiry(const struct _timeout *to)
+{
+	/* dticks holds the absolute expiry, truncated to its own width.
+	 * Pending timeouts never lie in the past, so the unsigned
+	 * difference to the wheel time recovers the full value.
+	 */
+#ifdef CONFIG_TIMEOUT_64BIT
+	return (uint64_t)to->dticks;
+#else
+	return wheel_now + (uint32_t)((uint32_t)to->dticks - (uint32_t)wheel_now);
+#endif /* CONFIG_TIMEOUT_64BIT */
+}
+
+/* Lowest level spanning both expiry and wheel_now, WHEEL_LEVELS if none */
+static int wheel_level(uint64_t expiry)
+{
+	uint64_t diff = expiry ^ wheel_now;
+	int lvl;
+
+	if (diff == 0U) {
+		return 0;
+	}
+
+	lvl = (63 - u64_count_leading_zeros(diff)) / SLOT_BITS;
+
+	return MIN(lvl, WHEEL_LEVELS);
+}
+
+static inline unsigned int wheel_slot(uint64_t expiry, int lvl)
+{
+	return (unsigned int)((expiry >> (SLOT_BITS * lvl)) & SLOT_MASK);
+}
+
+static void overflow_insert(struct _timeout *to, uint64_t expiry)
+{
+	struct _timeout *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&overflow, t, node) {
+		if (z_timeout_wheel_expiry(t) > expiry) {
+			sys_dlist_insert(&t->node, &to->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&overflow, &to->node);
+}
+
+static void enqueue(struct _timeout *to)
+{
+	uint64_t expiry = z_timeout_wheel_expiry(to);
+	int lvl = wheel_level(expiry);
+	unsigned int slot;
+
+	if (lvl == WHEEL_LEVELS) {
+		overflow_insert(to, expiry);
+		return;
+	}
+
+	slot = wheel_slot(expiry, lvl);
+	if ((occupied[lvl] & BIT(slot)) == 0U) {
+		sys_dlist_init(&wheel[lvl][slot]);
+		occupied[lvl] |= BIT(slot);
+	}
+	sys_dlist_append(&wheel[lvl][slot], &to->node);
+}
+
+static void dequeue(struct _timeout *to)
+{
+	uint64_t expiry = z_timeout_wheel_expiry(to);
+	int lvl = wheel_level(expiry);
+	unsigned int slot;
+
+	sys_dlist_remove(&to->node);
+
+	if (lvl < WHEEL_LEVELS) {
+		slot = wheel_slot(expiry, lvl);
+		if (sys_dlist_is_empty(&wheel[lvl][slot])) {
+			occupied[lvl] &= ~BIT(slot);
+		}
+	}
+}
+
+void z_timeout_wheel_insert(struct _timeout *to, uint64_t expiry)
+{
+	__ASSERT_NO_MSG(expiry > wheel_now);
+
+	to->dticks = expiry;
+	enqueue(to);
+
+	if (next_valid && (expiry < next_expiry)) {
+		next_expiry = expiry;
+	}
+}
+
+void z_timeout_wheel_remove(struct _timeout *to)
+{
+	if (z_timeout_wheel_expiry(to) == next_expiry) {
+		next_valid = false;
+	}
+
+	dequeue(to);
+}
+
+static uint64_t find_next(void)
+{
+	for (int lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		uint64_t min = UINT64_MAX;
+		unsigned int slot;
+		struct _timeout *t;
+
+		if (occupied[lvl] == 0U) {
+			continue;
+		}
+
+		/* Everything on a level expires after everything on the
+		 * levels below it, and slots at or before the current index
+		 * are empty, so the lowest occupied slot holds the minimum.
+		 */
+		slot = u32_count_trailing_zeros(occupied[lvl]);
+		if (lvl == 0) {
+			return (wheel_now & ~SLOT_MASK) | slot;
+		}
+
+		SYS_DLIST_FOR_EACH_CONTAINER(&wheel[lvl][slot], t, node) {
+			min = MIN(min, z_timeout_wheel_expiry(t));
+		}
+
+		return min;
+	}
+
+	if (!sys_dlist_is_empty(&overflow)) {
+		return z_timeout_wheel_expiry(to_timeout(sys_dlist_peek_head(&overflow)));
+	}
+
+	return UINT64_MAX;
+}
+
+bool z_timeout_wheel_next(uint64_t *expiry)
+{
+	if (!next_valid) {
+		next_expiry = find_next();
+		next_valid = true;
+	}
+
+	*expiry = next_expiry;
+
+	return next_expiry != UINT64_MAX;
+}
+
+static void cascade(sys_dlist_t *list)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		enqueue(to_timeout(node));
+	}
+}
+
+void z_timeout_wheel_advance(uint64_t now)
+{
+	uint64_t prev = wheel_now;
+
+	if (now == prev) {
+		return;
+	}
+
+	__ASSERT_NO_MSG(now > prev);
+	wheel_now = now;
+
+	/* Pull in overflow entries that now fit in the wheel. The list is
+	 * sorted, so stop at the first one that still does not.
+	 */
+	while (!sys_dlist_is_empty(&overflow)) {
+		struct _timeout *t = to_timeout(sys_dlist_peek_head(&overflow));
+
+		if (wheel_level(z_timeout_wheel_expiry(t)) == WHEEL_LEVELS) {
+			break;
+		}
+		sys_dlist_remove(&t->node);
+		enqueue(t);
+	}
+
+	/* On each level whose index moved, the slot wheel_now entered holds
+	 * timeouts that now belong to a lower level. Slots skipped over are
+	 * empty, as nothing may expire before the new wheel time. Entries are
+	 * placed relative to the new time, so they land directly on their
+	 * final level and same-tick ordering is kept.
+	 */
+	for (int lvl = WHEEL_LEVELS - 1; lvl > 0; lvl--) {
+		unsigned int slot = wheel_slot(now, lvl);
+
+		if ((now >> (SLOT_BITS * lvl)) == (prev >> (SLOT_BITS * lvl))) {
+			continue;
+		}
+
+		if ((occupied[lvl] & BIT(slot)) != 0U) {
+			occupied[lvl] &= ~BIT(slot);
+			cascade(&wheel[lvl][slot]);
+		}
+	}
+}
+
+struct _timeout *z_timeout_wheel_pop(uint64_t expiry)
+{
+	unsigned int slot = wheel_slot(expiry, 0);
+	struct _timeout *t;
+
+	z_timeout_wheel_advance(expiry);
+
+	__ASSERT_NO_MSG((occupied[0] & BIT(slot)) != 0U);
+	t = to_timeout(sys_dlist_peek_head(&wheel[0][slot]));
+	dequeue(t);
+	next_valid = false;
+
+	return t;
+}
+
+void z_timeout_wheel_rebase(uint64_t now)
+{
+	sys_dlist_t pending = SYS_DLIST_STATIC_INIT(&pending);
+	uint64_t prev = wheel_now;
+	uint64_t expiry;
+	sys_dnode_t *node;
+
+	/* Collect every timeout with its remaining ticks stored in dticks */
+	while (z_timeout_wheel_next(&expiry)) {
+		struct _timeout *t = z_timeout_wheel_pop(expiry);
+
+		t->dticks = expiry - prev;
+		sys_dlist_append(&pending, &t->node);
+	}
+
+	wheel_now = now;
+
+	while ((node = sys_dlist_get(&pending)) != NULL) {
+		struct _timeout *t = to_timeout(node);
+
+		z_timeout_wheel_insert(t, now + t->dticks);
+	}
+}
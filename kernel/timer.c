@@ -19,6 +19,16 @@ static struct k_spinlock lock;
 static struct k_obj_type obj_type_timer;
 #endif /* CONFIG_OBJ_CORE_TIMER */
 
+static inline void timer_add_timeout(struct k_timer *timer, k_timeout_t timeout)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	z_add_timeout_slack(&timer->timeout, z_timer_expiration_handler,
+			    timeout, timer->slack);
+#else
+	z_add_timeout(&timer->timeout, z_timer_expiration_handler, timeout);
+#endif /* CONFIG_TIMEOUT_SLACK */
+}
+
 /**
  * @brief Handle expiration of a kernel timer object.
  *
@@ -73,8 +83,7 @@ void z_timer_expiration_handler(struct _timeout *t)
 		 */
 		next = K_TIMEOUT_ABS_TICKS(k_uptime_ticks() + 1 + next.ticks);
 #endif /* CONFIG_TIMEOUT_64BIT */
-		z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-			      next);
+		timer_add_timeout(timer, next);
 	}
 
 	/* update timer's status */
@@ -127,6 +136,9 @@ void k_timer_init(struct k_timer *timer,
 	SYS_PORT_TRACING_OBJ_INIT(k_timer, timer);
 
 	timer->user_data = NULL;
+#ifdef CONFIG_TIMEOUT_SLACK
+	timer->slack = 0U;
+#endif /* CONFIG_TIMEOUT_SLACK */
 
 	k_object_init(timer);
 
@@ -179,8 +191,7 @@ void z_impl_k_timer_start(struct k_timer *timer, k_timeout_t duration,
 	timer->period = period;
 	timer->status = 0U;
 
-	z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-		     duration);
+	timer_add_timeout(timer, duration);
 
 	k_spin_unlock(&lock, key);
 }
@@ -347,6 +358,18 @@ static inline void z_vrfy_k_timer_user_data_set(struct k_timer *timer,
 }
 #include <zephyr/syscalls/k_timer_user_data_set_mrsh.c>
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	K_OOPS(K_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	K_OOPS(K_SYSCALL_VERIFY(Z_IS_TIMEOUT_RELATIVE(slack) &&
+				!K_TIMEOUT_EQ(slack, K_FOREVER)));
+	z_impl_k_timer_slack_set(timer, slack);
+}
+#include <zephyr/syscalls/k_timer_slack_set_mrsh.c>
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_OBJ_CORE_TIMER
@@ -6,10 +6,12 @@
 
 #include <zephyr/kernel.h>
 
+#include <string.h>
 #include <zephyr/timing/timing.h>
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -71,6 +73,47 @@ static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+static void histogram_add(uint32_t *histogram, uint32_t value)
+{
+	unsigned int bucket = 0;
+
+	if (value != 0) {
+		bucket = MIN(32U - u32_count_leading_zeros(value),
+			     CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS - 1U);
+	}
+
+	histogram[bucket]++;
+}
+
+void z_sched_usage_ready(struct k_thread *thread)
+{
+	/* Cleared again once the thread is switched in */
+	thread->base.usage.ready0 = usage_now();
+}
+
+static void sched_update_histograms(struct _cpu *cpu, struct k_thread *thread,
+				    uint32_t now)
+{
+	if ((thread->base.usage.ready0 != 0) && thread->base.usage.track_usage) {
+		histogram_add(thread->base.usage.histogram,
+			      now - thread->base.usage.ready0);
+	}
+
+	thread->base.usage.ready0 = 0;
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	if (cpu->usage->track_usage) {
+		histogram_add(cpu->usage->histogram, z_sched_runq_depth());
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
+}
+#else
+#define sched_update_histograms(cpu, thread, now)   do { } while (0)
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 void z_sched_usage_start(struct k_thread *thread)
 {
 #ifdef CONFIG_SCHED_THREAD_USAGE_ANALYSIS
@@ -85,6 +128,8 @@ void z_sched_usage_start(struct k_thread *thread)
 		thread->base.usage.current = 0;
 	}
 
+	sched_update_histograms(_current_cpu, thread, _current_cpu->usage0);
+
 	k_spin_unlock(&usage_lock, key);
 #else
 	/* One write through a volatile pointer doesn't require
@@ -160,6 +205,15 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	memcpy(stats->histogram, cpu->usage->histogram, sizeof(stats->histogram));
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	stats->deadline_misses = 0U;
+	stats->budget_overruns = 0U;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 	stats->idle_cycles =
 		_kernel.cpus[cpu_id].idle_thread->base.usage.total;
 
@@ -216,6 +270,16 @@ void z_sched_thread_usage(struct k_thread *thread,
 	}
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	memcpy(stats->histogram, thread->base.usage.histogram,
+	       sizeof(stats->histogram));
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	stats->deadline_misses = thread->base.cbs.deadline_misses;
+	stats->budget_overruns = thread->base.cbs.budget_overruns;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	stats->idle_cycles = 0;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
@@ -381,6 +445,13 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->longest = 0ULL;
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif /* CONFIG_SCHED_THREAD_USAGE_ANALYSIS */
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+	memset(stats->histogram, 0, sizeof(stats->histogram));
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	thread->base.cbs.deadline_misses = 0U;
+	thread->base.cbs.budget_overruns = 0U;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 
 	if (thread != _current_cpu->current) {
 
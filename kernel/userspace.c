@@ -48,7 +48,7 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj dlist */
+static struct k_spinlock lists_lock;       /* kobj dlist and hash table */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 
 #ifdef CONFIG_GEN_PRIV_STACKS
@@ -70,7 +70,7 @@ static struct k_spinlock objfree_lock;     /* k_object_free */
 #endif /* CONFIG_GEN_PRIV_STACKS */
 
 #endif /* CONFIG_DYNAMIC_OBJECTS */
-static struct k_spinlock obj_lock;         /* kobj struct data */
+static struct k_spinlock obj_lock;         /* kobj struct data, perm lists */
 
 #define MAX_THREAD_BITS (CONFIG_MAX_THREAD_BYTES * BITS_PER_BYTE)
 
@@ -78,8 +78,6 @@ static struct k_spinlock obj_lock;         /* kobj struct data */
 extern uint8_t _thread_idx_map[CONFIG_MAX_THREAD_BYTES];
 #endif /* CONFIG_DYNAMIC_OBJECTS */
 
-static void clear_perms_cb(struct k_object *ko, void *ctx_ptr);
-
 const char *otype_to_str(enum k_objects otype)
 {
 	const char *ret;
@@ -166,9 +164,25 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 #define DYN_OBJ_DATA_ALIGN		\
 	MAX(DYN_OBJ_DATA_ALIGN_K_THREAD, (sizeof(void *)))
 
+/* Link of a dynamic object into the list of the objects a thread has
+ * permission on
+ */
+struct dyn_obj_perm {
+	sys_dnode_t node;
+	struct dyn_obj *dyn;
+	uintptr_t index;
+};
+
 struct dyn_obj {
 	struct k_object kobj;
 	sys_dnode_t dobj_list;
+	sys_snode_t hash_node;
+
+	/* Links for the threads having permission on the object, unless it
+	 * is on perm_overflow_list
+	 */
+	struct dyn_obj_perm perms[CONFIG_DYNAMIC_OBJECTS_PERM_LINKS];
+	sys_dnode_t overflow_node;
 
 	/* The object itself */
 	void *data;
@@ -185,8 +199,30 @@ extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
 /*
- * TODO: Write some hash table code that will replace obj_list.
+ * Hash table of allocated kernel objects, keyed by object address, for
+ * lookups on every system call validating one.
+ */
+static sys_slist_t obj_hash[CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS];
+
+/*
+ * For each thread index, list of the objects the thread has permission on,
+ * so that clearing or inheriting its permissions does not need to visit
+ * every object. Objects that more threads have permission on than they
+ * have links for are on perm_overflow_list instead, and are visited for
+ * every thread until enough permissions are cleared for all of them to
+ * have a link again.
  */
+static sys_dlist_t thread_perm_lists[MAX_THREAD_BITS];
+static sys_dlist_t perm_overflow_list = SYS_DLIST_STATIC_INIT(&perm_overflow_list);
+static bool thread_perm_lists_inited;
+
+static sys_slist_t *obj_hash_bucket(const void *obj)
+{
+	/* Fibonacci hashing of the address without its alignment bits */
+	uint32_t hash = (uint32_t)(POINTER_TO_UINT(obj) >> 3) * 0x9E3779B1U;
+
+	return &obj_hash[((uint64_t)hash * CONFIG_DYNAMIC_OBJECTS_HASH_BUCKETS) >> 32];
+}
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -227,14 +263,9 @@ static struct dyn_obj *dyn_object_find(const void *obj)
 	struct dyn_obj *node;
 	k_spinlock_key_t key;
 
-	/* For any dynamically allocated kernel object, the object
-	 * pointer is just a member of the containing struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
-	 */
 	key = k_spin_lock(&lists_lock);
 
-	SYS_DLIST_FOR_EACH_CONTAINER(&obj_list, node, dobj_list) {
+	SYS_SLIST_FOR_EACH_CONTAINER(obj_hash_bucket(obj), node, hash_node) {
 		if (node->kobj.name == obj) {
 			goto end;
 		}
@@ -249,6 +280,127 @@ static struct dyn_obj *dyn_object_find(const void *obj)
 	return node;
 }
 
+static void dyn_object_remove(struct dyn_obj *dyn)
+{
+	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+
+	sys_dlist_remove(&dyn->dobj_list);
+	(void)sys_slist_find_and_remove(obj_hash_bucket(dyn->kobj.name),
+					&dyn->hash_node);
+	k_spin_unlock(&lists_lock, key);
+}
+
+/* The permission list functions must be called with obj_lock held */
+
+static sys_dlist_t *thread_perm_list(uintptr_t index)
+{
+	if (unlikely(!thread_perm_lists_inited)) {
+		for (int i = 0; i < MAX_THREAD_BITS; i++) {
+			sys_dlist_init(&thread_perm_lists[i]);
+		}
+		thread_perm_lists_inited = true;
+	}
+
+	return &thread_perm_lists[index];
+}
+
+static struct dyn_obj_perm *dyn_perm_free_link(struct dyn_obj *dyn)
+{
+	for (int i = 0; i < CONFIG_DYNAMIC_OBJECTS_PERM_LINKS; i++) {
+		if (!sys_dnode_is_linked(&dyn->perms[i].node)) {
+			return &dyn->perms[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void dyn_perm_link(struct dyn_obj *dyn, uintptr_t index)
+{
+	struct dyn_obj_perm *link = dyn_perm_free_link(dyn);
+
+	if (link != NULL) {
+		link->index = index;
+		sys_dlist_append(thread_perm_list(index), &link->node);
+		return;
+	}
+
+	/* Out of links */
+	if (!sys_dnode_is_linked(&dyn->overflow_node)) {
+		sys_dlist_append(&perm_overflow_list, &dyn->overflow_node);
+	}
+}
+
+static bool dyn_perm_is_linked(struct dyn_obj *dyn, uintptr_t index)
+{
+	for (int i = 0; i < CONFIG_DYNAMIC_OBJECTS_PERM_LINKS; i++) {
+		struct dyn_obj_perm *link = &dyn->perms[i];
+
+		if (sys_dnode_is_linked(&link->node) && (link->index == index)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Hand the free links of an object on perm_overflow_list to the threads
+ * having permission on it without one, and take it off the list once all
+ * of them have a link.
+ */
+static void dyn_perm_overflow_update(struct dyn_obj *dyn)
+{
+	for (uintptr_t index = 0; index < MAX_THREAD_BITS; index++) {
+		if (!sys_bitfield_test_bit((mem_addr_t)&dyn->kobj.perms, index) ||
+		    dyn_perm_is_linked(dyn, index)) {
+			continue;
+		}
+
+		struct dyn_obj_perm *link = dyn_perm_free_link(dyn);
+
+		if (link == NULL) {
+			/* Still more threads than links */
+			return;
+		}
+
+		link->index = index;
+		sys_dlist_append(thread_perm_list(index), &link->node);
+	}
+
+	sys_dlist_remove(&dyn->overflow_node);
+}
+
+static void dyn_perm_unlink(struct dyn_obj *dyn, uintptr_t index)
+{
+	for (int i = 0; i < CONFIG_DYNAMIC_OBJECTS_PERM_LINKS; i++) {
+		struct dyn_obj_perm *link = &dyn->perms[i];
+
+		if (sys_dnode_is_linked(&link->node) && (link->index == index)) {
+			sys_dlist_remove(&link->node);
+			break;
+		}
+	}
+
+	if (sys_dnode_is_linked(&dyn->overflow_node)) {
+		dyn_perm_overflow_update(dyn);
+	}
+}
+
+static void dyn_perm_unlink_all(struct dyn_obj *dyn)
+{
+	for (int i = 0; i < CONFIG_DYNAMIC_OBJECTS_PERM_LINKS; i++) {
+		if (sys_dnode_is_linked(&dyn->perms[i].node)) {
+			sys_dlist_remove(&dyn->perms[i].node);
+		}
+	}
+
+	if (sys_dnode_is_linked(&dyn->overflow_node)) {
+		sys_dlist_remove(&dyn->overflow_node);
+	}
+}
+
+static void perms_all_clear(uintptr_t index);
+
 /**
  * @internal
  *
@@ -284,8 +436,7 @@ static bool thread_idx_alloc(uintptr_t *tidx)
 			_thread_idx_map[i] &= ~(BIT(idx - 1));
 
 			/* Clear permission from all objects */
-			k_object_wordlist_foreach(clear_perms_cb,
-						   (void *)*tidx);
+			perms_all_clear(*tidx);
 
 			return true;
 		}
@@ -309,7 +460,7 @@ static bool thread_idx_alloc(uintptr_t *tidx)
 static void thread_idx_free(uintptr_t tidx)
 {
 	/* To prevent leaked permission when index is recycled */
-	k_object_wordlist_foreach(clear_perms_cb, (void *)tidx);
+	perms_all_clear(tidx);
 
 	/* Figure out which bits to set in _thread_idx_map[] and set it. */
 	int base = tidx / NUM_BITS(_thread_idx_map[0]);
@@ -371,12 +522,19 @@ static struct k_object *dynamic_object_create(enum k_objects otype, size_t align
 	}
 
 	dyn->kobj.type = otype;
-	dyn->kobj.flags = 0;
+	dyn->kobj.flags = K_OBJ_FLAG_DYNAMIC;
 	(void)memset(dyn->kobj.perms, 0, CONFIG_MAX_THREAD_BYTES);
 
+	for (int i = 0; i < CONFIG_DYNAMIC_OBJECTS_PERM_LINKS; i++) {
+		sys_dnode_init(&dyn->perms[i].node);
+		dyn->perms[i].dyn = dyn;
+	}
+	sys_dnode_init(&dyn->overflow_node);
+
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
 	sys_dlist_append(&obj_list, &dyn->dobj_list);
+	sys_slist_prepend(obj_hash_bucket(dyn->kobj.name), &dyn->hash_node);
 	k_spin_unlock(&lists_lock, key);
 
 	return &dyn->kobj;
@@ -470,7 +628,11 @@ void k_object_free(void *obj)
 
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
-		sys_dlist_remove(&dyn->dobj_list);
+		k_spinlock_key_t obj_key = k_spin_lock(&obj_lock);
+
+		dyn_perm_unlink_all(dyn);
+		dyn_object_remove(dyn);
+		k_spin_unlock(&obj_lock, obj_key);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
@@ -561,16 +723,18 @@ static unsigned int thread_index_get(struct k_thread *thread)
 	return ko->data.thread_id;
 }
 
-static void unref_check(struct k_object *ko, uintptr_t index)
+/* Clear a permission and dispose of the object if it was the last one.
+ * Must be called with obj_lock held.
+ */
+static void perm_clear_locked(struct k_object *ko, uintptr_t index)
 {
-	k_spinlock_key_t key = k_spin_lock(&obj_lock);
-
-	sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
+	bool was_set = sys_bitfield_test_and_clear_bit((mem_addr_t)&ko->perms,
+						       index) != 0;
 
 #ifdef CONFIG_DYNAMIC_OBJECTS
-	if ((ko->flags & K_OBJ_FLAG_ALLOC) == 0U) {
-		/* skip unref check for static kernel object */
-		goto out;
+	if ((ko->flags & K_OBJ_FLAG_DYNAMIC) == 0U) {
+		/* static kernel objects are not tracked */
+		return;
 	}
 
 	void *vko = ko;
@@ -579,9 +743,18 @@ static void unref_check(struct k_object *ko, uintptr_t index)
 
 	__ASSERT(IS_PTR_ALIGNED(dyn, struct dyn_obj), "unaligned z_object");
 
+	if (was_set) {
+		dyn_perm_unlink(dyn, index);
+	}
+
+	if ((ko->flags & K_OBJ_FLAG_ALLOC) == 0U) {
+		/* skip unref check for objects not reference counted */
+		return;
+	}
+
 	for (int i = 0; i < CONFIG_MAX_THREAD_BYTES; i++) {
 		if (ko->perms[i] != 0U) {
-			goto out;
+			return;
 		}
 	}
 
@@ -602,11 +775,36 @@ static void unref_check(struct k_object *ko, uintptr_t index)
 		break;
 	}
 
-	sys_dlist_remove(&dyn->dobj_list);
+	dyn_perm_unlink_all(dyn);
+	dyn_object_remove(dyn);
 	k_free(dyn->data);
 	k_free(dyn);
-out:
+#else
+	ARG_UNUSED(was_set);
 #endif /* CONFIG_DYNAMIC_OBJECTS */
+}
+
+/* Must be called with obj_lock held */
+static void perm_set_locked(struct k_object *ko, uintptr_t index)
+{
+	if (sys_bitfield_test_and_set_bit((mem_addr_t)&ko->perms, index) != 0) {
+		return;
+	}
+
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	if ((ko->flags & K_OBJ_FLAG_DYNAMIC) != 0U) {
+		void *vko = ko;
+
+		dyn_perm_link(CONTAINER_OF(vko, struct dyn_obj, kobj), index);
+	}
+#endif /* CONFIG_DYNAMIC_OBJECTS */
+}
+
+static void unref_check(struct k_object *ko, uintptr_t index)
+{
+	k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+	perm_clear_locked(ko, index);
 	k_spin_unlock(&obj_lock, key);
 }
 
@@ -620,6 +818,51 @@ static void wordlist_cb(struct k_object *ko, void *ctx_ptr)
 	}
 }
 
+#ifdef CONFIG_DYNAMIC_OBJECTS
+static void dyn_perms_inherit(struct perm_ctx *ctx)
+{
+	struct dyn_obj_perm *link;
+	struct dyn_obj *dyn, *next;
+	k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+	/* Only the objects of the parent are visited */
+	SYS_DLIST_FOR_EACH_CONTAINER(thread_perm_list(ctx->parent_id), link, node) {
+		if ((struct k_thread *)link->dyn->kobj.name != ctx->parent) {
+			perm_set_locked(&link->dyn->kobj, ctx->child_id);
+		}
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&perm_overflow_list, dyn, next, overflow_node) {
+		if (sys_bitfield_test_bit((mem_addr_t)&dyn->kobj.perms, ctx->parent_id) &&
+		    ((struct k_thread *)dyn->kobj.name != ctx->parent)) {
+			perm_set_locked(&dyn->kobj, ctx->child_id);
+		}
+	}
+	k_spin_unlock(&obj_lock, key);
+}
+
+static void dyn_perms_all_clear(uintptr_t index)
+{
+	struct dyn_obj *dyn, *next;
+	sys_dnode_t *node;
+	k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+	/* Clearing the permission unlinks the object from the list */
+	while ((node = sys_dlist_peek_head(thread_perm_list(index))) != NULL) {
+		struct dyn_obj_perm *link = CONTAINER_OF(node, struct dyn_obj_perm, node);
+
+		perm_clear_locked(&link->dyn->kobj, index);
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&perm_overflow_list, dyn, next, overflow_node) {
+		if (sys_bitfield_test_bit((mem_addr_t)&dyn->kobj.perms, index)) {
+			perm_clear_locked(&dyn->kobj, index);
+		}
+	}
+	k_spin_unlock(&obj_lock, key);
+}
+#endif /* CONFIG_DYNAMIC_OBJECTS */
+
 void k_thread_perms_inherit(struct k_thread *parent, struct k_thread *child)
 {
 	struct perm_ctx ctx = {
@@ -629,7 +872,12 @@ void k_thread_perms_inherit(struct k_thread *parent, struct k_thread *child)
 	};
 
 	if ((ctx.parent_id != -1) && (ctx.child_id != -1)) {
+#ifdef CONFIG_DYNAMIC_OBJECTS
+		z_object_gperf_wordlist_foreach(wordlist_cb, &ctx);
+		dyn_perms_inherit(&ctx);
+#else
 		k_object_wordlist_foreach(wordlist_cb, &ctx);
+#endif /* CONFIG_DYNAMIC_OBJECTS */
 	}
 }
 
@@ -638,7 +886,10 @@ void k_thread_perms_set(struct k_object *ko, struct k_thread *thread)
 	int index = thread_index_get(thread);
 
 	if (index != -1) {
-		sys_bitfield_set_bit((mem_addr_t)&ko->perms, index);
+		k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+		perm_set_locked(ko, index);
+		k_spin_unlock(&obj_lock, key);
 	}
 }
 
@@ -647,7 +898,6 @@ void k_thread_perms_clear(struct k_object *ko, struct k_thread *thread)
 	int index = thread_index_get(thread);
 
 	if (index != -1) {
-		sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
 		unref_check(ko, index);
 	}
 }
@@ -659,12 +909,22 @@ static void clear_perms_cb(struct k_object *ko, void *ctx_ptr)
 	unref_check(ko, id);
 }
 
+static void perms_all_clear(uintptr_t index)
+{
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	z_object_gperf_wordlist_foreach(clear_perms_cb, (void *)index);
+	dyn_perms_all_clear(index);
+#else
+	k_object_wordlist_foreach(clear_perms_cb, (void *)index);
+#endif /* CONFIG_DYNAMIC_OBJECTS */
+}
+
 void k_thread_perms_all_clear(struct k_thread *thread)
 {
 	uintptr_t index = thread_index_get(thread);
 
 	if ((int)index != -1) {
-		k_object_wordlist_foreach(clear_perms_cb, (void *)index);
+		perms_all_clear(index);
 	}
 }
 
@@ -815,7 +1075,18 @@ void k_object_recycle(const void *obj)
 	struct k_object *ko = k_object_find(obj);
 
 	if (ko != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
+#ifdef CONFIG_DYNAMIC_OBJECTS
+		if ((ko->flags & K_OBJ_FLAG_DYNAMIC) != 0U) {
+			void *vko = ko;
+
+			dyn_perm_unlink_all(CONTAINER_OF(vko, struct dyn_obj, kobj));
+		}
+#endif /* CONFIG_DYNAMIC_OBJECTS */
+		k_spin_unlock(&obj_lock, key);
+
 		k_thread_perms_set(ko, _current);
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
 	}
@@ -176,6 +176,72 @@ int k_work_busy_get(const struct k_work *work)
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+static inline bool queue_is_pool(const struct k_work_q *queue)
+{
+	return queue->workers != NULL;
+}
+
+/* Find the pool worker running a work item.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the worker running @p work, or NULL if it is not running.
+ */
+static struct k_work_q_worker *pool_worker_running(struct k_work_q *queue,
+						   const struct k_work *work)
+{
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (queue->workers[i].work == work) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the pool worker animated by the current thread.
+ *
+ * @return the worker, or NULL if invoked from an ISR or another thread.
+ */
+static struct k_work_q_worker *pool_worker_current(struct k_work_q *queue)
+{
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (_current == &queue->workers[i].thread) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the pending list of a pool that holds a queued work item.
+ *
+ * Invoked with work lock held.
+ */
+static sys_slist_t *pool_list_find(struct k_work_q *queue,
+				   struct k_work *work)
+{
+	sys_snode_t *prev;
+
+	if (sys_slist_find(&queue->pending, &work->node, &prev)) {
+		return &queue->pending;
+	}
+
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (sys_slist_find(&queue->workers[i].pending, &work->node, &prev)) {
+			return &queue->workers[i].pending;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Add a flusher work item to the queue.
  *
  * Invoked with work lock held.
@@ -191,13 +257,32 @@ static void queue_flusher_locked(struct k_work_q *queue,
 				 struct k_work *work,
 				 struct z_work_flusher *flusher)
 {
+	sys_slist_t *pending = &queue->pending;
+
 	init_flusher(flusher);
 
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* The flusher must follow the work item on the list that holds it,
+	 * or run next on the worker that is running it.
+	 */
+	if (queue_is_pool(queue)) {
+		if ((flags_get(&work->flags) & K_WORK_QUEUED) != 0U) {
+			pending = pool_list_find(queue, work);
+		} else {
+			struct k_work_q_worker *owner = pool_worker_running(queue, work);
+
+			__ASSERT_NO_MSG(owner != NULL);
+			pending = &owner->pending;
+		}
+		__ASSERT_NO_MSG(pending != NULL);
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 	if ((flags_get(&work->flags) & K_WORK_QUEUED) != 0U) {
-		sys_slist_insert(&queue->pending, &work->node,
+		sys_slist_insert(pending, &work->node,
 				 &flusher->work.node);
 	} else {
-		sys_slist_prepend(&queue->pending, &flusher->work.node);
+		sys_slist_prepend(pending, &flusher->work.node);
 	}
 }
 
@@ -212,8 +297,43 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
-		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+		if (sys_slist_find_and_remove(&queue->pending, &work->node)) {
+			return;
+		}
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (queue_is_pool(queue)) {
+			for (size_t i = 0; i < queue->num_workers; i++) {
+				if (sys_slist_find_and_remove(&queue->workers[i].pending,
+							      &work->node)) {
+					return;
+				}
+			}
+		}
+#endif /* CONFIG_WORKQUEUE_POOL */
+	}
+}
+
+/* Test whether a queue holds work that has not been started.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_has_pending_locked(struct k_work_q *queue)
+{
+	if (!sys_slist_is_empty(&queue->pending)) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue_is_pool(queue)) {
+		for (size_t i = 0; i < queue->num_workers; i++) {
+			if (!sys_slist_is_empty(&queue->workers[i].pending)) {
+				return true;
+			}
+		}
 	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	return false;
 }
 
 /* Potentially notify a queue that it needs to look for pending work.
@@ -265,10 +385,31 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret;
+	sys_slist_t *pending = &queue->pending;
 	bool chained = (_current == queue->thread_id) && !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* A pool keeps work on the worker that runs it, to prevent handler
+	 * re-entrancy, and chained work on the worker that submits it.
+	 * Anything else goes to the shared list.
+	 */
+	if (queue_is_pool(queue)) {
+		struct k_work_q_worker *self = pool_worker_current(queue);
+		struct k_work_q_worker *owner = pool_worker_running(queue, work);
+
+		chained = (self != NULL);
+		if (owner != NULL) {
+			pending = &owner->pending;
+		} else if (self != NULL) {
+			pending = &self->pending;
+		} else {
+			/* Shared list */
+		}
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 	/* Test for acceptability, in priority order:
 	 *
 	 * * -ENODEV if the queue isn't running.
@@ -283,7 +424,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
-		sys_slist_append(&queue->pending, &work->node);
+		sys_slist_append(pending, &work->node);
 		ret = 1;
 		(void)notify_queue_locked(queue);
 	}
@@ -768,6 +909,186 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	}
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Take a work item from a pool list, along with the flushers that follow
+ * it.  The flushers are moved to the head of the taking worker's list so
+ * that they complete only after the item does.
+ *
+ * Invoked with work lock held.
+ *
+ * @param worker the worker taking the item
+ * @param list the list holding the item
+ * @param prev the node preceding the item on @p list, or NULL
+ * @param node the node of the item
+ */
+static struct k_work *pool_take_locked(struct k_work_q_worker *worker,
+				       sys_slist_t *list,
+				       sys_snode_t *prev,
+				       sys_snode_t *node)
+{
+	sys_slist_t flushers;
+	sys_snode_t *next;
+
+	sys_slist_remove(list, prev, node);
+
+	if (list == &worker->pending) {
+		return CONTAINER_OF(node, struct k_work, node);
+	}
+
+	sys_slist_init(&flushers);
+	while (true) {
+		next = (prev != NULL) ? sys_slist_peek_next(prev)
+				      : sys_slist_peek_head(list);
+		if ((next == NULL)
+		    || !flag_test(&CONTAINER_OF(next, struct k_work, node)->flags,
+				  K_WORK_FLUSHING_BIT)) {
+			break;
+		}
+		sys_slist_remove(list, prev, next);
+		sys_slist_append(&flushers, next);
+	}
+
+	if (!sys_slist_is_empty(&flushers)) {
+		sys_slist_merge_slist(&flushers, &worker->pending);
+		worker->pending = flushers;
+	}
+
+	return CONTAINER_OF(node, struct k_work, node);
+}
+
+/* Find work for a pool worker: its own list first, then the shared list,
+ * then the lists of the other workers.  Stealing skips items that are
+ * running, which must stay on their worker, and flushers, which wait for
+ * the worker they were queued on.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the work item to run, or NULL if there is none.
+ */
+static struct k_work *pool_next_locked(struct k_work_q *queue,
+				       struct k_work_q_worker *worker)
+{
+	size_t self = worker - queue->workers;
+	sys_snode_t *node;
+
+	node = sys_slist_peek_head(&worker->pending);
+	if (node != NULL) {
+		return pool_take_locked(worker, &worker->pending, NULL, node);
+	}
+
+	node = sys_slist_peek_head(&queue->pending);
+	if (node != NULL) {
+		return pool_take_locked(worker, &queue->pending, NULL, node);
+	}
+
+	for (size_t i = 1; i < queue->num_workers; i++) {
+		sys_slist_t *list = &queue->workers[(self + i) % queue->num_workers].pending;
+		sys_snode_t *prev = NULL;
+
+		SYS_SLIST_FOR_EACH_NODE(list, node) {
+			struct k_work *work = CONTAINER_OF(node, struct k_work, node);
+
+			if ((flags_get(&work->flags)
+			     & (K_WORK_RUNNING | K_WORK_FLUSHING)) == 0U) {
+				return pool_take_locked(worker, list, prev, node);
+			}
+			prev = node;
+		}
+	}
+
+	return NULL;
+}
+
+/* Loop executed by a work queue pool thread.
+ *
+ * This follows work_queue_main(), with the queue state shared between
+ * the workers: the queue is busy while any worker runs an item, and
+ * stops once every worker has exited.
+ *
+ * @param worker_ptr pointer to the worker structure
+ */
+static void work_pool_main(void *worker_ptr, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct k_work_q_worker *worker = (struct k_work_q_worker *)worker_ptr;
+	struct k_work_q *queue = worker->queue;
+
+	while (true) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		struct k_work *work = pool_next_locked(queue, worker);
+		k_work_handler_t handler = NULL;
+		bool yield;
+
+		if (work != NULL) {
+			queue->num_busy++;
+			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			flag_set(&work->flags, K_WORK_RUNNING_BIT);
+			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+			worker->work = work;
+			handler = work->handler;
+		} else if ((queue->num_busy == 0U)
+			   && flag_test_and_clear(&queue->flags,
+						  K_WORK_QUEUE_DRAIN_BIT)) {
+			/* No worker is busy and nothing is pending, so the
+			 * queue is drained.
+			 */
+			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
+		} else if (flag_test(&queue->flags, K_WORK_QUEUE_STOP_BIT)) {
+			/* Pass the stop request on to the idle workers.  The
+			 * last worker to exit clears the status flags.
+			 */
+			(void)z_sched_wake_all(&queue->notifyq, 0, NULL);
+			queue->num_live--;
+			if (queue->num_live == 0U) {
+				flags_set(&queue->flags, 0);
+			}
+			k_spin_unlock(&lock, key);
+			return;
+		} else {
+			/* No work is available and no queue state requires
+			 * special handling.
+			 */
+			;
+		}
+
+		if (work == NULL) {
+			(void)z_sched_wait(&lock, key, &queue->notifyq,
+					   K_FOREVER, NULL);
+			continue;
+		}
+
+		k_spin_unlock(&lock, key);
+
+		__ASSERT_NO_MSG(handler != NULL);
+		handler(work);
+
+		key = k_spin_lock(&lock);
+
+		worker->work = NULL;
+		flag_clear(&work->flags, K_WORK_RUNNING_BIT);
+		if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+			finalize_flush_locked(work);
+		}
+		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
+			finalize_cancel_locked(work);
+		}
+
+		queue->num_busy--;
+		if (queue->num_busy == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
+		k_spin_unlock(&lock, key);
+
+		if (yield) {
+			k_yield();
+		}
+	}
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 void k_work_queue_init(struct k_work_q *queue)
 {
 	__ASSERT_NO_MSG(queue != NULL);
@@ -804,6 +1125,9 @@ void k_work_queue_run(struct k_work_q *queue, const struct k_work_queue_config *
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_POOL
+	queue->workers = NULL;
+#endif /* CONFIG_WORKQUEUE_POOL */
 	queue->thread_id = _current;
 	flags_set(&queue->flags, flags);
 	work_queue_main(queue, NULL, NULL);
@@ -826,6 +1150,9 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_POOL
+	queue->workers = NULL;
+#endif /* CONFIG_WORKQUEUE_POOL */
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -863,6 +1190,71 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_queue_pool_start(struct k_work_q *queue,
+			     struct k_work_q_worker *workers,
+			     k_thread_stack_t *stacks,
+			     size_t num_workers,
+			     size_t stack_size,
+			     int prio,
+			     const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(workers);
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG(num_workers > 0);
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	uint32_t flags = K_WORK_QUEUE_STARTED;
+	uintptr_t stride = K_THREAD_STACK_LEN(stack_size);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	sys_slist_init(&queue->pending);
+	z_waitq_init(&queue->notifyq);
+	z_waitq_init(&queue->drainq);
+	queue->workers = workers;
+	queue->num_workers = num_workers;
+	queue->num_busy = 0;
+	queue->num_live = num_workers;
+
+	if ((cfg != NULL) && cfg->no_yield) {
+		flags |= K_WORK_QUEUE_NO_YIELD;
+	}
+
+	flags_set(&queue->flags, flags);
+
+	for (size_t i = 0; i < num_workers; i++) {
+		struct k_work_q_worker *worker = &workers[i];
+
+		worker->queue = queue;
+		worker->work = NULL;
+		sys_slist_init(&worker->pending);
+
+		(void)k_thread_create(&worker->thread,
+				      (k_thread_stack_t *)((uint8_t *)stacks + (stride * i)),
+				      stack_size, work_pool_main, worker, NULL, NULL,
+				      prio, 0, K_FOREVER);
+
+		if ((cfg != NULL) && (cfg->name != NULL)) {
+			k_thread_name_set(&worker->thread, cfg->name);
+		}
+
+		if ((cfg != NULL) && (cfg->essential)) {
+			worker->thread.base.user_options |= K_ESSENTIAL;
+		}
+	}
+
+	queue->thread_id = &workers[0].thread;
+
+	for (size_t i = 0; i < num_workers; i++) {
+		k_thread_start(&workers[i].thread);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -877,7 +1269,7 @@ int k_work_queue_drain(struct k_work_q *queue,
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
 	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	    || queue_has_pending_locked(queue)) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -915,13 +1307,48 @@ int k_work_queue_unplug(struct k_work_q *queue)
 	return ret;
 }
 
+/* Wait for the thread or threads animating a queue to exit.
+ *
+ * On timeout the STOP flag is cleared and the workers of a pool that
+ * have not exited yet keep serving the queue.
+ */
+static int work_queue_join(struct k_work_q *queue, k_timeout_t timeout)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue_is_pool(queue)) {
+		k_timepoint_t end = sys_timepoint_calc(timeout);
+
+		for (size_t i = 0; i < queue->num_workers; i++) {
+			int ret = k_thread_join(&queue->workers[i].thread,
+						sys_timepoint_timeout(end));
+
+			if (ret != 0) {
+				return ret;
+			}
+		}
+
+		return 0;
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	return k_thread_join(queue->thread_id, timeout);
+}
+
 int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 {
 	__ASSERT_NO_MSG(queue);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, stop, queue, timeout);
 
-	if (z_is_thread_essential(&queue->thread)) {
+	struct k_thread *thread = &queue->thread;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue_is_pool(queue)) {
+		thread = &queue->workers[0].thread;
+	}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+	if (z_is_thread_essential(thread)) {
 		return -ENOTSUP;
 	}
 
@@ -943,7 +1370,7 @@ int k_work_queue_stop(struct k_work_q *queue, k_timeout_t timeout)
 	notify_queue_locked(queue);
 	k_spin_unlock(&lock, key);
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_work_queue, stop, queue, timeout);
-	if (k_thread_join(queue->thread_id, timeout)) {
+	if (work_queue_join(queue, timeout)) {
 		key = k_spin_lock(&lock);
 		flag_clear(&queue->flags, K_WORK_QUEUE_STOP_BIT);
 		k_spin_unlock(&lock, key);
@@ -1057,7 +1484,11 @@ static int schedule_for_queue_locked(struct k_work_q **queuep,
 	dwork->queue = *queuep;
 
 	/* Add timeout */
+#ifdef CONFIG_TIMEOUT_SLACK
+	z_add_timeout_slack(&dwork->timeout, work_timeout, delay, dwork->slack);
+#else
 	z_add_timeout(&dwork->timeout, work_timeout, delay);
+#endif /* CONFIG_TIMEOUT_SLACK */
 
 	return ret;
 }
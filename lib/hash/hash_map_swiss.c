@@ -0,0 +1,448 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Swiss Table Hashmap
+ *
+ * The allocation holds an array of control bytes, one per entry, followed by
+ * the array of entries. A control byte is either EMPTY, DELETED, or holds the
+ * low 7 bits of the hash of the key of its entry (h2). The remaining bits of
+ * the hash (h1) select the group of control bytes where probing starts.
+ * Groups are aligned and probed in triangular order, which visits every group
+ * since their number is a power of two.
+ *
+ * Looking up a key compares the control bytes of a group with its h2 at once
+ * and only reads the entries that match, until a group with an EMPTY control
+ * byte ends the probe. A removed entry can thus be made EMPTY again unless its
+ * group is full, in which case it is marked DELETED (a tombstone).
+ *
+ * Tables smaller than a group are padded with EMPTY control bytes that never
+ * get used.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_swiss.h>
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define GROUP_SSE2
+#elif defined(CONFIG_SYS_HASH_MAP_SWISS_SIMD) && defined(__ARM_NEON) && defined(__aarch64__) &&   \
+	(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#include <arm_neon.h>
+#define GROUP_NEON
+#endif
+
+#ifdef GROUP_SSE2
+/* One bit per control byte in a group mask */
+#define GROUP_WIDTH 16
+#define GROUP_SHIFT 0
+#else
+/* The high bit of each control byte in a group mask */
+#define GROUP_WIDTH 8
+#define GROUP_SHIFT 3
+#endif
+
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xfe
+
+#define LSBS 0x0101010101010101ULL
+#define MSBS 0x8080808080808080ULL
+
+#define H1(_hash) ((_hash) >> 7)
+#define H2(_hash) ((uint8_t)((_hash) & 0x7f))
+
+struct swiss_entry {
+	uint64_t key;
+	uint64_t value;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+/* Control bytes equal to h2, possibly with false positives */
+static inline uint64_t group_match(const uint8_t *group, uint8_t h2)
+{
+#if defined(GROUP_SSE2)
+	__m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+
+	return (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+#elif defined(GROUP_NEON)
+	uint8x8_t ctrl = vld1_u8(group);
+
+	return vget_lane_u64(vreinterpret_u64_u8(vceq_u8(ctrl, vdup_n_u8(h2))), 0) & MSBS;
+#else
+	/* A byte following a match may also match if it equals h2 ^ 1 */
+	uint64_t x = sys_get_le64(group) ^ (LSBS * h2);
+
+	return (x - LSBS) & ~x & MSBS;
+#endif
+}
+
+static inline uint64_t group_match_empty(const uint8_t *group)
+{
+#if defined(GROUP_SSE2)
+	__m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+
+	return (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)CTRL_EMPTY)));
+#elif defined(GROUP_NEON)
+	uint8x8_t ctrl = vld1_u8(group);
+
+	return vget_lane_u64(vreinterpret_u64_u8(vceq_u8(ctrl, vdup_n_u8(CTRL_EMPTY))), 0) & MSBS;
+#else
+	/* High bit set and bit 1 clear */
+	uint64_t ctrl = sys_get_le64(group);
+
+	return ctrl & (~ctrl << 6) & MSBS;
+#endif
+}
+
+/* EMPTY or DELETED control bytes, the only ones with their high bit set */
+static inline uint64_t group_match_free(const uint8_t *group)
+{
+#if defined(GROUP_SSE2)
+	return (uint16_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+	return sys_get_le64(group) & MSBS;
+#endif
+}
+
+static inline size_t group_mask_index(uint64_t mask)
+{
+	return (size_t)__builtin_ctzll(mask) >> GROUP_SHIFT;
+}
+
+static inline size_t sys_hashmap_swiss_n_ctrl(size_t n_buckets)
+{
+	return (n_buckets == 0) ? 0 : MAX(n_buckets, GROUP_WIDTH);
+}
+
+static inline uint8_t *sys_hashmap_swiss_ctrl(const struct sys_hashmap *map)
+{
+	return map->data->buckets;
+}
+
+static inline struct swiss_entry *sys_hashmap_swiss_entries(const struct sys_hashmap *map)
+{
+	return (struct swiss_entry *)((uint8_t *)map->data->buckets +
+				      sys_hashmap_swiss_n_ctrl(map->data->n_buckets));
+}
+
+static struct swiss_entry *sys_hashmap_swiss_find(const struct sys_hashmap *map, uint64_t key,
+						  uint32_t hash)
+{
+	const size_t n_groups = sys_hashmap_swiss_n_ctrl(map->data->n_buckets) / GROUP_WIDTH;
+	const uint8_t *const ctrl = sys_hashmap_swiss_ctrl(map);
+	struct swiss_entry *entries;
+	const uint8_t h2 = H2(hash);
+	size_t g = H1(hash);
+	uint64_t mask;
+	size_t j;
+
+	if (map->data->n_buckets == 0) {
+		return NULL;
+	}
+
+	entries = sys_hashmap_swiss_entries(map);
+
+	for (size_t i = 0; i < n_groups; ++i) {
+		g &= (n_groups - 1);
+
+		for (mask = group_match(&ctrl[g * GROUP_WIDTH], h2); mask != 0;
+		     mask &= mask - 1) {
+			j = g * GROUP_WIDTH + group_mask_index(mask);
+			__ASSERT_NO_MSG(j < map->data->n_buckets);
+
+			if (entries[j].key == key) {
+				return &entries[j];
+			}
+		}
+
+		if (group_match_empty(&ctrl[g * GROUP_WIDTH]) != 0) {
+			break;
+		}
+
+		g += i + 1;
+	}
+
+	return NULL;
+}
+
+static size_t sys_hashmap_swiss_find_free(const struct sys_hashmap *map, uint32_t hash)
+{
+	const size_t n_buckets = map->data->n_buckets;
+	const size_t n_groups = sys_hashmap_swiss_n_ctrl(n_buckets) / GROUP_WIDTH;
+	const uint8_t *const ctrl = sys_hashmap_swiss_ctrl(map);
+	uint64_t valid = UINT64_MAX;
+	size_t g = H1(hash);
+	uint64_t mask;
+
+	/* Never use the padding of a table smaller than a group */
+	if (n_buckets < GROUP_WIDTH) {
+		valid = BIT64(n_buckets << GROUP_SHIFT) - 1;
+	}
+
+	for (size_t i = 0; i < n_groups; ++i) {
+		g &= (n_groups - 1);
+
+		mask = group_match_free(&ctrl[g * GROUP_WIDTH]) & valid;
+		if (mask != 0) {
+			return g * GROUP_WIDTH + group_mask_index(mask);
+		}
+
+		g += i + 1;
+	}
+
+	__ASSERT(false, "No free entry left");
+
+	return n_buckets;
+}
+
+static void sys_hashmap_swiss_place(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint32_t hash)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	uint8_t *const ctrl = sys_hashmap_swiss_ctrl(map);
+	size_t j = sys_hashmap_swiss_find_free(map, hash);
+
+	if (ctrl[j] == CTRL_DELETED) {
+		--data->n_tombstones;
+	}
+
+	ctrl[j] = H2(hash);
+	sys_hashmap_swiss_entries(map)[j] = (struct swiss_entry){
+		.key = key,
+		.value = value,
+	};
+	++data->size;
+}
+
+static int sys_hashmap_swiss_rehash(struct sys_hashmap *map, bool grow)
+{
+	size_t old_size;
+	size_t old_n_buckets;
+	size_t new_n_buckets = 0;
+	size_t new_n_ctrl;
+	uint8_t *old_ctrl;
+	uint8_t *new_buckets;
+	struct swiss_entry *old_entries;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+
+	if (!sys_hashmap_should_rehash(map, grow, data->n_tombstones, &new_n_buckets)) {
+		return 0;
+	}
+
+	if (map->data->size != SIZE_MAX && map->data->size == map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	/* only tombstones are in the way, drop them without growing */
+	if (grow && data->n_buckets != 0 &&
+	    (data->size + 1) * 100 / data->n_buckets <= map->config->load_factor) {
+		new_n_buckets = data->n_buckets;
+	}
+
+	old_size = data->size;
+	old_n_buckets = data->n_buckets;
+	old_ctrl = data->buckets;
+	old_entries = (old_ctrl != NULL) ? sys_hashmap_swiss_entries(map) : NULL;
+
+	new_n_ctrl = sys_hashmap_swiss_n_ctrl(new_n_buckets);
+	new_buckets = map->alloc_func(NULL, new_n_ctrl + new_n_buckets * sizeof(struct swiss_entry));
+	if (new_buckets == NULL && new_n_buckets != 0) {
+		return -ENOMEM;
+	}
+
+	if (new_buckets != NULL) {
+		memset(new_buckets, CTRL_EMPTY, new_n_ctrl);
+	}
+
+	data->size = 0;
+	data->n_tombstones = 0;
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+
+	/* re-insert all entries into the hashmap */
+	for (size_t i = 0, j = 0; i < old_n_buckets && j < old_size; ++i) {
+		if ((old_ctrl[i] & CTRL_EMPTY) == 0) {
+			sys_hashmap_swiss_place(map, old_entries[i].key, old_entries[i].value,
+						map->hash_func(&old_entries[i].key,
+							       sizeof(old_entries[i].key)));
+			++j;
+		}
+	}
+
+	/* free the old Hashmap */
+	map->alloc_func(old_ctrl, 0);
+
+	return 0;
+}
+
+static void sys_hashmap_swiss_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	uint8_t *const ctrl = sys_hashmap_swiss_ctrl(map);
+	struct swiss_entry *const entries = sys_hashmap_swiss_entries(map);
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = ctrl;
+	}
+
+	i = (uint8_t *)it->state - ctrl;
+	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < map->data->n_buckets; ++i) {
+		if ((ctrl[i] & CTRL_EMPTY) == 0) {
+			it->state = &ctrl[i + 1];
+			it->key = entries[i].key;
+			it->value = entries[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Swiss Table Hashmap API
+ */
+
+static void sys_hashmap_swiss_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_swiss_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_swiss_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+
+	if (cb != NULL && data->buckets != NULL) {
+		const uint8_t *const ctrl = sys_hashmap_swiss_ctrl(map);
+		const struct swiss_entry *const entries = sys_hashmap_swiss_entries(map);
+
+		for (size_t i = 0, j = 0; i < data->n_buckets && j < data->size; ++i) {
+			if ((ctrl[i] & CTRL_EMPTY) == 0) {
+				cb(entries[i].key, entries[i].value, cookie);
+				++j;
+			}
+		}
+	}
+
+	if (data->buckets != NULL) {
+		map->alloc_func(data->buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+	data->n_tombstones = 0;
+}
+
+static int sys_hashmap_swiss_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	int ret;
+	uint32_t hash;
+	struct swiss_entry *entry;
+
+	ret = sys_hashmap_swiss_rehash(map, true);
+	if (ret < 0) {
+		return ret;
+	}
+
+	hash = map->hash_func(&key, sizeof(key));
+
+	entry = sys_hashmap_swiss_find(map, key, hash);
+	if (entry != NULL) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+		entry->value = value;
+		return 0;
+	}
+
+	sys_hashmap_swiss_place(map, key, value, hash);
+
+	return 1;
+}
+
+static bool sys_hashmap_swiss_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	size_t j;
+	uint8_t *ctrl;
+	struct swiss_entry *entry;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+
+	entry = sys_hashmap_swiss_find(map, key, map->hash_func(&key, sizeof(key)));
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	ctrl = sys_hashmap_swiss_ctrl(map);
+	j = entry - sys_hashmap_swiss_entries(map);
+
+	/* probes do not go past a group with an EMPTY control byte */
+	if (group_match_empty(&ctrl[j & ~(size_t)(GROUP_WIDTH - 1)]) != 0) {
+		ctrl[j] = CTRL_EMPTY;
+	} else {
+		ctrl[j] = CTRL_DELETED;
+		++data->n_tombstones;
+	}
+	--data->size;
+
+	/* ignore a possible -ENOMEM since the table will remain intact */
+	(void)sys_hashmap_swiss_rehash(map, false);
+
+	return true;
+}
+
+static bool sys_hashmap_swiss_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct swiss_entry *entry;
+
+	entry = sys_hashmap_swiss_find(map, key, map->hash_func(&key, sizeof(key)));
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_swiss_api = {
+	.iter = sys_hashmap_swiss_iter,
+	.clear = sys_hashmap_swiss_clear,
+	.insert = sys_hashmap_swiss_insert,
+	.remove = sys_hashmap_swiss_remove,
+	.get = sys_hashmap_swiss_get,
+};
@@ -148,6 +148,108 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Take a freed chunk of exactly sz chunk units from the size-class cache.
+ * Returns 0 if the size is not cached or its list is empty.
+ */
+static chunkid_t cache_get(struct z_heap *h, chunksz_t sz)
+{
+	chunkid_t c;
+
+	if (sz > HEAP_CACHE_CLASSES) {
+		return 0;
+	}
+
+	c = h->cache[sz - 1U];
+	if (c == 0U) {
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+		h->cache_misses++;
+#endif
+		return 0;
+	}
+
+	h->cache[sz - 1U] = next_free_chunk(h, c);
+	h->cache_count[sz - 1U]--;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->cache_hits++;
+	h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+
+	return c;
+}
+
+/* Park a chunk that is being freed in its size-class list, leaving it
+ * marked used so that it is neither merged nor split. Returns false if
+ * the chunk has to go back to the heap instead.
+ */
+static bool cache_put(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+
+	if ((sz > HEAP_CACHE_CLASSES) ||
+	    (h->cache_count[sz - 1U] >= CONFIG_SYS_HEAP_CACHE_DEPTH)) {
+		return false;
+	}
+
+	set_next_free_chunk(h, c, h->cache[sz - 1U]);
+	h->cache[sz - 1U] = c;
+	h->cache_count[sz - 1U]++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, sz);
+#endif
+
+	return true;
+}
+
+#if __ASSERT_ON
+/* Whether c is in its size-class list already, i.e. is freed twice.
+ * Bounded by CONFIG_SYS_HEAP_CACHE_DEPTH.
+ */
+static bool cache_contains(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+
+	if (sz > HEAP_CACHE_CLASSES) {
+		return false;
+	}
+
+	for (chunkid_t n = h->cache[sz - 1U]; n != 0U; n = next_free_chunk(h, n)) {
+		if (n == c) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif /* __ASSERT_ON */
+
+/* Return every cached chunk to the heap. Returns false if there were none */
+static bool cache_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < HEAP_CACHE_CLASSES; i++) {
+		while (h->cache[i] != 0U) {
+			chunkid_t c = h->cache[i];
+
+			h->cache[i] = next_free_chunk(h, c);
+			set_chunk_used(h, c, false);
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+			/* free_chunk() accounts for it again */
+			h->free_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+			free_chunk(h, c);
+			flushed = true;
+		}
+		h->cache_count[i] = 0U;
+	}
+
+	return flushed;
+}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -175,6 +277,12 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 	__ASSERT(chunk_used(h, c),
 		 "unexpected heap state (double-free?) for memory at %p", mem);
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Cached chunks are still marked used */
+	__ASSERT(!cache_contains(h, c),
+		 "unexpected heap state (double-free?) for memory at %p", mem);
+#endif
+
 	/*
 	 * It is easy to catch many common memory overflow cases with
 	 * a quick check on this and next chunk header fields that are
@@ -184,7 +292,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,6 +301,13 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	if (cache_put(h, c)) {
+		return;
+	}
+#endif
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -257,6 +371,13 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 		return c;
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Last resort: give the cached chunks back and try again */
+	if (cache_flush(h)) {
+		return alloc_chunk(h, sz);
+	}
+#endif
+
 	return 0;
 }
 
@@ -270,19 +391,27 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes, 0);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = 0;
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* A cached chunk has the exact size and is still marked used */
+	c = cache_get(h, chunk_sz);
+#endif
 
 	if (c == 0U) {
-		return NULL;
-	}
+		c = alloc_chunk(h, chunk_sz);
+		if (c == 0U) {
+			return NULL;
+		}
 
-	/* Split off remainder if any */
-	if (chunk_size(h, c) > chunk_sz) {
-		split_chunks(h, c, c + chunk_sz);
-		free_list_add(h, c + chunk_sz);
-	}
+		/* Split off remainder if any */
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
 
-	set_chunk_used(h, c, true);
+		set_chunk_used(h, c, true);
+	}
 
 	mem = chunk_mem(h, c);
 
@@ -557,6 +686,17 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	for (int i = 0; i < HEAP_CACHE_CLASSES; i++) {
+		h->cache[i] = 0;
+		h->cache_count[i] = 0;
+	}
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->cache_hits = 0;
+	h->cache_misses = 0;
+#endif
+#endif
+
 #if CONFIG_SYS_HEAP_ARRAY_SIZE
 	sys_heap_array_save(heap);
 #endif
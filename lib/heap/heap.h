@@ -65,6 +65,14 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* One size class per chunk size, from 1 up to the size of the largest
+ * cacheable allocation with a big chunk header.
+ */
+#define HEAP_CACHE_CLASSES \
+	((CONFIG_SYS_HEAP_CACHE_MAX_BYTES + 8U + CHUNK_UNIT - 1U) / CHUNK_UNIT)
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +81,17 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Singly linked lists of freed chunks, still marked used, linked
+	 * through their FREE_NEXT field.
+	 */
+	chunkid_t cache[HEAP_CACHE_CLASSES];
+	uint8_t cache_count[HEAP_CACHE_CLASSES];
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	size_t cache_hits;
+	size_t cache_misses;
+#endif
 #endif
 	struct z_heap_bucket buckets[];
 };
@@ -279,6 +298,16 @@ static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Cached chunks look used but are free as far as users go */
+	for (int i = 0; i < HEAP_CACHE_CLASSES; i++) {
+		for (c = h->cache[i]; c != 0U; c = next_free_chunk(h, c)) {
+			*alloc_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
+		}
+	}
+#endif
 }
 
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
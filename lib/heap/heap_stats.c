@@ -22,6 +22,21 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
 	return 0;
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+int sys_heap_cache_stats_get(struct sys_heap *heap,
+			     struct sys_heap_cache_stats *stats)
+{
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	stats->hits = heap->heap->cache_hits;
+	stats->misses = heap->heap->cache_misses;
+
+	return 0;
+}
+#endif
+
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 {
 	if (heap == NULL) {
@@ -85,6 +85,21 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Cached chunks stay marked used and must match their size class */
+	for (int i = 0; i < HEAP_CACHE_CLASSES; i++) {
+		uint32_t n = 0;
+
+		for (c = h->cache[i]; c != 0U; n++, c = next_free_chunk(h, c)) {
+			VALIDATE(n < h->cache_count[i]);
+			VALIDATE(in_bounds(h, c));
+			VALIDATE(chunk_used(h, c));
+			VALIDATE(chunk_size(h, c) == (chunksz_t)(i + 1));
+		}
+		VALIDATE(n == h->cache_count[i]);
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
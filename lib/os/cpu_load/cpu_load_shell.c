@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/cpu_load.h>
+
+#define TOP_DEFAULT_COUNT 10
+
+/* Too large for the shell thread stack, and shared by all shell instances */
+static struct cpu_load_window window;
+static K_MUTEX_DEFINE(window_lock);
+
+static int print_top(const struct shell *sh, unsigned long count, unsigned long age)
+{
+	int ret = cpu_load_threads_get(age, &window);
+
+	if (ret == -EAGAIN) {
+		shell_print(sh, "No window recorded yet");
+		return 0;
+	} else if (ret != 0) {
+		shell_error(sh, "Only %d windows are kept",
+			    CONFIG_CPU_LOAD_METRIC_THREADS_HISTORY);
+		return ret;
+	}
+
+	/* Cannot use lld as it's less portable. */
+	shell_print(sh, "Window ending at %" PRId64 " ms, %" PRIu64 " cycles per CPU",
+		    window.end_ms, window.cycles);
+	shell_print(sh, "Sampled %u threads in %u cycles, %u with the thread list locked",
+		    window.num_threads, window.sample_cycles, window.locked_cycles);
+	shell_print(sh, "%-12s %-20s %14s %7s", "Thread", "Name", "Cycles", "Load");
+
+	for (unsigned int i = 0; i < MIN(count, window.num_threads); i++) {
+		const struct cpu_load_thread *entry = &window.threads[i];
+		const char *tname = NULL;
+
+		IF_ENABLED(CONFIG_THREAD_NAME, (tname = entry->name;))
+
+		shell_print(sh, "%-12p %-20s %14" PRIu64 " %3u.%u %%",
+			    (void *)entry->thread,
+			    ((tname != NULL) && (tname[0] != '\0')) ? tname : "NA",
+			    entry->cycles, entry->load / 10U, entry->load % 10U);
+	}
+
+	if (window.untracked != 0U) {
+		shell_warn(sh, "%u threads not tracked, see "
+			   "CONFIG_CPU_LOAD_METRIC_THREADS_MAX", window.untracked);
+	}
+
+	return 0;
+}
+
+static int cmd_cpu_load_top(const struct shell *sh, size_t argc, char **argv)
+{
+	unsigned long count = TOP_DEFAULT_COUNT;
+	unsigned long age = 0;
+	int err = 0;
+	int ret;
+
+	if (argc > 1) {
+		count = shell_strtoul(argv[1], 10, &err);
+	}
+	if ((err == 0) && (argc > 2)) {
+		age = shell_strtoul(argv[2], 10, &err);
+	}
+	if (err != 0) {
+		shell_error(sh, "Invalid argument");
+		return err;
+	}
+
+	(void)k_mutex_lock(&window_lock, K_FOREVER);
+	ret = print_top(sh, count, age);
+	(void)k_mutex_unlock(&window_lock);
+
+	return ret;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_cpu_load,
+	SHELL_CMD_ARG(top, NULL,
+		      "List the threads that used the most CPU time in a window.\n"
+		      "Usage: top [<count> [<age>]], age 0 being the last window",
+		      cmd_cpu_load_top, 1, 2),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(cpu_load, &sub_cpu_load, "CPU load commands", NULL);
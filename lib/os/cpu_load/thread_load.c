@@ -0,0 +1,253 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Per-thread CPU load
+ *
+ * Every CONFIG_CPU_LOAD_METRIC_THREADS_PERIOD milliseconds, a work item on
+ * the system work queue walks the threads and takes the difference between
+ * their runtime statistics and those of the previous sample. Only the
+ * threads and their runtime are copied while the thread list is locked, up
+ * to the size of the tracking table. They are then matched by address with
+ * the threads of the previous sample and sorted into a window, which is
+ * published into a ring of the last CONFIG_CPU_LOAD_METRIC_THREADS_HISTORY
+ * windows.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/cpu_load.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(cpu_load_metric, CONFIG_CPU_LOAD_LOG_LEVEL);
+
+#define NUM_TRACKED CONFIG_CPU_LOAD_METRIC_THREADS_MAX
+#define NUM_WINDOWS CONFIG_CPU_LOAD_METRIC_THREADS_HISTORY
+
+struct thread_track {
+	struct k_thread *thread;
+	/* Runtime of the thread at the last sample */
+	uint64_t cycles;
+};
+
+struct thread_snapshot {
+	struct k_thread *thread;
+	uint64_t cycles;
+#ifdef CONFIG_THREAD_NAME
+	char name[CONFIG_THREAD_MAX_NAME_LEN];
+#endif /* CONFIG_THREAD_NAME */
+};
+
+/* Only touched by the sampling work item */
+static struct thread_track tracks[NUM_TRACKED];
+static struct thread_track tracks_prev[NUM_TRACKED];
+static struct thread_snapshot snapshot[NUM_TRACKED];
+static unsigned int snapshot_count;
+static struct cpu_load_window scratch;
+static uint64_t execution_cycles_prev;
+
+static struct cpu_load_window windows[NUM_WINDOWS];
+static unsigned int windows_next;
+static unsigned int windows_count;
+static struct k_spinlock windows_lock;
+
+static struct k_work_delayable sample_work;
+
+/*
+ * Runs with the thread list locked, which keeps exiting threads from being
+ * reused under it, so it only copies what is needed later.
+ */
+static void snapshot_thread(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	k_thread_runtime_stats_t stats;
+	struct thread_snapshot *snap;
+
+	ARG_UNUSED(user_data);
+
+	if (snapshot_count == NUM_TRACKED) {
+		scratch.untracked++;
+		return;
+	}
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	snap = &snapshot[snapshot_count++];
+	snap->thread = thread;
+	snap->cycles = stats.total_cycles;
+#ifdef CONFIG_THREAD_NAME
+	/* The name is always NUL terminated within the thread */
+	memcpy(snap->name, k_thread_name_get(thread), sizeof(snap->name));
+#endif /* CONFIG_THREAD_NAME */
+}
+
+/* Insert a thread into the scratch window, keeping it sorted */
+static void window_insert(const struct thread_snapshot *snap, uint64_t cycles)
+{
+	struct cpu_load_thread *entry;
+	unsigned int i = scratch.num_threads;
+
+	while ((i > 0) && (scratch.threads[i - 1].cycles < cycles)) {
+		scratch.threads[i] = scratch.threads[i - 1];
+		i--;
+	}
+
+	entry = &scratch.threads[i];
+	entry->thread = snap->thread;
+	entry->cycles = cycles;
+#ifdef CONFIG_THREAD_NAME
+	memcpy(entry->name, snap->name, sizeof(entry->name));
+#endif /* CONFIG_THREAD_NAME */
+
+	scratch.num_threads++;
+}
+
+/*
+ * Match the snapshot with the threads of the previous sample, which then
+ * become those of this one, and build the window. The snapshot never holds
+ * more threads than the table.
+ */
+static void snapshot_process(void)
+{
+	memcpy(tracks_prev, tracks, sizeof(tracks_prev));
+
+	for (unsigned int i = 0; i < snapshot_count; i++) {
+		const struct thread_snapshot *snap = &snapshot[i];
+		uint64_t cycles = snap->cycles;
+
+		for (unsigned int j = 0; j < NUM_TRACKED; j++) {
+			/* The structure may have been reused by a new thread */
+			if ((tracks_prev[j].thread == snap->thread) &&
+			    (snap->cycles >= tracks_prev[j].cycles)) {
+				cycles = snap->cycles - tracks_prev[j].cycles;
+				break;
+			}
+		}
+
+		tracks[i].thread = snap->thread;
+		tracks[i].cycles = snap->cycles;
+
+		window_insert(snap, cycles);
+	}
+
+	/* Forget the threads that are gone */
+	for (unsigned int i = snapshot_count; i < NUM_TRACKED; i++) {
+		tracks[i].thread = NULL;
+	}
+}
+
+static void sample(struct k_work *work)
+{
+	uint32_t start = k_cycle_get_32();
+	k_thread_runtime_stats_t all;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(work);
+
+	scratch.num_threads = 0;
+	scratch.untracked = 0;
+	snapshot_count = 0;
+
+	k_thread_foreach(snapshot_thread, NULL);
+	scratch.locked_cycles = k_cycle_get_32() - start;
+
+	snapshot_process();
+
+	(void)k_thread_runtime_stats_all_get(&all);
+	scratch.cycles = (all.execution_cycles - execution_cycles_prev) / arch_num_cpus();
+	execution_cycles_prev = all.execution_cycles;
+
+	for (unsigned int i = 0; i < scratch.num_threads; i++) {
+		struct cpu_load_thread *entry = &scratch.threads[i];
+
+		if (scratch.cycles == 0) {
+			entry->load = 0;
+		} else {
+			entry->load = (uint16_t)MIN(1000U, (entry->cycles * 1000U) / scratch.cycles);
+		}
+	}
+
+	scratch.end_ms = k_uptime_get();
+	scratch.sample_cycles = k_cycle_get_32() - start;
+
+	key = k_spin_lock(&windows_lock);
+	windows[windows_next] = scratch;
+	windows_next = (windows_next + 1) % NUM_WINDOWS;
+	windows_count = MIN(windows_count + 1, NUM_WINDOWS);
+	k_spin_unlock(&windows_lock, key);
+
+	LOG_DBG("Sampled %u threads in %u cycles, %u with the thread list locked",
+		scratch.num_threads, scratch.sample_cycles, scratch.locked_cycles);
+
+	(void)k_work_schedule(&sample_work, K_MSEC(CONFIG_CPU_LOAD_METRIC_THREADS_PERIOD));
+}
+
+/* Must be called with windows_lock held */
+static struct cpu_load_window *window_get(unsigned int age)
+{
+	if (age >= windows_count) {
+		return NULL;
+	}
+
+	return &windows[(windows_next + NUM_WINDOWS - 1 - age) % NUM_WINDOWS];
+}
+
+int cpu_load_threads_get(unsigned int age, struct cpu_load_window *window)
+{
+	struct cpu_load_window *src;
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if (age >= NUM_WINDOWS) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&windows_lock);
+	src = window_get(age);
+	if (src == NULL) {
+		ret = -EAGAIN;
+	} else {
+		*window = *src;
+	}
+	k_spin_unlock(&windows_lock, key);
+
+	return ret;
+}
+
+int cpu_load_threads_top(unsigned int age, struct cpu_load_thread *top, size_t n)
+{
+	struct cpu_load_window *src;
+	k_spinlock_key_t key;
+	int ret;
+
+	if (age >= NUM_WINDOWS) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&windows_lock);
+	src = window_get(age);
+	if (src == NULL) {
+		ret = -EAGAIN;
+	} else {
+		ret = (int)MIN(n, src->num_threads);
+		memcpy(top, src->threads, ret * sizeof(*top));
+	}
+	k_spin_unlock(&windows_lock, key);
+
+	return ret;
+}
+
+static int thread_load_init(void)
+{
+	k_work_init_delayable(&sample_work, sample);
+	(void)k_work_schedule(&sample_work, K_MSEC(CONFIG_CPU_LOAD_METRIC_THREADS_PERIOD));
+
+	return 0;
+}
+
+SYS_INIT(thread_load_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
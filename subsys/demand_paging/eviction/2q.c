@@ -0,0 +1,250 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Scan resistant 2Q eviction algorithm for demand paging.
+ *
+ * Like LRU, this relies on the MMU reporting accesses to pages that were
+ * made unaccessible, through k_mem_paging_eviction_accessed().
+ *
+ * Theory of Operation:
+ *
+ * - Page frames are kept in one of two queues. The probation queue is a FIFO
+ *   receiving page frames made evictable with k_mem_paging_eviction_add().
+ *   The protected queue is an LRU queue holding page frames that were shown
+ *   to be part of the working set.
+ *
+ * - Accesses to a page frame in the probation queue are ignored, except when
+ *   it sits at the head of the queue. The head page is made unaccessible, so
+ *   if it is still being used it causes a fault and the page frame is moved
+ *   to the protected queue. A data page that was touched only for a short
+ *   while after being paged in, as is typical of a sequential scan, simply
+ *   flows through the probation queue and is evicted first.
+ *
+ * - Accesses to a page frame in the protected queue move it back to the end
+ *   of that queue, and its head page is made unaccessible, exactly as with
+ *   the LRU algorithm.
+ *
+ * - The virtual addresses of the last data pages evicted from the probation
+ *   queue are remembered. A data page paged in again while still remembered
+ *   was evicted too early and goes straight to the protected queue.
+ *
+ * - The probation queue is the eviction victim whenever it holds more than
+ *   CONFIG_EVICTION_2Q_PROBATION_PERCENT of the page frames, or when the
+ *   protected queue is empty. A scan therefore only ever pushes out the
+ *   pages of that share of physical memory, leaving the working set in the
+ *   protected queue alone.
+ *
+ * All operations are O(1) except for the lookup of the remembered addresses
+ * when a page frame is added, which is bounded by
+ * CONFIG_EVICTION_2Q_HISTORY_SIZE and only happens along with a page-in.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/util.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+enum q2_queue {
+	Q2_PROBATION,
+	Q2_PROTECTED,
+	Q2_NUM_QUEUES,
+	Q2_UNQUEUED = Q2_NUM_QUEUES,
+};
+
+/*
+ * As with the LRU algorithm, queues are stored as previous and next page
+ * frame indexes in an array. The first slots are the queue heads, linking
+ * the head and tail of each circular queue (actual page frame indexes are
+ * offset by the number of queues).
+ */
+#define PF_IDX_BITS \
+	ROUND_UP(LOG2CEIL(K_MEM_NUM_PAGE_FRAMES + Q2_NUM_QUEUES), BITS_PER_BYTE)
+
+/* For each page frame, track the previous and next page frame in its queue. */
+struct q2_pf_idx {
+	uint32_t next : PF_IDX_BITS;
+	uint32_t prev : PF_IDX_BITS;
+} __packed;
+
+static struct q2_pf_idx q2_pf_queue[Q2_NUM_QUEUES + K_MEM_NUM_PAGE_FRAMES];
+static uint8_t q2_pf_owner[Q2_NUM_QUEUES + K_MEM_NUM_PAGE_FRAMES];
+static size_t q2_count[Q2_NUM_QUEUES];
+static struct k_spinlock q2_lock;
+
+#define Q2_PROBATION_MAX \
+	MAX(1, (K_MEM_NUM_PAGE_FRAMES * CONFIG_EVICTION_2Q_PROBATION_PERCENT) / 100)
+
+/*
+ * Virtual addresses of the data pages last evicted from the probation queue,
+ * zero meaning an unused entry (the NULL page is never paged).
+ */
+static uintptr_t q2_history[CONFIG_EVICTION_2Q_HISTORY_SIZE];
+static unsigned int q2_history_next;
+
+static inline uint32_t pf_to_idx(struct k_mem_page_frame *pf)
+{
+	return (pf - k_mem_page_frames) + Q2_NUM_QUEUES;
+}
+
+static inline struct k_mem_page_frame *idx_to_pf(uint32_t idx)
+{
+	return &k_mem_page_frames[idx - Q2_NUM_QUEUES];
+}
+
+static inline uint32_t q2_head(enum q2_queue queue)
+{
+	return q2_pf_queue[queue].next;
+}
+
+static inline void q2_pf_append(enum q2_queue queue, uint32_t pf_idx)
+{
+	uint32_t tail = q2_pf_queue[queue].prev;
+
+	q2_pf_queue[pf_idx].next = queue;
+	q2_pf_queue[pf_idx].prev = tail;
+	q2_pf_queue[tail].next = pf_idx;
+	q2_pf_queue[queue].prev = pf_idx;
+
+	q2_pf_owner[pf_idx] = queue;
+	q2_count[queue]++;
+}
+
+static void q2_pf_remove(uint32_t pf_idx)
+{
+	enum q2_queue queue = q2_pf_owner[pf_idx];
+	uint32_t next = q2_pf_queue[pf_idx].next;
+	uint32_t prev = q2_pf_queue[pf_idx].prev;
+	uint32_t head;
+
+	q2_pf_queue[prev].next = next;
+	q2_pf_queue[next].prev = prev;
+
+	q2_pf_owner[pf_idx] = Q2_UNQUEUED;
+	q2_count[queue]--;
+
+	/* make new head PF unaccessible if it exists and it is not alone */
+	head = q2_head(queue);
+	if ((prev == queue) && (head != queue) &&
+	    (q2_pf_queue[head].next != queue)) {
+		struct k_mem_page_frame *pf = idx_to_pf(head);
+		uintptr_t flags = arch_page_info_get(k_mem_page_frame_to_virt(pf), NULL, true);
+
+		/* clearing the accessed flag expected only on loaded pages */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0, "");
+		ARG_UNUSED(flags);
+	}
+}
+
+static void q2_history_add(void *addr)
+{
+	q2_history[q2_history_next] = (uintptr_t)addr;
+	q2_history_next = (q2_history_next + 1) % ARRAY_SIZE(q2_history);
+}
+
+static bool q2_history_take(void *addr)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(q2_history); i++) {
+		if (q2_history[i] == (uintptr_t)addr) {
+			q2_history[i] = 0;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void k_mem_paging_eviction_add(struct k_mem_page_frame *pf)
+{
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&q2_lock);
+
+	__ASSERT(k_mem_page_frame_is_evictable(pf), "");
+	__ASSERT(q2_pf_owner[pf_idx] == Q2_UNQUEUED, "");
+	if (q2_history_take(k_mem_page_frame_to_virt(pf))) {
+		q2_pf_append(Q2_PROTECTED, pf_idx);
+	} else {
+		q2_pf_append(Q2_PROBATION, pf_idx);
+	}
+	k_spin_unlock(&q2_lock, key);
+}
+
+void k_mem_paging_eviction_remove(struct k_mem_page_frame *pf)
+{
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&q2_lock);
+
+	__ASSERT(q2_pf_owner[pf_idx] != Q2_UNQUEUED, "");
+	q2_pf_remove(pf_idx);
+	k_spin_unlock(&q2_lock, key);
+}
+
+void k_mem_paging_eviction_accessed(uintptr_t phys)
+{
+	struct k_mem_page_frame *pf = k_mem_phys_to_page_frame(phys);
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&q2_lock);
+
+	switch (q2_pf_owner[pf_idx]) {
+	case Q2_PROBATION:
+		if (q2_head(Q2_PROBATION) != pf_idx) {
+			/* still within its first use */
+			break;
+		}
+		__fallthrough;
+	case Q2_PROTECTED:
+		q2_pf_remove(pf_idx);
+		q2_pf_append(Q2_PROTECTED, pf_idx);
+		break;
+	default:
+		break;
+	}
+	k_spin_unlock(&q2_lock, key);
+}
+
+struct k_mem_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct k_mem_page_frame *pf = NULL;
+	enum q2_queue queue;
+	uintptr_t flags;
+	void *addr;
+	k_spinlock_key_t key = k_spin_lock(&q2_lock);
+
+	if ((q2_count[Q2_PROBATION] > Q2_PROBATION_MAX) ||
+	    (q2_count[Q2_PROTECTED] == 0)) {
+		queue = Q2_PROBATION;
+	} else {
+		queue = Q2_PROTECTED;
+	}
+
+	if (q2_head(queue) == queue) {
+		goto out;
+	}
+
+	pf = idx_to_pf(q2_head(queue));
+	addr = k_mem_page_frame_to_virt(pf);
+	flags = arch_page_info_get(addr, NULL, false);
+
+	__ASSERT(k_mem_page_frame_is_evictable(pf), "");
+	*dirty_ptr = ((flags & ARCH_DATA_PAGE_DIRTY) != 0);
+
+	if (queue == Q2_PROBATION) {
+		q2_history_add(addr);
+	}
+out:
+	k_spin_unlock(&q2_lock, key);
+	return pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+	for (unsigned int queue = 0; queue < Q2_NUM_QUEUES; queue++) {
+		q2_pf_queue[queue].next = queue;
+		q2_pf_queue[queue].prev = queue;
+	}
+
+	memset(q2_pf_owner, Q2_UNQUEUED, sizeof(q2_pf_owner));
+}
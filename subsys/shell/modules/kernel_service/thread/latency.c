@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "kernel_shell.h"
+
+#include <zephyr/kernel.h>
+
+static void histogram_dump(const struct shell *sh, const uint32_t *histogram)
+{
+	for (unsigned int i = 0; i < CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS; i++) {
+		if (histogram[i] == 0) {
+			continue;
+		}
+
+		if (i == 0) {
+			shell_print(sh, "\t%10u          : %u", 0, histogram[i]);
+		} else if (i == CONFIG_SCHED_THREAD_USAGE_HISTOGRAM_BUCKETS - 1) {
+			shell_print(sh, "\t%10u -        : %u", 1U << (i - 1), histogram[i]);
+		} else {
+			shell_print(sh, "\t%10u - %-7u: %u", 1U << (i - 1),
+				    (uint32_t)((1ULL << i) - 1), histogram[i]);
+		}
+	}
+}
+
+static void shell_latency_dump(const struct k_thread *cthread, void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = (const struct shell *)user_data;
+	k_thread_runtime_stats_t stats;
+	const char *tname;
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(sh, "%s%p %-10s",
+		    (thread == k_current_get()) ? "*" : " ",
+		    thread,
+		    tname ? tname : "NA");
+	histogram_dump(sh, stats.histogram);
+}
+
+static int cmd_kernel_thread_latency(const struct shell *sh, size_t argc, char **argv)
+{
+	k_thread_runtime_stats_t stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(sh, "Scheduling latency (cycles from ready to running):");
+
+	/*
+	 * Use the unlocked version as the callback itself might call
+	 * arch_irq_unlock.
+	 */
+	k_thread_foreach_unlocked(shell_latency_dump, (void *)sh);
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	shell_print(sh, "Run queue depth at context switch:");
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		if (k_thread_runtime_stats_cpu_get(cpu, &stats) != 0) {
+			continue;
+		}
+
+		shell_print(sh, " CPU %u", cpu);
+		histogram_dump(sh, stats.histogram);
+	}
+#else
+	ARG_UNUSED(stats);
+#endif /* CONFIG_SCHED_THREAD_USAGE_ALL */
+
+	return 0;
+}
+
+KERNEL_THREAD_CMD_ADD(latency, NULL, "Show scheduling latency histograms.",
+		      cmd_kernel_thread_latency);
@@ -0,0 +1,67 @@
+/* fifo_b.c */
+
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+struct queue_item {
+	void *reserved; /* first word reserved for use by the queue */
+	int value;
+};
+
+static struct queue_item items[NR_OF_FIFO_RUNS];
+
+/**
+ * @brief FIFO and LIFO put/get speed test
+ */
+void fifo_test(void)
+{
+	uint32_t et; /* elapsed time */
+	int i;
+	timing_t  start;
+	timing_t  end;
+
+	PRINT_STRING(dashline);
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_put(&DEMOFIFO, &items[i]);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "put item in FIFO",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_fifo_get(&DEMOFIFO, K_NO_WAIT);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "get item from FIFO",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_lifo_put(&DEMOLIFO, &items[i]);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "put item in LIFO",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_lifo_get(&DEMOLIFO, K_NO_WAIT);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "get item from LIFO",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+}
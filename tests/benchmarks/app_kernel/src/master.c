@@ -74,6 +74,10 @@ K_PIPE_DEFINE(PIPE_NOBUFF, 0, 4);
 K_PIPE_DEFINE(PIPE_SMALLBUFF, 256, 4);
 K_PIPE_DEFINE(PIPE_BIGBUFF, 4096, 4);
 
+K_STACK_DEFINE(DEMOSTACK, NR_OF_STACK_RUNS);
+K_FIFO_DEFINE(DEMOFIFO);
+K_LIFO_DEFINE(DEMOLIFO);
+
 /*
  * Custom syscalls
  */
@@ -107,7 +111,7 @@ static timing_t z_vrfy_timing_timestamp_get(void)
  */
 static void test_thread_entry(void *p1, void *p2, void *p3)
 {
-	bool skip_mem_and_mbox = (bool)(uintptr_t)(p2);
+	bool skip_kernel_only = (bool)(uintptr_t)(p2);
 
 	ARG_UNUSED(p3);
 
@@ -123,8 +127,10 @@ static void test_thread_entry(void *p1, void *p2, void *p3)
 	message_queue_test();
 	sema_test();
 	mutex_test();
+	stack_test();
 
-	if (!skip_mem_and_mbox) {
+	if (!skip_kernel_only) {
+		fifo_test();
 		memorymap_test();
 		mailbox_test();
 	}
@@ -187,7 +193,7 @@ int main(void)
 
 	k_thread_access_grant(&recv_thread, &DEMOQX1, &DEMOQX4, &DEMOQX192,
 			      &MB_COMM, &CH_COMM, &SEM0, &SEM1, &SEM2, &SEM3,
-			      &SEM4, &STARTRCV, &DEMO_MUTEX,
+			      &SEM4, &STARTRCV, &DEMO_MUTEX, &DEMOSTACK,
 			      &PIPE_NOBUFF, &PIPE_SMALLBUFF, &PIPE_BIGBUFF);
 
 	k_thread_start(&recv_thread);
@@ -211,7 +217,7 @@ int main(void)
 
 	k_thread_access_grant(&test_thread, &DEMOQX1, &DEMOQX4, &DEMOQX192,
 			      &MB_COMM, &CH_COMM, &SEM0, &SEM1, &SEM2, &SEM3,
-			      &SEM4, &STARTRCV, &DEMO_MUTEX,
+			      &SEM4, &STARTRCV, &DEMO_MUTEX, &DEMOSTACK,
 			      &PIPE_NOBUFF, &PIPE_SMALLBUFF, &PIPE_BIGBUFF);
 
 	k_thread_start(&recv_thread);
@@ -235,11 +241,11 @@ int main(void)
 
 	k_thread_access_grant(&test_thread, &DEMOQX1, &DEMOQX4, &DEMOQX192,
 			      &MB_COMM, &CH_COMM, &SEM0, &SEM1, &SEM2, &SEM3,
-			      &SEM4, &STARTRCV, &DEMO_MUTEX,
+			      &SEM4, &STARTRCV, &DEMO_MUTEX, &DEMOSTACK,
 			      &PIPE_NOBUFF, &PIPE_SMALLBUFF, &PIPE_BIGBUFF);
 	k_thread_access_grant(&recv_thread, &DEMOQX1, &DEMOQX4, &DEMOQX192,
 			      &MB_COMM, &CH_COMM, &SEM0, &SEM1, &SEM2, &SEM3,
-			      &SEM4, &STARTRCV, &DEMO_MUTEX,
+			      &SEM4, &STARTRCV, &DEMO_MUTEX, &DEMOSTACK,
 			      &PIPE_NOBUFF, &PIPE_SMALLBUFF, &PIPE_BIGBUFF);
 
 	k_thread_start(&recv_thread);
@@ -36,6 +36,8 @@
 #define NR_OF_MAP_RUNS 1000
 #define NR_OF_MBOX_RUNS 128
 #define NR_OF_PIPE_RUNS 256
+#define NR_OF_STACK_RUNS 500
+#define NR_OF_FIFO_RUNS 500
 #define SEMA_WAIT_TIME (5000)
 
 #ifdef CONFIG_USERSPACE
@@ -80,6 +82,8 @@ extern void message_queue_test(void);
 extern void mutex_test(void);
 extern void memorymap_test(void);
 extern void pipe_test(void);
+extern void stack_test(void);
+extern void fifo_test(void);
 
 /* kernel objects needed for benchmarking */
 extern struct k_mutex DEMO_MUTEX;
@@ -106,6 +110,10 @@ extern struct k_pipe PIPE_BIGBUFF;
 
 extern struct k_mem_slab MAP1;
 
+extern struct k_stack DEMOSTACK;
+extern struct k_fifo DEMOFIFO;
+extern struct k_lifo DEMOLIFO;
+
 /* PRINT_STRING
  * Macro to print an ASCII NULL terminated string.
  */
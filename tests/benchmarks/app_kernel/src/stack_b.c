@@ -0,0 +1,41 @@
+/* stack_b.c */
+
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+/**
+ * @brief Stack push/pop speed test
+ */
+void stack_test(void)
+{
+	uint32_t et; /* elapsed time */
+	int i;
+	timing_t  start;
+	timing_t  end;
+	stack_data_t data;
+
+	PRINT_STRING(dashline);
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_STACK_RUNS; i++) {
+		(void)k_stack_push(&DEMOSTACK, (stack_data_t)i);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "push value to stack",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_STACK_RUNS));
+
+	start = timing_timestamp_get();
+	for (i = 0; i < NR_OF_STACK_RUNS; i++) {
+		(void)k_stack_pop(&DEMOSTACK, &data, K_NO_WAIT);
+	}
+	end = timing_timestamp_get();
+	et = (uint32_t)timing_cycles_get(&start, &end);
+
+	PRINT_F(FORMAT, "pop value from stack",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_STACK_RUNS));
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the per-thread CPU load sampling. It
+ * creates a growing number of idle threads and, for each count, measures the
+ * average time a sample takes and the part of it spent with the thread list
+ * locked, as recorded by the sampler itself in each window.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/cpu_load.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+
+#define NUM_THREADS CONFIG_BENCHMARK_NUM_THREADS
+#define THREAD_STEP 8
+#define STACK_SIZE  (256 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_WINDOWS CONFIG_CPU_LOAD_METRIC_THREADS_HISTORY
+#define PERIOD_MS   CONFIG_CPU_LOAD_METRIC_THREADS_PERIOD
+
+BUILD_ASSERT(NUM_THREADS < CONFIG_CPU_LOAD_METRIC_THREADS_MAX,
+	     "the tracking table has to hold the idle threads");
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static void idle_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sleep(K_FOREVER);
+}
+
+static void report(const char *name, const char *description,
+		   uint64_t cycles, unsigned int count)
+{
+	uint64_t avg_cycles = cycles / count;
+	uint64_t avg_ns = k_cyc_to_ns_floor64(cycles) / count;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7llu cycles , %7llu ns :\n", name,
+	       description, (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#else
+	ARG_UNUSED(name);
+
+	printk("%-60s : %7llu cycles , %7llu ns\n", description,
+	       (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int bench_threads(unsigned int extra)
+{
+	struct cpu_load_window window;
+	uint64_t sample_cycles = 0;
+	uint64_t locked_cycles = 0;
+	char name[40];
+	char description[64];
+
+	/* Let the whole history be sampled with this many threads */
+	k_msleep((NUM_WINDOWS + 1) * PERIOD_MS);
+
+	for (unsigned int age = 0; age < NUM_WINDOWS; age++) {
+		if (cpu_load_threads_get(age, &window) != 0) {
+			printk("No window %u with %u extra threads\n", age, extra);
+			return TC_FAIL;
+		}
+
+		if ((window.num_threads < extra) || (window.untracked != 0U)) {
+			printk("Sampled %u threads, %u untracked, with %u extra threads\n",
+			       window.num_threads, window.untracked, extra);
+			return TC_FAIL;
+		}
+
+		sample_cycles += window.sample_cycles;
+		locked_cycles += window.locked_cycles;
+	}
+
+	snprintf(name, sizeof(name), "cpu_load_threads.%u.sample", extra);
+	snprintf(description, sizeof(description), "sample with %u extra threads", extra);
+	report(name, description, sample_cycles, NUM_WINDOWS);
+
+	snprintf(name, sizeof(name), "cpu_load_threads.%u.locked", extra);
+	report(name, "  of which with the thread list locked", locked_cycles, NUM_WINDOWS);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int result = TC_PASS;
+	unsigned int created = 0;
+
+	printk("Thread Load Sampling Measurements (%u ms windows)\n", PERIOD_MS);
+
+	for (unsigned int extra = 0; extra <= NUM_THREADS; extra += THREAD_STEP) {
+		while (created < extra) {
+			k_thread_create(&threads[created], stacks[created], STACK_SIZE,
+					idle_fn, NULL, NULL, NULL,
+					K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_NO_WAIT);
+			created++;
+		}
+
+		if (bench_threads(extra) != TC_PASS) {
+			result = TC_FAIL;
+			break;
+		}
+	}
+
+	for (unsigned int i = 0; i < created; i++) {
+		k_thread_abort(&threads[i]);
+	}
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark that compares demand paging eviction
+ * algorithms. All free page frames but CONFIG_BENCHMARK_PAGE_FRAMES are
+ * locked down, then page access traces are replayed over a region larger
+ * than the remaining physical memory and the page faults they cause are
+ * counted. The same traces are replayed whichever eviction algorithm the
+ * image is built with, so fault rates can be compared across builds.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+#include "traces.h"
+
+#define PAGE_SIZE    CONFIG_MMU_PAGE_SIZE
+#define REGION_SIZE  (TRACE_PAGES * PAGE_SIZE)
+#define FRAMES_SIZE  (CONFIG_BENCHMARK_PAGE_FRAMES * PAGE_SIZE)
+
+#if defined(CONFIG_EVICTION_2Q)
+#define EVICTION_NAME "2Q"
+#elif defined(CONFIG_EVICTION_LRU)
+#define EVICTION_NAME "LRU"
+#elif defined(CONFIG_EVICTION_NRU)
+#define EVICTION_NAME "NRU"
+#else
+#define EVICTION_NAME "custom"
+#endif
+
+static volatile uint8_t *region;
+
+static unsigned long replay(const struct trace *trace)
+{
+	unsigned long accesses = 0;
+
+	for (unsigned int loop = 0; loop < trace->loops; loop++) {
+		for (size_t i = 0; i < trace->num_runs; i++) {
+			const struct trace_run *run = &trace->runs[i];
+
+			for (unsigned int pass = 0; pass < run->passes; pass++) {
+				for (unsigned int page = run->first;
+				     page < (run->first + run->count); page++) {
+					volatile uint8_t *ptr = &region[page * PAGE_SIZE];
+
+					if (run->write) {
+						*ptr = (uint8_t)loop;
+					} else {
+						(void)*ptr;
+					}
+				}
+				accesses += run->count;
+			}
+		}
+	}
+
+	return accesses;
+}
+
+static void report(const struct trace *trace, unsigned long faults,
+		   unsigned long accesses, unsigned long dirty)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char tag[50];
+
+	ARG_UNUSED(dirty);
+
+	snprintf(tag, sizeof(tag), "paging.eviction.%s.%s", EVICTION_NAME,
+		 trace->name);
+	printk("REC: %-40s - %-50s : %7lu faults , %7lu accesses :\n", tag,
+	       trace->description, faults, accesses);
+#else
+	/* Faults per thousand accesses */
+	unsigned long rate = (faults * 1000UL) / accesses;
+
+	printk("------------------------------------\n");
+	printk("%s\n", trace->description);
+	printk("    Page faults: %lu in %lu accesses (%lu.%lu%%)\n",
+	       faults, accesses, rate / 10, rate % 10);
+	printk("    Dirty pages written back: %lu\n", dirty);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int run_trace(const struct trace *trace)
+{
+	struct k_mem_paging_stats_t stats;
+	unsigned long faults;
+	unsigned long dirty;
+	unsigned long accesses;
+	int ret;
+
+	/* Start every trace from a cold region */
+	ret = k_mem_page_out((void *)region, REGION_SIZE);
+	if (ret != 0) {
+		printk("Failed to page out the region: %d\n", ret);
+		return TC_FAIL;
+	}
+
+	k_mem_paging_stats_get(&stats);
+	dirty = stats.eviction.dirty;
+	faults = k_mem_num_pagefaults_get();
+
+	accesses = replay(trace);
+
+	faults = k_mem_num_pagefaults_get() - faults;
+	k_mem_paging_stats_get(&stats);
+	dirty = stats.eviction.dirty - dirty;
+
+	report(trace, faults, accesses, dirty);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	size_t free_size = k_mem_free_get();
+	int result = TC_PASS;
+	void *ballast;
+
+	printk("Demand Paging Eviction Measurements (%s eviction)\n", EVICTION_NAME);
+	printk("%u page frames for a %u page region\n",
+	       CONFIG_BENCHMARK_PAGE_FRAMES, TRACE_PAGES);
+
+	if (free_size < FRAMES_SIZE) {
+		printk("Only %zu bytes of free memory\n", free_size);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	/* Leave exactly the page frames the traces are laid out for */
+	if (free_size > FRAMES_SIZE) {
+		ballast = k_mem_map(free_size - FRAMES_SIZE,
+				    K_MEM_PERM_RW | K_MEM_MAP_LOCK);
+		if (ballast == NULL) {
+			printk("Failed to lock down free memory\n");
+			TC_END_REPORT(TC_FAIL);
+			return 0;
+		}
+	}
+
+	region = k_mem_map(REGION_SIZE, K_MEM_PERM_RW);
+	if (region == NULL) {
+		printk("Failed to map the trace region\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	for (size_t i = 0; i < num_traces; i++) {
+		if (run_trace(&traces[i]) != TC_PASS) {
+			result = TC_FAIL;
+			break;
+		}
+	}
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Page access traces, condensed into runs of consecutive pages. Page
+ * numbers are relative to the start of the replay region and laid out for
+ * the default CONFIG_BENCHMARK_PAGE_FRAMES of 32 page frames.
+ */
+
+#include <zephyr/sys/util.h>
+#include "traces.h"
+
+/*
+ * A logging subsystem: a working set of 16 pages of code and data is used
+ * intensively, then the whole 80 page log buffer is written out in one
+ * sweep while records are formatted into it.
+ */
+static const struct trace_run logging_runs[] = {
+	{ .first = 0, .count = 16, .passes = 4, .write = false },
+	{ .first = 0, .count = 4, .passes = 2, .write = true },
+	{ .first = 16, .count = 80, .passes = 1, .write = true },
+};
+
+/*
+ * A network stack: 12 pages of protocol state are touched for every packet
+ * batch, while packet buffers are taken round-robin from a pool of 40 pages,
+ * more than physical memory can hold along with the protocol state.
+ */
+static const struct trace_run networking_runs[] = {
+	{ .first = 0, .count = 12, .passes = 1, .write = true },
+	{ .first = 16, .count = 10, .passes = 1, .write = true },
+	{ .first = 0, .count = 12, .passes = 1, .write = false },
+	{ .first = 26, .count = 10, .passes = 1, .write = true },
+	{ .first = 0, .count = 12, .passes = 1, .write = true },
+	{ .first = 36, .count = 10, .passes = 1, .write = true },
+	{ .first = 0, .count = 12, .passes = 1, .write = false },
+	{ .first = 46, .count = 10, .passes = 1, .write = true },
+};
+
+/*
+ * An application switching between two modes, each with its own 24 page
+ * working set. Any algorithm has to let go of the first working set for
+ * the second one.
+ */
+static const struct trace_run phase_change_runs[] = {
+	{ .first = 0, .count = 24, .passes = 8, .write = false },
+	{ .first = 64, .count = 24, .passes = 8, .write = true },
+};
+
+/*
+ * A working set that fits in physical memory next to a periodic read-only
+ * scan of the whole region, as done by a checksum or a flash sync task.
+ */
+static const struct trace_run scan_runs[] = {
+	{ .first = 0, .count = 20, .passes = 6, .write = true },
+	{ .first = 0, .count = TRACE_PAGES, .passes = 1, .write = false },
+};
+
+const struct trace traces[] = {
+	{
+		.name = "logging",
+		.description = "Working set with log buffer sweeps",
+		.runs = logging_runs,
+		.num_runs = ARRAY_SIZE(logging_runs),
+		.loops = 20,
+	},
+	{
+		.name = "networking",
+		.description = "Protocol state with buffer pool cycling",
+		.runs = networking_runs,
+		.num_runs = ARRAY_SIZE(networking_runs),
+		.loops = 20,
+	},
+	{
+		.name = "phase_change",
+		.description = "Alternating working sets",
+		.runs = phase_change_runs,
+		.num_runs = ARRAY_SIZE(phase_change_runs),
+		.loops = 10,
+	},
+	{
+		.name = "scan",
+		.description = "Working set with full region scans",
+		.runs = scan_runs,
+		.num_runs = ARRAY_SIZE(scan_runs),
+		.loops = 10,
+	},
+};
+
+const size_t num_traces = ARRAY_SIZE(traces);
@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTS_BENCHMARKS_DEMAND_PAGING_EVICTION_TRACES_H_
+#define ZEPHYR_TESTS_BENCHMARKS_DEMAND_PAGING_EVICTION_TRACES_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/* Number of pages of the region the traces are replayed over */
+#define TRACE_PAGES 128
+
+/*
+ * A run of accesses, one to each of the pages first to first + count - 1
+ * in ascending order, repeated passes times.
+ */
+struct trace_run {
+	uint16_t first;
+	uint16_t count;
+	uint8_t passes;
+	bool write;
+};
+
+/*
+ * A trace is a sequence of runs replayed loops times. Faults recorded on
+ * a target come as long stretches of consecutive pages, so traces are
+ * stored as runs rather than as individual page numbers.
+ */
+struct trace {
+	const char *name;
+	const char *description;
+	const struct trace_run *runs;
+	size_t num_runs;
+	unsigned int loops;
+};
+
+extern const struct trace traces[];
+extern const size_t num_traces;
+
+#endif /* ZEPHYR_TESTS_BENCHMARKS_DEMAND_PAGING_EVICTION_TRACES_H_ */
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of device_get_binding(). It defines
+ * NUM_DEVICES devices and measures the time it takes to look some of them up
+ * by name, as well as a name no device has. Devices sharing an init priority
+ * are in no particular order, so where each of them is in the device list
+ * depends on the build.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NUM_DEVICES 256
+#define NUM_RUNS    1000
+
+#if defined(CONFIG_DEVICE_NAME_HASH)
+#define LOOKUP_NAME "name_hash"
+#else
+#define LOOKUP_NAME "linear"
+#endif
+
+#define BENCH_DEVICE_DEFINE(n, _)                                              \
+	DEVICE_DEFINE(bench_dev_##n, "bench_dev_" #n, NULL, NULL, NULL, NULL,  \
+		      POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL)
+
+LISTIFY(NUM_DEVICES, BENCH_DEVICE_DEFINE, (;));
+
+static void report(const char *name, const char *description,
+		   uint64_t cycles, unsigned int count)
+{
+	uint64_t avg_cycles = cycles / count;
+	uint64_t avg_ns = timing_cycles_to_ns_avg(cycles, count);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char tag[50];
+
+	snprintf(tag, sizeof(tag), "device_lookup.%s.%s", LOOKUP_NAME, name);
+	printk("REC: %-40s - %-50s : %7llu cycles , %7llu ns :\n", tag,
+	       description, (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#else
+	ARG_UNUSED(name);
+
+	printk("%-60s : %7llu cycles , %7llu ns\n", description,
+	       (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int bench_lookup(const char *name, const char *description,
+			const char *device_name, bool exists)
+{
+	char buf[Z_DEVICE_MAX_NAME_LEN];
+	uint64_t cycles = 0;
+	const struct device *dev;
+	timing_t start, end;
+
+	/* Copy the name, so that it is not found by address */
+	strncpy(buf, device_name, sizeof(buf) - 1);
+	buf[sizeof(buf) - 1] = '\0';
+
+	for (unsigned int run = 0; run < NUM_RUNS; run++) {
+		start = timing_counter_get();
+		dev = device_get_binding(buf);
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+
+		if ((dev != NULL) != exists) {
+			printk("Unexpected lookup result for %s\n", buf);
+			return TC_FAIL;
+		}
+	}
+
+	report(name, description, cycles, NUM_RUNS);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	const struct device *devices;
+	size_t num_devices = z_device_get_all_static(&devices);
+	int result = TC_PASS;
+
+	timing_init();
+	timing_start();
+
+	printk("Device Lookup Measurements (%s)\n", LOOKUP_NAME);
+	printk("%zu devices\n", num_devices);
+
+	if ((bench_lookup("dev_0", "device_get_binding() of bench_dev_0",
+			  "bench_dev_0", true) != TC_PASS) ||
+	    (bench_lookup("dev_128", "device_get_binding() of bench_dev_128",
+			  "bench_dev_128", true) != TC_PASS) ||
+	    (bench_lookup("dev_255", "device_get_binding() of bench_dev_255",
+			  "bench_dev_255", true) != TC_PASS) ||
+	    (bench_lookup("missing", "device_get_binding() of a missing name",
+			  "bench_dev_missing", false) != TC_PASS)) {
+		result = TC_FAIL;
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
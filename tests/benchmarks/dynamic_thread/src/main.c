@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of short-lived dynamic threads. It measures
+ * the time it takes to create a thread with a dynamically allocated stack,
+ * run it and join it, with k_thread_stack_alloc() and with
+ * k_thread_dynamic_create().
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+
+#define NUM_RUNS    100
+#define HEAP_SIZE   65536
+#define THREAD_PRIO K_PRIO_PREEMPT(1)
+
+#if defined(CONFIG_INIT_STACKS)
+#define FILL_NAME "init_stacks"
+#else
+#define FILL_NAME "no_fill"
+#endif
+
+K_HEAP_DEFINE(bench_heap, HEAP_SIZE);
+
+static struct k_thread thread;
+
+static const size_t stack_sizes[] = { 1024, 4096, 16384 };
+
+static void report(const char *name, const char *description,
+		   uint64_t cycles, unsigned int count)
+{
+	uint64_t avg_cycles = cycles / count;
+	uint64_t avg_ns = timing_cycles_to_ns_avg(cycles, count);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char tag[50];
+
+	snprintf(tag, sizeof(tag), "dynamic_thread.%s.%s", FILL_NAME, name);
+	printk("REC: %-40s - %-50s : %7llu cycles , %7llu ns :\n", tag,
+	       description, (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#else
+	ARG_UNUSED(name);
+
+	printk("%-60s : %7llu cycles , %7llu ns\n", description,
+	       (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static void entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+}
+
+static int bench_stack_alloc(size_t stack_size)
+{
+	uint64_t cycles = 0;
+	k_thread_stack_t *stack;
+	timing_t start, end;
+	char name[24];
+	char description[64];
+
+	for (unsigned int run = 0; run < NUM_RUNS; run++) {
+		start = timing_counter_get();
+		stack = k_thread_stack_alloc(stack_size, 0);
+		if (stack == NULL) {
+			printk("Failed to allocate a %zu byte stack\n", stack_size);
+			return TC_FAIL;
+		}
+		k_thread_create(&thread, stack, stack_size, entry, NULL, NULL,
+				NULL, THREAD_PRIO, 0, K_NO_WAIT);
+		k_thread_join(&thread, K_FOREVER);
+		k_thread_stack_free(stack);
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	snprintf(name, sizeof(name), "stack_alloc.%zu", stack_size);
+	snprintf(description, sizeof(description),
+		 "Thread with a %zu byte k_thread_stack_alloc() stack", stack_size);
+	report(name, description, cycles, NUM_RUNS);
+
+	return TC_PASS;
+}
+
+static int bench_dynamic_create(size_t stack_size)
+{
+	uint64_t cycles = 0;
+	timing_t start, end;
+	char name[24];
+	char description[64];
+	k_tid_t tid;
+
+	for (unsigned int run = 0; run < NUM_RUNS; run++) {
+		start = timing_counter_get();
+		tid = k_thread_dynamic_create(stack_size, entry, NULL, NULL, NULL,
+					      THREAD_PRIO, 0, K_NO_WAIT);
+		if (tid == NULL) {
+			printk("Failed to create a %zu byte stack thread\n", stack_size);
+			return TC_FAIL;
+		}
+		k_thread_join(tid, K_FOREVER);
+		k_thread_dynamic_release(tid);
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	snprintf(name, sizeof(name), "dynamic_create.%zu", stack_size);
+	snprintf(description, sizeof(description),
+		 "Thread with a %zu byte k_thread_dynamic_create() stack", stack_size);
+	report(name, description, cycles, NUM_RUNS);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int result = TC_PASS;
+
+	k_thread_heap_assign(k_current_get(), &bench_heap);
+
+	timing_init();
+	timing_start();
+
+	printk("Dynamic Thread Measurements (%s)\n", FILL_NAME);
+
+	for (size_t i = 0; i < ARRAY_SIZE(stack_sizes); i++) {
+		if ((bench_stack_alloc(stack_sizes[i]) != TC_PASS) ||
+		    (bench_dynamic_create(stack_sizes[i]) != TC_PASS)) {
+			result = TC_FAIL;
+			break;
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
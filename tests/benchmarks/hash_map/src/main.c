@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of the Hashmap implementations. It measures
+ * the average time it takes to insert entries, to look up keys that are in
+ * the Hashmap and keys that are not, and to remove the entries, for each
+ * implementation with the same keys and hash function.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+
+#define NUM_ENTRIES CONFIG_BENCHMARK_NUM_ENTRIES
+#define NUM_RUNS    4
+
+#if defined(CONFIG_SYS_HASH_FUNC32_CHOICE_DJB2)
+#define HASH_NAME "djb2"
+#elif defined(CONFIG_SYS_HASH_FUNC32_CHOICE_MURMUR3)
+#define HASH_NAME "murmur3"
+#else
+#define HASH_NAME "identity"
+#endif
+
+SYS_HASHMAP_SC_DEFINE_STATIC(sc_map);
+SYS_HASHMAP_OA_LP_DEFINE_STATIC(oa_lp_map);
+SYS_HASHMAP_SWISS_DEFINE_STATIC(swiss_map);
+
+struct bench_map {
+	const char *name;
+	const char *description;
+	struct sys_hashmap *map;
+};
+
+static const struct bench_map bench_maps[] = {
+	{ "sc", "Separate-Chaining", &sc_map },
+	{ "oa_lp", "Open-Addressing", &oa_lp_map },
+	{ "swiss", "Swiss Table", &swiss_map },
+};
+
+/* Spread the keys so that no hash function gets them in order */
+static inline uint64_t key_of(size_t i)
+{
+	return (uint64_t)i * 0x9e3779b97f4a7c15ULL;
+}
+
+static void report(const char *name, const char *description,
+		   uint64_t cycles, unsigned int count)
+{
+	uint64_t avg_cycles = cycles / count;
+	uint64_t avg_ns = timing_cycles_to_ns_avg(cycles, count);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char tag[50];
+
+	snprintf(tag, sizeof(tag), "hash_map.%s.%s", HASH_NAME, name);
+	printk("REC: %-40s - %-50s : %7llu cycles , %7llu ns :\n", tag,
+	       description, (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#else
+	ARG_UNUSED(name);
+
+	printk("%-60s : %7llu cycles , %7llu ns\n", description,
+	       (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static void report_op(const struct bench_map *bench, const char *op,
+		      const char *what, uint64_t cycles)
+{
+	char name[24];
+	char description[64];
+
+	snprintf(name, sizeof(name), "%s.%s", bench->name, op);
+	snprintf(description, sizeof(description), "%s %s",
+		 bench->description, what);
+	report(name, description, cycles, NUM_RUNS * NUM_ENTRIES);
+}
+
+static int bench_map(const struct bench_map *bench)
+{
+	struct sys_hashmap *map = bench->map;
+	uint64_t insert_cycles = 0;
+	uint64_t hit_cycles = 0;
+	uint64_t miss_cycles = 0;
+	uint64_t remove_cycles = 0;
+	timing_t start, end;
+	bool failed = false;
+	uint64_t value;
+
+	for (unsigned int run = 0; run < NUM_RUNS; run++) {
+		start = timing_counter_get();
+		for (size_t i = 0; i < NUM_ENTRIES; i++) {
+			failed |= (sys_hashmap_insert(map, key_of(i), i, NULL) != 1);
+		}
+		end = timing_counter_get();
+		insert_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		for (size_t i = 0; i < NUM_ENTRIES; i++) {
+			failed |= !sys_hashmap_get(map, key_of(i), &value) || (value != i);
+		}
+		end = timing_counter_get();
+		hit_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		for (size_t i = NUM_ENTRIES; i < (2 * NUM_ENTRIES); i++) {
+			failed |= sys_hashmap_get(map, key_of(i), NULL);
+		}
+		end = timing_counter_get();
+		miss_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		for (size_t i = 0; i < NUM_ENTRIES; i++) {
+			failed |= !sys_hashmap_remove(map, key_of(i), NULL);
+		}
+		end = timing_counter_get();
+		remove_cycles += timing_cycles_get(&start, &end);
+
+		if (failed || !sys_hashmap_is_empty(map)) {
+			printk("%s Hashmap failed with %u entries\n",
+			       bench->description, NUM_ENTRIES);
+			sys_hashmap_clear(map, NULL, NULL);
+			return TC_FAIL;
+		}
+	}
+
+	report_op(bench, "insert", "insert", insert_cycles);
+	report_op(bench, "get_hit", "lookup of a present key", hit_cycles);
+	report_op(bench, "get_miss", "lookup of a missing key", miss_cycles);
+	report_op(bench, "remove", "remove", remove_cycles);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int result = TC_PASS;
+
+	timing_init();
+	timing_start();
+
+	printk("Hashmap Measurements (%s hash, %u entries)\n", HASH_NAME,
+	       NUM_ENTRIES);
+
+	for (size_t i = 0; i < ARRAY_SIZE(bench_maps); i++) {
+		if (bench_map(&bench_maps[i]) != TC_PASS) {
+			result = TC_FAIL;
+			break;
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
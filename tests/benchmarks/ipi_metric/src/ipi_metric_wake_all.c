@@ -0,0 +1,194 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#if CONFIG_MP_MAX_NUM_CPUS <= 1
+#error "Test requires a system with more than 1 CPU"
+#endif
+
+#define IPI_TEST_INTERVAL_DURATION 30
+
+#define NUM_WORK_THREADS (CONFIG_MP_MAX_NUM_CPUS - 1)
+#define WORK_STACK_SIZE  4096
+
+/* More waiters than CPUs, so every batch readies more threads than can run */
+#define NUM_WAITER_THREADS (2 * CONFIG_MP_MAX_NUM_CPUS)
+#define WAITER_STACK_SIZE  2048
+
+#define WAKER_STACK_SIZE 4096
+
+#define WAITER_PRIORITY 5
+#define WAKER_PRIORITY  6
+#define WORK_PRIORITY   10
+
+static K_THREAD_STACK_ARRAY_DEFINE(work_stack, NUM_WORK_THREADS, WORK_STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stack, NUM_WAITER_THREADS, WAITER_STACK_SIZE);
+static K_THREAD_STACK_DEFINE(waker_stack, WAKER_STACK_SIZE);
+
+static struct k_thread work_thread[NUM_WORK_THREADS];
+static unsigned long work_array[NUM_WORK_THREADS][1024];
+static volatile unsigned long work_counter[NUM_WORK_THREADS];
+
+static struct k_thread waiter_thread[NUM_WAITER_THREADS];
+static struct k_thread waker_thread;
+
+static K_SEM_DEFINE(wake_sem, 0, 1);
+
+/* Number of waiter threads that are pending (or about to pend) on wake_sem */
+static atomic_t waiting;
+
+static volatile unsigned long wake_rounds;
+static atomic_t ipi_counter;
+
+void z_trace_sched_ipi(void)
+{
+	atomic_inc(&ipi_counter);
+}
+
+void work_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int index = POINTER_TO_UINT(p1);
+	unsigned long *array = p2;
+	unsigned long counter;
+
+	while (1) {
+		for (unsigned int i = 0; i < 1024; i++) {
+			counter = work_counter[index]++;
+
+			array[i] = (array[i] + counter) ^ array[i];
+		}
+	}
+}
+
+void waiter_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		atomic_inc(&waiting);
+		(void)k_sem_take(&wake_sem, K_FOREVER);
+		atomic_dec(&waiting);
+	}
+}
+
+void waker_entry(void *p1, void *p2, void *p3)
+{
+	int key;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		/*
+		 * Wait for the waiters from the previous round to pend
+		 * again. A waiter that is counted but has not quite pended
+		 * yet simply sits out this round.
+		 */
+
+		while (atomic_get(&waiting) < NUM_WAITER_THREADS) {
+			key = arch_irq_lock();
+			arch_spin_relax();
+			arch_irq_unlock(key);
+		}
+
+		/* Ready every waiter in a single operation */
+
+		k_sem_reset(&wake_sem);
+
+		wake_rounds++;
+	}
+}
+
+void report(void)
+{
+	unsigned int elapsed_time = IPI_TEST_INTERVAL_DURATION;
+	unsigned long total_work;
+	unsigned long last_work_counter[NUM_WORK_THREADS] = {};
+	unsigned long tmp_work_counter[NUM_WORK_THREADS] = {};
+	unsigned long last_rounds = 0;
+	unsigned long tmp_rounds;
+	unsigned long rounds;
+	unsigned int i;
+	unsigned int tmp_ipi_counter;
+
+	atomic_set(&ipi_counter, 0);
+
+	while (1) {
+		k_sleep(K_SECONDS(IPI_TEST_INTERVAL_DURATION));
+
+		/*
+		 * Get local copies of the counters to minimize
+		 * the impacts of delays from printf().
+		 */
+
+		total_work = 0;
+		for (i = 0; i < NUM_WORK_THREADS; i++) {
+			tmp_work_counter[i] = work_counter[i];
+			total_work += (tmp_work_counter[i] - last_work_counter[i]);
+		}
+
+		tmp_rounds = wake_rounds;
+		rounds = tmp_rounds - last_rounds;
+		last_rounds = tmp_rounds;
+
+		tmp_ipi_counter = (unsigned int)atomic_set(&ipi_counter, 0);
+
+		printf("**** IPI-Metric Wake-All Test **** Elapsed Time: %u\n",
+		       elapsed_time);
+
+		printf("  Wake-All Rounds: %lu\n", rounds);
+		printf("  IPI Count: %u\n", tmp_ipi_counter);
+		if (rounds != 0) {
+			printf("  IPIs per Round: %lu.%02lu\n",
+			       tmp_ipi_counter / rounds,
+			       ((tmp_ipi_counter % rounds) * 100) / rounds);
+		}
+
+		printf("  Total Work: %lu\n", total_work);
+
+		for (i = 0; i < NUM_WORK_THREADS; i++) {
+			printf("    - Work Counter #%u: %lu\n",
+			       i, tmp_work_counter[i] - last_work_counter[i]);
+			last_work_counter[i] = tmp_work_counter[i];
+		}
+
+		elapsed_time += IPI_TEST_INTERVAL_DURATION;
+	}
+}
+
+int main(void)
+{
+	unsigned int i;
+
+	/*
+	 * Unlike the other IPI-Metric tests, the work threads are
+	 * preemptible so that waking the waiters has them switched out.
+	 */
+
+	for (i = 0; i < NUM_WORK_THREADS; i++) {
+		k_thread_create(&work_thread[i], work_stack[i],
+				WORK_STACK_SIZE, work_entry,
+				UINT_TO_POINTER(i), work_array[i], NULL,
+				WORK_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < NUM_WAITER_THREADS; i++) {
+		k_thread_create(&waiter_thread[i], waiter_stack[i],
+				WAITER_STACK_SIZE, waiter_entry,
+				NULL, NULL, NULL,
+				WAITER_PRIORITY, 0, K_NO_WAIT);
+	}
+
+	k_thread_create(&waker_thread, waker_stack,
+			WAKER_STACK_SIZE, waker_entry,
+			NULL, NULL, NULL,
+			WAKER_PRIORITY, 0, K_NO_WAIT);
+
+	report();
+}
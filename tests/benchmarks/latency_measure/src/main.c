@@ -66,6 +66,9 @@ extern int condvar_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 extern int stack_ops(uint32_t num_iterations, uint32_t options);
 extern int stack_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 			       uint32_t alt_options);
+extern int msgq_ops(uint32_t num_iterations, uint32_t options);
+extern int msgq_blocking_ops(uint32_t num_iterations, uint32_t start_options,
+			     uint32_t alt_options);
 extern void heap_malloc_free(void);
 
 #if (CONFIG_MP_MAX_NUM_CPUS > 1)
@@ -196,6 +199,18 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 	stack_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER, K_USER);
 #endif
 
+	msgq_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 0);
+#ifdef CONFIG_USERSPACE
+	msgq_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
+#endif
+
+	msgq_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 0, 0);
+#ifdef CONFIG_USERSPACE
+	msgq_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, 0, K_USER);
+	msgq_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER, 0);
+	msgq_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER, K_USER);
+#endif
+
 	mutex_lock_unlock(CONFIG_BENCHMARK_NUM_ITERATIONS, 0);
 #ifdef CONFIG_USERSPACE
 	mutex_lock_unlock(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
@@ -0,0 +1,263 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure time for various k_msgq operations
+ *
+ * This file contains the tests that measures the times for the following
+ * k_msgq operations from both kernel threads and user threads:
+ *  1. Immediately adding a message to a k_msgq
+ *  2. Immediately removing a message from a k_msgq
+ *  3. Blocking on removing a message from a k_msgq
+ *  4. Waking (and context switching to) a thread blocked on a k_msgq
+ *
+ * When CONFIG_MSGQ_SPSC is enabled, each measurement is repeated on a
+ * single producer single consumer queue so that both modes can be compared.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#define MAX_MSGS  16
+
+static BENCH_BMEM char __aligned(4) msgq_buffer[MAX_MSGS * sizeof(uint32_t)];
+
+static struct k_msgq msgq;
+
+static void msgq_queue_init(bool spsc)
+{
+#ifdef CONFIG_MSGQ_SPSC
+	if (spsc) {
+		k_msgq_spsc_init(&msgq, msgq_buffer, sizeof(uint32_t), MAX_MSGS);
+		return;
+	}
+#endif /* CONFIG_MSGQ_SPSC */
+
+	k_msgq_init(&msgq, msgq_buffer, sizeof(uint32_t), MAX_MSGS);
+}
+
+static void msgq_put_get_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+	timing_t start;
+	timing_t mid;
+	timing_t finish;
+	uint64_t put_sum = 0ULL;
+	uint64_t get_sum = 0ULL;
+	uint32_t data = 1234;
+
+	for (uint32_t i = 0; i < num_iterations; i++) {
+		start = timing_timestamp_get();
+
+		(void) k_msgq_put(&msgq, &data, K_NO_WAIT);
+
+		mid = timing_timestamp_get();
+
+		(void) k_msgq_get(&msgq, &data, K_NO_WAIT);
+
+		finish = timing_timestamp_get();
+
+		put_sum += timing_cycles_get(&start, &mid);
+		get_sum += timing_cycles_get(&mid, &finish);
+	}
+
+	timestamp.cycles = put_sum;
+	k_sem_take(&pause_sem, K_FOREVER);
+
+	timestamp.cycles = get_sum;
+}
+
+static int msgq_ops_mode(uint32_t num_iterations, uint32_t options, bool spsc)
+{
+	int      priority;
+	uint64_t cycles;
+	char     tag[50];
+	char     description[120];
+	const char *mode = spsc ? "msgq.spsc" : "msgq";
+
+	priority = k_thread_priority_get(k_current_get());
+
+	timing_start();
+
+	msgq_queue_init(spsc);
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			msgq_put_get_thread_entry,
+			(void *)(uintptr_t)num_iterations,
+			NULL, NULL,
+			priority - 1, options, K_FOREVER);
+
+	k_thread_access_grant(&start_thread, &pause_sem, &msgq);
+
+	k_thread_start(&start_thread);
+
+	snprintf(tag, sizeof(tag),
+		 "%s.put.immediate.%s", mode,
+		 options & K_USER ? "user" : "kernel");
+	snprintf(description, sizeof(description),
+		 "%-40s - Add data to k_msgq (no ctx switch)", tag);
+
+	cycles = timestamp.cycles;
+	cycles -= timestamp_overhead_adjustment(options, options);
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+	k_sem_give(&pause_sem);
+
+	snprintf(tag, sizeof(tag),
+		 "%s.get.immediate.%s", mode,
+		 options & K_USER ? "user" : "kernel");
+	snprintf(description, sizeof(description),
+		 "%-40s - Get data from k_msgq (no ctx switch)", tag);
+	cycles = timestamp.cycles;
+	cycles -= timestamp_overhead_adjustment(options, options);
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+
+	k_thread_join(&start_thread, K_FOREVER);
+
+	timing_stop();
+
+	return 0;
+}
+
+int msgq_ops(uint32_t num_iterations, uint32_t options)
+{
+	msgq_ops_mode(num_iterations, options, false);
+	if (IS_ENABLED(CONFIG_MSGQ_SPSC)) {
+		msgq_ops_mode(num_iterations, options, true);
+	}
+
+	return 0;
+}
+
+static void alt_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+	timing_t  start;
+	timing_t  mid;
+	timing_t  finish;
+	uint64_t  sum[2] = {0ULL, 0ULL};
+	uint32_t  i;
+	uint32_t  data;
+
+	for (i = 0; i < num_iterations; i++) {
+
+		/* 1. Block waiting for data on k_msgq */
+
+		start = timing_timestamp_get();
+
+		k_msgq_get(&msgq, &data, K_FOREVER);
+
+		/* 3. Data obtained. */
+
+		finish = timing_timestamp_get();
+
+		mid = timestamp.sample;
+
+		sum[0] += timing_cycles_get(&start, &mid);
+		sum[1] += timing_cycles_get(&mid, &finish);
+	}
+
+	timestamp.cycles = sum[0];
+	k_sem_take(&pause_sem, K_FOREVER);
+	timestamp.cycles = sum[1];
+}
+
+static void start_thread_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t num_iterations = (uint32_t)(uintptr_t)p1;
+	uint32_t i;
+	uint32_t data = 123;
+
+	k_thread_start(&alt_thread);
+
+	for (i = 0; i < num_iterations; i++) {
+
+		/* 2. Add data thereby waking alt thread */
+
+		timestamp.sample = timing_timestamp_get();
+
+		k_msgq_put(&msgq, &data, K_FOREVER);
+	}
+
+	k_thread_join(&alt_thread, K_FOREVER);
+}
+
+static int msgq_blocking_ops_mode(uint32_t num_iterations, uint32_t start_options,
+				  uint32_t alt_options, bool spsc)
+{
+	int      priority;
+	uint64_t cycles;
+	char     tag[50];
+	char     description[120];
+	const char *mode = spsc ? "msgq.spsc" : "msgq";
+
+	priority = k_thread_priority_get(k_current_get());
+
+	timing_start();
+
+	msgq_queue_init(spsc);
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			start_thread_entry,
+			(void *)(uintptr_t)num_iterations,
+			NULL, NULL,
+			priority - 1, start_options, K_FOREVER);
+
+	k_thread_create(&alt_thread, alt_stack,
+			K_THREAD_STACK_SIZEOF(alt_stack),
+			alt_thread_entry,
+			(void *)(uintptr_t)num_iterations,
+			NULL, NULL,
+			priority - 2, alt_options, K_FOREVER);
+
+	k_thread_access_grant(&start_thread, &alt_thread, &pause_sem, &msgq);
+	k_thread_access_grant(&alt_thread, &pause_sem, &msgq);
+
+	k_thread_start(&start_thread);
+
+	snprintf(tag, sizeof(tag),
+		 "%s.get.blocking.%s_to_%s", mode,
+		 alt_options & K_USER ? "u" : "k",
+		 start_options & K_USER ? "u" : "k");
+	snprintf(description, sizeof(description),
+		 "%-40s - Get data from k_msgq (w/ ctx switch)", tag);
+
+	cycles = timestamp.cycles;
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+	k_sem_give(&pause_sem);
+
+	snprintf(tag, sizeof(tag),
+		 "%s.put.wake+ctx.%s_to_%s", mode,
+		 start_options & K_USER ? "u" : "k",
+		 alt_options & K_USER ? "u" : "k");
+	snprintf(description, sizeof(description),
+		 "%-40s - Add data to k_msgq (w/ ctx switch)", tag);
+	cycles = timestamp.cycles;
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+
+	k_thread_join(&start_thread, K_FOREVER);
+
+	timing_stop();
+
+	return 0;
+}
+
+int msgq_blocking_ops(uint32_t num_iterations, uint32_t start_options,
+		      uint32_t alt_options)
+{
+	msgq_blocking_ops_mode(num_iterations, start_options, alt_options, false);
+	if (IS_ENABLED(CONFIG_MSGQ_SPSC)) {
+		msgq_blocking_ops_mode(num_iterations, start_options, alt_options, true);
+	}
+
+	return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark of memory mappings. It measures the time
+ * k_mem_map() and k_mem_unmap() take for anonymous memory of various sizes,
+ * the time k_mem_map_phys_bare() and k_mem_unmap_phys_bare() take for a large
+ * physical region, and the time it then takes to read through that region
+ * one page at a time, which depends on how many TLB entries it needs.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+
+#define PAGE_SIZE   CONFIG_MMU_PAGE_SIZE
+#define PHYS_ADDR   CONFIG_BENCHMARK_PHYS_ADDR
+#define PHYS_SIZE   CONFIG_BENCHMARK_PHYS_SIZE
+#define NUM_RUNS    8
+#define READ_PASSES 16
+
+#if defined(CONFIG_X86_MMU_LARGE_PAGES)
+#define PAGES_NAME "large_pages"
+#else
+#define PAGES_NAME "small_pages"
+#endif
+
+static const size_t anon_pages[] = { 1, 16, 256 };
+
+static void report(const char *name, const char *description,
+		   uint64_t cycles, unsigned int count)
+{
+	uint64_t avg_cycles = cycles / count;
+	uint64_t avg_ns = timing_cycles_to_ns_avg(cycles, count);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	char tag[50];
+
+	snprintf(tag, sizeof(tag), "mem_map.%s.%s", PAGES_NAME, name);
+	printk("REC: %-40s - %-50s : %7llu cycles , %7llu ns :\n", tag,
+	       description, (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#else
+	ARG_UNUSED(name);
+
+	printk("%-60s : %7llu cycles , %7llu ns\n", description,
+	       (unsigned long long)avg_cycles,
+	       (unsigned long long)avg_ns);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static int bench_anon(size_t num_pages)
+{
+	uint64_t map_cycles = 0;
+	uint64_t unmap_cycles = 0;
+	timing_t start, end;
+	char name[24];
+	char description[64];
+	void *addr;
+
+	for (unsigned int run = 0; run < NUM_RUNS; run++) {
+		start = timing_counter_get();
+		addr = k_mem_map(num_pages * PAGE_SIZE, K_MEM_PERM_RW);
+		end = timing_counter_get();
+		if (addr == NULL) {
+			printk("Failed to map %zu pages\n", num_pages);
+			return TC_FAIL;
+		}
+		map_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		k_mem_unmap(addr, num_pages * PAGE_SIZE);
+		end = timing_counter_get();
+		unmap_cycles += timing_cycles_get(&start, &end);
+	}
+
+	snprintf(name, sizeof(name), "anon.map.%zu", num_pages);
+	snprintf(description, sizeof(description),
+		 "k_mem_map() of %zu anonymous pages", num_pages);
+	report(name, description, map_cycles, NUM_RUNS);
+
+	snprintf(name, sizeof(name), "anon.unmap.%zu", num_pages);
+	snprintf(description, sizeof(description),
+		 "k_mem_unmap() of %zu anonymous pages", num_pages);
+	report(name, description, unmap_cycles, NUM_RUNS);
+
+	return TC_PASS;
+}
+
+static uint32_t read_through(const volatile uint8_t *addr)
+{
+	uint32_t sum = 0;
+
+	for (size_t offset = 0; offset < PHYS_SIZE; offset += PAGE_SIZE) {
+		sum += addr[offset];
+	}
+
+	return sum;
+}
+
+static void bench_phys(void)
+{
+	uint64_t map_cycles = 0;
+	uint64_t unmap_cycles = 0;
+	uint64_t read_cycles = 0;
+	timing_t start, end;
+	uint8_t *addr;
+
+	for (unsigned int run = 0; run < NUM_RUNS; run++) {
+		start = timing_counter_get();
+		k_mem_map_phys_bare(&addr, PHYS_ADDR, PHYS_SIZE, K_MEM_CACHE_WB);
+		end = timing_counter_get();
+		map_cycles += timing_cycles_get(&start, &end);
+
+		/* First pass warms up the caches */
+		(void)read_through(addr);
+
+		start = timing_counter_get();
+		for (unsigned int pass = 0; pass < READ_PASSES; pass++) {
+			(void)read_through(addr);
+		}
+		end = timing_counter_get();
+		read_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		k_mem_unmap_phys_bare(addr, PHYS_SIZE);
+		end = timing_counter_get();
+		unmap_cycles += timing_cycles_get(&start, &end);
+	}
+
+	report("phys.map", "k_mem_map_phys_bare() of the physical region",
+	       map_cycles, NUM_RUNS);
+	report("phys.unmap", "k_mem_unmap_phys_bare() of the physical region",
+	       unmap_cycles, NUM_RUNS);
+	report("phys.read", "Read of one byte per page of the physical region",
+	       read_cycles, NUM_RUNS * READ_PASSES * (PHYS_SIZE / PAGE_SIZE));
+}
+
+int main(void)
+{
+	int result = TC_PASS;
+
+	timing_init();
+	timing_start();
+
+	printk("Memory Mapping Measurements (%s)\n", PAGES_NAME);
+	printk("Physical region of %u KiB at 0x%lx\n", PHYS_SIZE / 1024U,
+	       (unsigned long)PHYS_ADDR);
+
+	for (size_t i = 0; i < ARRAY_SIZE(anon_pages); i++) {
+		if (bench_anon(anon_pages[i]) != TC_PASS) {
+			result = TC_FAIL;
+			break;
+		}
+	}
+
+	if (result == TC_PASS) {
+		bench_phys();
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
@@ -43,6 +43,39 @@ static struct k_thread busy_thread[CONFIG_MP_MAX_NUM_CPUS - 1];
 
 static K_THREAD_STACK_ARRAY_DEFINE(busy_thread_stack, CONFIG_MP_MAX_NUM_CPUS - 1,
 				   BUSY_THREAD_STACK_SIZE);
+
+static volatile bool busy_stop;
+
+/* Throughput phase: pairs of threads ping-ponging through semaphores,
+ * with one pair per CPU in use, to show how the scheduler scales with
+ * the number of CPUs contending for it.
+ */
+#define N_PAIRS CONFIG_MP_MAX_NUM_CPUS
+#define PING_THREAD_STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define THROUGHPUT_WINDOW_MS 500
+
+static struct k_thread ping_thread[2 * N_PAIRS];
+static K_THREAD_STACK_ARRAY_DEFINE(ping_thread_stack, 2 * N_PAIRS,
+				   PING_THREAD_STACK_SIZE);
+static struct k_sem ping_sem[2 * N_PAIRS];
+
+/* One counter per thread, on its own cache line, so that counting does
+ * not make the threads contend with each other
+ */
+struct ping_counter {
+	volatile uint32_t count;
+} __aligned(64);
+
+static struct ping_counter ping_count[2 * N_PAIRS];
+
+/* Mutex phase: one thread per CPU in use repeatedly takes a shared mutex
+ * around a short critical section, as a k_mutex protecting a small data
+ * structure would be used.
+ */
+#define MUTEX_HOLD_LOOPS 100
+
+static struct k_mutex contended_mutex;
+static volatile uint32_t mutex_counter;
 #endif /* (CONFIG_MP_MAX_NUM_CPUS > 1) */
 
 _wait_q_t waitq;
@@ -100,9 +133,115 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 #if (CONFIG_MP_MAX_NUM_CPUS > 1)
 static void busy_thread_entry(void *arg1, void *arg2, void *arg3)
 {
+	while (!busy_stop) {
+	}
+}
+
+static void ping_count_reset(void)
+{
+	for (unsigned int i = 0; i < ARRAY_SIZE(ping_count); i++) {
+		ping_count[i].count = 0U;
+	}
+}
+
+static uint32_t ping_count_sum(unsigned int num_threads)
+{
+	uint32_t sum = 0U;
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		sum += ping_count[i].count;
+	}
+
+	return sum;
+}
+
+static void ping_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct k_sem *mine = arg1;
+	struct k_sem *other = arg2;
+	struct ping_counter *counter = arg3;
+
 	while (true) {
+		k_sem_take(mine, K_FOREVER);
+		k_sem_give(other);
+		counter->count++;
 	}
 }
+
+static void run_throughput(unsigned int num_pairs, int prio)
+{
+	unsigned int i;
+	uint32_t count;
+
+	ping_count_reset();
+
+	for (i = 0; i < 2 * num_pairs; i++) {
+		k_sem_init(&ping_sem[i], 0, 1);
+	}
+
+	for (i = 0; i < 2 * num_pairs; i++) {
+		k_thread_create(&ping_thread[i], ping_thread_stack[i],
+				PING_THREAD_STACK_SIZE, ping_fn,
+				&ping_sem[i], &ping_sem[i ^ 1U], &ping_count[i],
+				prio, 0, K_NO_WAIT);
+	}
+
+	for (i = 0; i < num_pairs; i++) {
+		k_sem_give(&ping_sem[2 * i]);
+	}
+
+	k_sleep(K_MSEC(THROUGHPUT_WINDOW_MS));
+	count = ping_count_sum(2 * num_pairs);
+
+	for (i = 0; i < 2 * num_pairs; i++) {
+		k_thread_abort(&ping_thread[i]);
+	}
+
+	printk("throughput cpus %u switches/s %lu\n", num_pairs,
+	       (unsigned long)count * 1000UL / THROUGHPUT_WINDOW_MS);
+}
+
+static void mutex_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct ping_counter *counter = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_mutex_lock(&contended_mutex, K_FOREVER);
+		for (int i = 0; i < MUTEX_HOLD_LOOPS; i++) {
+			mutex_counter++;
+		}
+		k_mutex_unlock(&contended_mutex);
+		counter->count++;
+	}
+}
+
+static void run_mutex_throughput(unsigned int num_threads, int prio)
+{
+	unsigned int i;
+	uint32_t count;
+
+	ping_count_reset();
+	k_mutex_init(&contended_mutex);
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_create(&ping_thread[i], ping_thread_stack[i],
+				PING_THREAD_STACK_SIZE, mutex_fn,
+				&ping_count[i], NULL, NULL, prio, 0, K_NO_WAIT);
+	}
+
+	k_sleep(K_MSEC(THROUGHPUT_WINDOW_MS));
+	count = ping_count_sum(num_threads);
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_abort(&ping_thread[i]);
+	}
+
+	printk("mutex cpus %u locks/s %lu\n", num_threads,
+	       (unsigned long)count * 1000UL / THROUGHPUT_WINDOW_MS);
+}
 #endif /* (CONFIG_MP_MAX_NUM_CPUS > 1) */
 
 int main(void)
@@ -181,6 +320,24 @@ int main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+	busy_stop = true;
+	for (uint32_t i = 0; i < CONFIG_MP_MAX_NUM_CPUS - 1; i++) {
+		k_thread_join(&busy_thread[i], K_FOREVER);
+	}
+
+	for (unsigned int n = 1; n <= arch_num_cpus(); n++) {
+		run_throughput(n, main_prio + 1);
+	}
+
+	printk("mutex adaptive spinning %s\n",
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "on" : "off");
+	for (unsigned int n = 1; n <= arch_num_cpus(); n++) {
+		run_mutex_throughput(n, main_prio + 1);
+	}
+#endif /* (CONFIG_MP_MAX_NUM_CPUS > 1) */
+
 	printk("fin\n");
 	return 0;
 }
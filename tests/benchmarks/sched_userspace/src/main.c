@@ -116,6 +116,59 @@ static int exec_test(uint8_t nb_threads)
 	return yielder_status;
 }
 
+#ifdef CONFIG_DYNAMIC_OBJECTS
+#define MAX_NB_DYN_OBJECTS 1024
+
+static struct k_thread dyn_thread;
+static K_THREAD_STACK_DEFINE(dyn_stack, APP_STACKSIZE);
+static size_t nb_dyn_objects;
+
+static uint32_t dyn_run(k_thread_entry_t entry, struct k_sem *sem)
+{
+	k_tid_t tid;
+
+	stamp(MEAS_START);
+	tid = k_thread_create(&dyn_thread, dyn_stack, APP_STACKSIZE, entry,
+			      sem, NULL, NULL, THREADS_PRIO, K_USER, K_FOREVER);
+	k_object_access_grant(sem, tid);
+	k_thread_start(tid);
+	k_thread_join(tid, K_FOREVER);
+	stamp(MEAS_END);
+
+	return stamps[MEAS_END] - stamps[MEAS_START];
+}
+
+/* Time syscalls on a dynamic object, and the creation and exit of a user
+ * thread, with nb_objects other dynamic objects allocated
+ */
+static int exec_dyn_test(size_t nb_objects, struct k_sem *sem)
+{
+	struct k_sem *filler;
+	uint32_t full_time;
+
+	for (; nb_dyn_objects < nb_objects; nb_dyn_objects++) {
+		filler = k_object_alloc(K_OBJ_SEM);
+		if (filler == NULL) {
+			printk("k_object_alloc failed\n");
+			return 1;
+		}
+		k_sem_init(filler, 0, 1);
+	}
+
+	full_time = dyn_run(dyn_object_syscalls, sem);
+	printk("Syscalls with %4zu objects: %8" PRIu32 " cyc & %6" PRIu32 " calls -> %6"
+				PRIu64 " ns per call\n", nb_objects, full_time,
+				NB_DYN_SYSCALLS,
+				k_cyc_to_ns_near64(full_time) / NB_DYN_SYSCALLS);
+
+	full_time = dyn_run(dyn_object_nop, sem);
+	printk("Thread with %4zu objects: %8" PRIu32 " cyc -> %6" PRIu64
+				" ns per create and join\n", nb_objects, full_time,
+				k_cyc_to_ns_near64(full_time));
+
+	return 0;
+}
+#endif /* CONFIG_DYNAMIC_OBJECTS */
 
 int main(void)
 {
@@ -136,6 +189,28 @@ int main(void)
 		}
 	}
 
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	size_t nb_objects_list[] = {0, 64, 256, MAX_NB_DYN_OBJECTS};
+	struct k_sem *sem = k_object_alloc(K_OBJ_SEM);
+
+	printk("============================\n");
+	printk("dynamic object syscalls (k_sem_give)\n");
+
+	if (sem == NULL) {
+		printk("FAIL\n");
+		return 0;
+	}
+	k_sem_init(sem, 0, K_SEM_MAX_LIMIT);
+
+	for (size_t i = 0; i < ARRAY_SIZE(nb_objects_list); i++) {
+		ret = exec_dyn_test(nb_objects_list[i], sem);
+		if (ret != 0) {
+			printk("FAIL\n");
+			return 0;
+		}
+	}
+#endif /* CONFIG_DYNAMIC_OBJECTS */
+
 	printk("SUCCESS\n");
 	return 0;
 }
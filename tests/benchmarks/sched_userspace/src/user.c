@@ -19,3 +19,16 @@ void context_switch_yield(void *p1, void *p2, void *p3)
 		k_yield();
 	}
 }
+
+void dyn_object_syscalls(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+
+	for (uint32_t i = 0; i < NB_DYN_SYSCALLS; i++) {
+		k_sem_give(sem);
+	}
+}
+
+void dyn_object_nop(void *p1, void *p2, void *p3)
+{
+}
@@ -5,5 +5,8 @@
  */
 
 #define NB_YIELDS UINT32_C(1000000)
+#define NB_DYN_SYSCALLS UINT32_C(100000)
 
 void context_switch_yield(void *p1, void *p2, void *p3);
+void dyn_object_syscalls(void *p1, void *p2, void *p3);
+void dyn_object_nop(void *p1, void *p2, void *p3);
@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark that measures how long CPUs wait to acquire
+ * a contended spinlock. For every number of CPUs from one up to all of them,
+ * one thread pinned to each participating CPU repeatedly takes the same lock,
+ * and the latency of each k_spin_lock() call is recorded. Percentiles of
+ * those latencies, and the spread between the per-CPU averages, are then
+ * reported for each contention level.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NUM_CPUS    CONFIG_MP_MAX_NUM_CPUS
+#define NUM_SAMPLES CONFIG_BENCHMARK_NUM_SAMPLES
+#define HOLD_LOOPS  CONFIG_BENCHMARK_HOLD_LOOPS
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Below the main thread, so that it can start every contender */
+#define CONTENDER_PRIORITY K_PRIO_PREEMPT(1)
+
+static struct k_spinlock lock;
+static volatile uint32_t lock_counter;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[NUM_CPUS];
+
+static uint32_t samples[NUM_CPUS][NUM_SAMPLES];
+static uint32_t sorted[NUM_CPUS * NUM_SAMPLES];
+
+static atomic_t ready_count;
+static atomic_val_t num_contenders;
+
+static void contender_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t *cycles = p1;
+	volatile uint32_t idle = 0;
+	k_spinlock_key_t key;
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Wait for every contender to be running before starting */
+	(void)atomic_inc(&ready_count);
+	while (atomic_get(&ready_count) < num_contenders) {
+		arch_spin_relax();
+	}
+
+	for (unsigned int i = 0; i < NUM_SAMPLES; i++) {
+		start = timing_counter_get();
+		key = k_spin_lock(&lock);
+		finish = timing_counter_get();
+
+		for (unsigned int j = 0; j < HOLD_LOOPS; j++) {
+			lock_counter++;
+		}
+
+		k_spin_unlock(&lock, key);
+
+		cycles[i] = (uint32_t)timing_cycles_get(&start, &finish);
+
+		/* Give the other CPUs a chance to take the lock */
+		for (unsigned int j = 0; j < (HOLD_LOOPS / 2); j++) {
+			idle++;
+		}
+	}
+}
+
+static int compare_cycles(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void report(const char *tag, const char *description, uint64_t cycles)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7llu cycles , %7u ns :\n", tag, description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	ARG_UNUSED(tag);
+
+	printk("    %-50s : %7llu cycles (%7u nsec)\n", description, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif /* CONFIG_BENCHMARK_RECORDING */
+}
+
+static void report_stats(unsigned int num_cpus)
+{
+	unsigned int count = num_cpus * NUM_SAMPLES;
+	static const unsigned int percentiles[] = { 50, 90, 99 };
+	uint64_t min_avg = UINT64_MAX;
+	uint64_t max_avg = 0;
+	char tag[50];
+	char description[60];
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		uint64_t sum = 0;
+
+		for (unsigned int i = 0; i < NUM_SAMPLES; i++) {
+			sum += samples[cpu][i];
+			sorted[(cpu * NUM_SAMPLES) + i] = samples[cpu][i];
+		}
+
+		min_avg = MIN(min_avg, sum / NUM_SAMPLES);
+		max_avg = MAX(max_avg, sum / NUM_SAMPLES);
+	}
+
+	qsort(sorted, count, sizeof(sorted[0]), compare_cycles);
+
+#ifndef CONFIG_BENCHMARK_RECORDING
+	printk("------------------------------------\n");
+	printk("Spinlock acquisition with %u contending CPU(s)\n", num_cpus);
+#endif /* CONFIG_BENCHMARK_RECORDING */
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(percentiles); i++) {
+		snprintf(tag, sizeof(tag), "spinlock.acquire.%ucpu.p%u",
+			 num_cpus, percentiles[i]);
+		snprintf(description, sizeof(description),
+			 "Acquire latency, %u CPU(s), %uth percentile",
+			 num_cpus, percentiles[i]);
+		report(tag, description, sorted[(count * percentiles[i]) / 100]);
+	}
+
+	snprintf(tag, sizeof(tag), "spinlock.acquire.%ucpu.max", num_cpus);
+	snprintf(description, sizeof(description),
+		 "Acquire latency, %u CPU(s), maximum", num_cpus);
+	report(tag, description, sorted[count - 1]);
+
+	snprintf(tag, sizeof(tag), "spinlock.acquire.%ucpu.spread", num_cpus);
+	snprintf(description, sizeof(description),
+		 "Per-CPU average latency spread, %u CPU(s)", num_cpus);
+	report(tag, description, max_avg - min_avg);
+}
+
+static int run_contention(unsigned int num_cpus)
+{
+	uint32_t expected = lock_counter + (num_cpus * NUM_SAMPLES * HOLD_LOOPS);
+
+	atomic_set(&ready_count, 0);
+	num_contenders = num_cpus;
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_create(&threads[cpu], stacks[cpu], STACK_SIZE,
+				contender_entry, samples[cpu], NULL, NULL,
+				CONTENDER_PRIORITY, 0, K_FOREVER);
+		(void)k_thread_cpu_pin(&threads[cpu], cpu);
+		k_thread_start(&threads[cpu]);
+	}
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		(void)k_thread_join(&threads[cpu], K_FOREVER);
+	}
+
+	if (lock_counter != expected) {
+		printk("Lost %u updates made under the lock\n", expected - lock_counter);
+		return TC_FAIL;
+	}
+
+	report_stats(num_cpus);
+
+	return TC_PASS;
+}
+
+int main(void)
+{
+	int result = TC_PASS;
+
+	timing_init();
+
+	printk("Spinlock Contention Measurements (%s spinlocks)\n",
+	       IS_ENABLED(CONFIG_TICKET_SPINLOCKS) ? "ticket" : "atomic");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int num_cpus = 1; num_cpus <= arch_num_cpus(); num_cpus++) {
+		if (run_contention(num_cpus) != TC_PASS) {
+			result = TC_FAIL;
+			break;
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(result);
+
+	return 0;
+}
@@ -0,0 +1,312 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that will measure the length of time required
+ * to add, abort and expire kernel timeouts while the timeout queue holds a
+ * varying number of pending timeouts. The timeouts are bare struct _timeout
+ * objects with an empty expiry function, so neither the scheduler nor any
+ * kernel object is involved in the measurements.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include <timeout_q.h>
+#include <stdio.h>
+
+#define NUM_TIMEOUTS CONFIG_BENCHMARK_NUM_TIMEOUTS
+
+static struct _timeout timeouts[NUM_TIMEOUTS];
+static uint16_t order[NUM_TIMEOUTS];
+
+static uint64_t add_cycles[NUM_TIMEOUTS];
+static uint64_t abort_cycles[NUM_TIMEOUTS];
+static uint64_t announce_cycles[NUM_TIMEOUTS];
+
+/* Spread of the expiries in the coalescing test, in ticks */
+#define COALESCE_SPAN (4 * NUM_TIMEOUTS)
+
+static unsigned int expired_count;
+
+static uint32_t rand_state = 1;
+
+BUILD_ASSERT(NUM_TIMEOUTS <= UINT16_MAX);
+
+static uint32_t next_rand(void)
+{
+	/* Deterministic LCG so that every run sees the same expiry pattern */
+	rand_state = rand_state * 1103515245U + 12345U;
+
+	return rand_state >> 8;
+}
+
+static void expiry_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+/**
+ * Add timeouts with pseudo-random expiries far in the future, so that none
+ * of them fires during the test, then abort them in a shuffled order.
+ * Entry i of the cycle arrays is measured with i timeouts already pending
+ * (add) or with i timeouts left after the abort (abort).
+ */
+static void test_add_abort(void)
+{
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		k_timeout_t timeout = K_TICKS(1000 + (next_rand() & 0xffff));
+
+		start = timing_counter_get();
+		z_add_timeout(&timeouts[i], expiry_fn, timeout);
+		finish = timing_counter_get();
+
+		add_cycles[i] += timing_cycles_get(&start, &finish);
+	}
+
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		order[i] = i;
+	}
+
+	for (i = NUM_TIMEOUTS - 1; i > 0; i--) {
+		unsigned int j = next_rand() % (i + 1);
+		uint16_t tmp = order[i];
+
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		start = timing_counter_get();
+		z_abort_timeout(&timeouts[order[i]]);
+		finish = timing_counter_get();
+
+		abort_cycles[NUM_TIMEOUTS - i - 1] += timing_cycles_get(&start, &finish);
+	}
+}
+
+/**
+ * Arm one timeout per tick and announce the ticks one at a time, so that
+ * each announcement expires exactly one timeout. Entry i of the cycle array
+ * is measured with i + 1 timeouts pending.
+ */
+static void test_announce(void)
+{
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		z_add_timeout(&timeouts[i], expiry_fn, K_TICKS(i));
+	}
+
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		start = timing_counter_get();
+		sys_clock_announce(1);
+		finish = timing_counter_get();
+
+		announce_cycles[NUM_TIMEOUTS - i - 1] += timing_cycles_get(&start, &finish);
+	}
+
+	/* Anything left behind by a stray timer interrupt */
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+}
+
+static void count_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	expired_count++;
+}
+
+/**
+ * Arm every timeout with a pseudo-random expiry and the given slack, then
+ * announce the ticks one at a time. Reports the number of announcements that
+ * expired at least one timeout, i.e. the number of wakeups a tickless system
+ * would take, and the average cost of announcing a tick per timeout expired.
+ */
+static void test_coalesce(uint32_t slack)
+{
+	unsigned int wakeups = 0;
+	uint64_t cycles = 0;
+	unsigned int i;
+	timing_t start;
+	timing_t finish;
+	char tag[40];
+	char description[50];
+
+	rand_state = 1;
+	expired_count = 0;
+
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		k_timeout_t timeout = K_TICKS(next_rand() % COALESCE_SPAN);
+
+		z_add_timeout_slack(&timeouts[i], count_fn, timeout, slack);
+	}
+
+	for (i = 0; i <= COALESCE_SPAN + slack; i++) {
+		unsigned int before = expired_count;
+
+		start = timing_counter_get();
+		sys_clock_announce(1);
+		finish = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &finish);
+		if (expired_count != before) {
+			wakeups++;
+		}
+	}
+
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		z_abort_timeout(&timeouts[i]);
+	}
+
+	printk("Slack %u ticks: %u timeouts expired on %u ticks\n",
+	       slack, expired_count, wakeups);
+
+	cycles /= MAX(expired_count, 1U);
+	snprintf(tag, sizeof(tag), "timeout.announce.slack%u", slack);
+	snprintf(description, sizeof(description),
+		 "Announce cost per timeout, slack %u", slack);
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %-40s - %-50s : %7llu cycles , %7u ns :\n", tag, description,
+	       cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	printk("    %-50s : %7llu cycles (%7u nsec)\n", description, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+static uint64_t sqrt_u64(uint64_t square)
+{
+	if (square > 1) {
+		uint64_t lo = sqrt_u64(square >> 2) << 1;
+		uint64_t hi = lo + 1;
+
+		return ((hi * hi) > square) ? lo : hi;
+	}
+
+	return square;
+}
+
+static void compute_and_report_stats(unsigned int num_timeouts, unsigned int num_iterations,
+				     uint64_t *cycles, const char *tag, const char *str)
+{
+	uint64_t minimum = cycles[0];
+	uint64_t maximum = cycles[0];
+	uint64_t total = cycles[0];
+	uint64_t average;
+	uint64_t std_dev = 0;
+	uint64_t tmp;
+	uint64_t diff;
+	unsigned int i;
+
+	for (i = 1; i < num_timeouts; i++) {
+		if (cycles[i] > maximum) {
+			maximum = cycles[i];
+		}
+
+		if (cycles[i] < minimum) {
+			minimum = cycles[i];
+		}
+
+		total += cycles[i];
+	}
+
+	minimum /= (uint64_t)num_iterations;
+	maximum /= (uint64_t)num_iterations;
+	average = total / (num_timeouts * num_iterations);
+
+	for (i = 0; i < num_timeouts; i++) {
+		tmp = cycles[i] / num_iterations;
+		diff = (average > tmp) ? (average - tmp) : (tmp - average);
+
+		std_dev += (diff * diff);
+	}
+	std_dev /= num_timeouts;
+	std_dev = sqrt_u64(std_dev);
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	int tag_len = strlen(tag);
+	int descr_len = strlen(str);
+	int stag_len = strlen(".stddev");
+	int sdescr_len = strlen(", stddev.");
+
+	stag_len = (tag_len + stag_len < 40) ? 40 - tag_len : stag_len;
+	sdescr_len = (descr_len + sdescr_len < 50) ? 50 - descr_len : sdescr_len;
+
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".min", str,
+	       sdescr_len, ", min.", minimum, (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".max", str,
+	       sdescr_len, ", max.", maximum, (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".avg", str,
+	       sdescr_len, ", avg.", average, (uint32_t)timing_cycles_to_ns(average));
+	printk("REC: %s%-*s - %s%-*s : %7llu cycles , %7u ns :\n", tag, stag_len, ".stddev", str,
+	       sdescr_len, ", stddev.", std_dev, (uint32_t)timing_cycles_to_ns(std_dev));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s\n", str);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+	printk("    Std Deviation: %7llu cycles (%7u nsec)\n", std_dev,
+	       (uint32_t)timing_cycles_to_ns(std_dev));
+#endif
+}
+
+int main(void)
+{
+	unsigned int i;
+
+	timing_init();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timing wheel" : "dlist");
+	printk("Timing results: Clock frequency: %u MHz\n", timing_freq_get_mhz());
+
+	for (i = 0; i < NUM_TIMEOUTS; i++) {
+		z_init_timeout(&timeouts[i]);
+	}
+
+	timing_start();
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		test_add_abort();
+		test_announce();
+	}
+
+	compute_and_report_stats(NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 add_cycles, "timeout.add", "Add timeout with random expiry");
+	compute_and_report_stats(NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 abort_cycles, "timeout.abort", "Abort random pending timeout");
+	compute_and_report_stats(NUM_TIMEOUTS, CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 announce_cycles, "timeout.announce",
+				 "Announce tick expiring one timeout");
+
+	test_coalesce(0);
+#ifdef CONFIG_TIMEOUT_SLACK
+	test_coalesce(CONFIG_BENCHMARK_SLACK_TICKS);
+#endif /* CONFIG_TIMEOUT_SLACK */
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
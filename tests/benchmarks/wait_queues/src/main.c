@@ -15,6 +15,11 @@
  * reduce the memory footprint as not only are thread stacks not required,
  * but we also do not need the full k_thread structure for each of these
  * dummy threads.
+ *
+ * It also measures how long posting to an event object takes as the number
+ * of threads waiting on it grows, both for events that no thread waits on and
+ * for events that waiting threads must be checked against. These dummy
+ * threads need the full k_thread structure to hold their wait conditions.
  */
 
 #include <zephyr/kernel.h>
@@ -34,6 +39,21 @@ static _wait_q_t wait_q;
 uint64_t add_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 uint64_t remove_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 
+/* Matches K_EVENT_WAIT_ALL in kernel/events.c */
+#define EVENT_WAIT_ALL 0x01
+
+/* Set along with the event of each waiter to wake it; never posted */
+#define EVENT_NEVER    BIT(31)
+
+/* Posted events that no waiter waits on */
+#define EVENT_UNWATCHED BIT(30)
+
+static struct k_thread event_thread[CONFIG_BENCHMARK_NUM_EVENT_WAITERS];
+static struct k_event event;
+
+uint64_t post_unwatched_cycles[CONFIG_BENCHMARK_NUM_EVENT_WAITERS];
+uint64_t post_watched_cycles[CONFIG_BENCHMARK_NUM_EVENT_WAITERS];
+
 /**
  * Initialize each dummy thread.
  */
@@ -126,6 +146,62 @@ static void test_increasing_priority(_wait_q_t *q, unsigned int num_threads)
 }
 
 
+/**
+ * Pend the first num_waiters dummy threads on the event object. Each waits
+ * for all of one of the first 30 events and EVENT_NEVER, so that posts can
+ * be checked against them without waking any.
+ */
+static void event_waiters_pend(unsigned int num_waiters)
+{
+	unsigned int i;
+	struct k_thread *thread;
+
+	for (i = 0; i < num_waiters; i++) {
+		thread = &event_thread[i];
+		thread->events = BIT(i % 30) | EVENT_NEVER;
+		thread->event_options = EVENT_WAIT_ALL;
+		event.wait_mask |= thread->events;
+		z_pend_thread(thread, &event.wait_q, K_FOREVER);
+	}
+}
+
+static void event_waiters_unpend(unsigned int num_waiters)
+{
+	unsigned int i;
+
+	for (i = 0; i < num_waiters; i++) {
+		z_unpend_thread(&event_thread[i]);
+	}
+}
+
+static void test_event_post(unsigned int num_waiters)
+{
+	timing_t start;
+	timing_t finish;
+
+	event_waiters_pend(num_waiters);
+
+	/* Set an event no waiter waits on */
+
+	k_event_clear(&event, ~0);
+	start = timing_counter_get();
+	k_event_post(&event, EVENT_UNWATCHED);
+	finish = timing_counter_get();
+
+	post_unwatched_cycles[num_waiters - 1] += timing_cycles_get(&start, &finish);
+
+	/* Set an event the first waiter waits on, without waking it */
+
+	k_event_clear(&event, ~0);
+	start = timing_counter_get();
+	k_event_post(&event, BIT(0));
+	finish = timing_counter_get();
+
+	post_watched_cycles[num_waiters - 1] += timing_cycles_get(&start, &finish);
+
+	event_waiters_unpend(num_waiters);
+}
+
 static uint64_t sqrt_u64(uint64_t square)
 {
 	if (square > 1) {
@@ -318,6 +394,52 @@ int main(void)
 	}
 #endif
 
+	k_event_init(&event);
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_EVENT_WAITERS; i++) {
+		z_init_thread_base(&event_thread[i].base,
+				   i % CONFIG_NUM_PREEMPT_PRIORITIES,
+				   _THREAD_DUMMY, 0);
+	}
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		for (unsigned int n = 1; n <= CONFIG_BENCHMARK_NUM_EVENT_WAITERS; n++) {
+			test_event_post(n);
+		}
+	}
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_EVENT_WAITERS,
+				 CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 post_unwatched_cycles, "event.post.unwatched",
+				 "Post event no waiter waits on");
+
+#ifdef CONFIG_BENCHMARK_VERBOSE
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_EVENT_WAITERS; i++) {
+		snprintf(tag, sizeof(tag),
+			 "event.post.unwatched.%04u.waiters", i + 1);
+		snprintf(description, sizeof(description),
+			 "%-40s - Post unwatched event", tag);
+		PRINT_STATS_AVG(description, (uint32_t)post_unwatched_cycles[i],
+				CONFIG_BENCHMARK_NUM_ITERATIONS);
+	}
+#endif
+
+	compute_and_report_stats(CONFIG_BENCHMARK_NUM_EVENT_WAITERS,
+				 CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 post_watched_cycles, "event.post.watched",
+				 "Post event a waiter waits on");
+
+#ifdef CONFIG_BENCHMARK_VERBOSE
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_EVENT_WAITERS; i++) {
+		snprintf(tag, sizeof(tag),
+			 "event.post.watched.%04u.waiters", i + 1);
+		snprintf(description, sizeof(description),
+			 "%-40s - Post watched event", tag);
+		PRINT_STATS_AVG(description, (uint32_t)post_watched_cycles[i],
+				CONFIG_BENCHMARK_NUM_ITERATIONS);
+	}
+#endif
+
 	timing_stop();
 
 	TC_END_REPORT(0);
@@ -305,7 +305,7 @@ extern int init_level_sequence[4];
 extern int init_priority_sequence[4];
 extern int init_sub_priority_sequence[3];
 extern unsigned int seq_level_cnt;
-extern unsigned int seq_priority_cnt;
+extern atomic_t seq_priority_cnt;
 
 /**
  * @brief Test initialization level for device driver instances
@@ -549,6 +549,42 @@ ZTEST(device, test_device_get_by_dt_nodelabel)
 }
 #endif
 
+#ifdef CONFIG_INIT_TIMINGS
+/**
+ * @brief Test the timings of init functions
+ *
+ * @details Check that the init function of a POST_KERNEL device was timed,
+ * and that those of PRE_KERNEL devices were not.
+ *
+ * @ingroup kernel_device_tests
+ *
+ * @see sys_init_timings_get()
+ */
+ZTEST(device, test_init_timings)
+{
+	const struct device *dev = device_get_binding(DUMMY_PORT_2);
+	const struct init_timing *timings;
+	bool found = false;
+	size_t count;
+
+	zassert_not_null(dev);
+
+	timings = sys_init_timings_get(&count);
+	zassert_true(count > 0, "no init function timed");
+
+	for (size_t i = 0; i < count; i++) {
+		zassert_true(timings[i].level >= INIT_LEVEL_ORD(POST_KERNEL),
+			     "PRE_KERNEL init function timed");
+		if (timings[i].entry->dev == dev) {
+			zassert_equal(timings[i].result, 0, "");
+			found = true;
+		}
+	}
+
+	zassert_true(found, "device init function not timed");
+}
+#endif /* CONFIG_INIT_TIMINGS */
+
 void *user_setup(void)
 {
 #ifdef CONFIG_USERSPACE
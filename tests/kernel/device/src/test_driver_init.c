@@ -39,7 +39,7 @@ __pinned_bss int init_level_sequence[3] = {0};
 __pinned_bss int init_priority_sequence[4] = {0};
 __pinned_bss int init_sub_priority_sequence[3] = {0};
 __pinned_bss unsigned int seq_level_cnt;
-__pinned_bss unsigned int seq_priority_cnt;
+__pinned_bss atomic_t seq_priority_cnt;
 __pinned_bss unsigned int seq_sub_priority_cnt;
 
 /* define driver type 1: for testing initialize levels and priorities */
@@ -88,32 +88,36 @@ static int my_driver_lv_3_init(const struct device *dev)
 /* driver init function of testing priority */
 static int my_driver_pri_1_init(const struct device *dev)
 {
-	init_priority_sequence[seq_priority_cnt] = PRIORITY_1;
-	seq_priority_cnt++;
+	/* With CONFIG_DEVICE_INIT_PARALLEL, devices of different priorities
+	 * must still be initialized one after the other: linger here so that
+	 * the next priority would get ahead if it were run at the same time.
+	 */
+	if (IS_ENABLED(CONFIG_DEVICE_INIT_PARALLEL)) {
+		k_busy_wait(1000);
+	}
+
+	init_priority_sequence[atomic_inc(&seq_priority_cnt)] = PRIORITY_1;
 
 	return 0;
 }
 
 static int my_driver_pri_2_init(const struct device *dev)
 {
-	init_priority_sequence[seq_priority_cnt] = PRIORITY_2;
-	seq_priority_cnt++;
+	init_priority_sequence[atomic_inc(&seq_priority_cnt)] = PRIORITY_2;
 
 	return 0;
 }
 
 static int my_driver_pri_3_init(const struct device *dev)
 {
-	init_priority_sequence[seq_priority_cnt] = PRIORITY_3;
-	seq_priority_cnt++;
+	init_priority_sequence[atomic_inc(&seq_priority_cnt)] = PRIORITY_3;
 
 	return 0;
 }
 
 static int my_driver_pri_4_init(const struct device *dev)
 {
-	init_priority_sequence[seq_priority_cnt] = PRIORITY_4;
-	seq_priority_cnt++;
+	init_priority_sequence[atomic_inc(&seq_priority_cnt)] = PRIORITY_4;
 
 	return 0;
 }
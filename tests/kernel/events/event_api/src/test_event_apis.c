@@ -16,10 +16,12 @@
 static struct k_thread treceiver;
 static struct k_thread textra1;
 static struct k_thread textra2;
+static struct k_thread twaiter;
 
 static K_THREAD_STACK_DEFINE(sreceiver, STACK_SIZE);
 static K_THREAD_STACK_DEFINE(sextra1, STACK_SIZE);
 static K_THREAD_STACK_DEFINE(sextra2, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(swaiter, STACK_SIZE);
 
 static K_EVENT_DEFINE(test_event);
 static K_EVENT_DEFINE(sync_event);
@@ -75,6 +77,7 @@ ZTEST(events_api, test_k_event_init)
 
 	zassert_is_null(thread, NULL);
 	zassert_true(event.events == 0);
+	zassert_true(event.wait_mask == 0);
 }
 
 static void receive_existing_events(void)
@@ -473,6 +476,59 @@ ZTEST(events_api, test_k_event_wait_all_safe)
 	zexpect_equal(events, 0x62, "expected 0x62, got %x", events);
 }
 
+static void entry_waiter(void *p1, void *p2, void *p3)
+{
+	struct k_event *event = p1;
+
+	test_events = k_event_wait(event, 0x1, false, LONG_TIMEOUT);
+}
+
+/**
+ * Test the tracking of the events waited on.
+ *
+ * This is a white-box test to verify that posts only wake threads waiting
+ * on the events they set, and that the mask of events waited on is rebuilt
+ * once waiting threads have gone.
+ */
+ZTEST(events_api, test_event_wait_mask)
+{
+	static struct k_event  event;
+	uint32_t  events;
+
+	k_event_init(&event);
+	test_events = 0xFFFF;
+
+	(void) k_thread_create(&twaiter, swaiter, STACK_SIZE,
+			       entry_waiter, &event, NULL, NULL,
+			       K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	k_sleep(DELAY);
+	zassert_equal(event.wait_mask, 0x1);
+
+	/* Events nobody waits on do not wake the waiting thread */
+
+	k_event_post(&event, 0x6);
+	k_sleep(DELAY);
+	zassert_equal(test_events, 0xFFFF);
+	zassert_equal(event.wait_mask, 0x1);
+
+	k_event_post(&event, 0x1);
+	k_thread_join(&twaiter, K_FOREVER);
+	zassert_equal(test_events, 0x1);
+	zassert_equal(event.wait_mask, 0);
+
+	/* A timed out wait leaves its events in the mask until the next post */
+
+	k_event_clear(&event, ~0);
+	events = k_event_wait(&event, 0x8, false, SHORT_TIMEOUT);
+	zassert_equal(events, 0);
+	zassert_equal(event.wait_mask, 0x8);
+
+	k_event_post(&event, 0x8);
+	zassert_equal(event.wait_mask, 0);
+	zassert_equal(k_event_test(&event, ~0), 0x8);
+}
+
 /**
  * @}
  */
@@ -19,11 +19,14 @@
 
 static struct k_thread thread[NUM_THREADS];
 static struct k_thread alt_thread;
+static struct k_thread waiter_thread[NUM_THREADS];
 
 static bool alt_thread_created;
+static bool waiter_threads_created;
 
 static K_THREAD_STACK_ARRAY_DEFINE(stack, NUM_THREADS, STACK_SIZE);
 static K_THREAD_STACK_DEFINE(alt_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stack, NUM_THREADS, STACK_SIZE);
 
 static uint32_t ipi_count[CONFIG_MP_MAX_NUM_CPUS];
 static struct k_spinlock ipilock;
@@ -31,6 +34,7 @@ static atomic_t busy_started;
 static volatile bool alt_thread_done;
 
 static K_SEM_DEFINE(sem, 0, 1);
+static K_SEM_DEFINE(wake_all_sem, 0, 1);
 
 void z_trace_sched_ipi(void)
 {
@@ -106,6 +110,19 @@ static void pending_thread_entry(void *p1, void *p2, void *p3)
 	}
 }
 
+static void waiter_thread_entry(void *p1, void *p2, void *p3)
+{
+	int  key;
+
+	(void)k_sem_take(&wake_all_sem, K_FOREVER);
+
+	while (!alt_thread_done) {
+		key = arch_irq_lock();
+		arch_spin_relax();
+		arch_irq_unlock(key);
+	}
+}
+
 static void alt_thread_create(int priority, const char *desc)
 {
 	k_thread_create(&alt_thread, alt_stack, STACK_SIZE,
@@ -435,6 +452,119 @@ ZTEST(ipi, test_thread_coop_no_ipis)
 	}
 }
 
+/**
+ * Verify that making several threads ready in a single operation sends
+ * no more than one IPI to each CPU.
+ */
+ZTEST(ipi, test_wake_all_one_ipi_per_cpu)
+{
+	uint32_t  set[CONFIG_MP_MAX_NUM_CPUS];
+	uint32_t  id;
+	int priority;
+	unsigned int i;
+
+	priority = k_thread_priority_get(k_current_get());
+	atomic_clear(&busy_started);
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&waiter_thread[i], waiter_stack[i], STACK_SIZE,
+				waiter_thread_entry, NULL, NULL, NULL,
+				priority - 1 - NUM_THREADS, 0, K_NO_WAIT);
+	}
+	waiter_threads_created = true;
+
+	id = busy_threads_create(priority - 1);
+
+	busy_threads_priority_set(0, 1);
+	k_busy_wait(DELAY_FOR_IPIS);
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		zassert_true(z_is_thread_pending(&waiter_thread[i]),
+			     "Waiter thread %u has not pended.\n", i);
+	}
+
+	/*
+	 * Waiter threads are pended. Current thread is cooperative.
+	 * Other CPUs are executing lower priority preemptible threads.
+	 */
+
+	clear_ipi_counts();
+	k_sem_reset(&wake_all_sem);
+	k_busy_wait(DELAY_FOR_IPIS);
+	get_ipi_counts(set, CONFIG_MP_MAX_NUM_CPUS);
+
+	alt_thread_done = true;
+
+	for (i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (i == id) {
+			continue;
+		}
+
+		zassert_true(set[i] == 1, "CPU%u got %u IPIs", i, set[i]);
+	}
+
+	zassert_true(set[id] == 0, "Current CPU got %u IPI(s).\n", set[id]);
+}
+
+/* Flag and send a scheduling IPI to <target>, with its in-flight bit set */
+static void send_ipi(uint32_t target, bool in_flight)
+{
+	int  key;
+
+	key = arch_irq_lock();
+	if (in_flight) {
+		atomic_set_bit(&_kernel.ipi_in_flight, target);
+	}
+	flag_ipi(BIT(target));
+	signal_pending_ipi();
+	arch_irq_unlock(key);
+}
+
+/**
+ * Verify that no scheduling IPI is sent to a CPU that has not yet started
+ * to process the one it was last sent, and that one is sent again once it
+ * has.
+ */
+ZTEST(ipi, test_ipi_in_flight_not_resent)
+{
+	uint32_t  set[CONFIG_MP_MAX_NUM_CPUS];
+	uint32_t  id;
+	uint32_t  target;
+	int  key;
+
+	if (!IS_ENABLED(CONFIG_SCHED_IPI_COALESCE)) {
+		ztest_test_skip();
+	}
+
+	key = arch_irq_lock();
+	id = _current_cpu->id;
+	arch_irq_unlock(key);
+
+	/* The test thread is cooperative, so it stays on this CPU */
+
+	target = (id + 1) % arch_num_cpus();
+
+	clear_ipi_counts();
+	send_ipi(target, true);
+	k_busy_wait(DELAY_FOR_IPIS);
+	get_ipi_counts(set, CONFIG_MP_MAX_NUM_CPUS);
+
+	zassert_true(atomic_test_bit(&_kernel.ipi_in_flight, target),
+		     "CPU%u in-flight bit was cleared", target);
+	zassert_true(set[target] == 0, "CPU%u got %u IPI(s) while one was in flight",
+		     target, set[target]);
+
+	atomic_clear_bit(&_kernel.ipi_in_flight, target);
+
+	send_ipi(target, false);
+	k_busy_wait(DELAY_FOR_IPIS);
+	get_ipi_counts(set, CONFIG_MP_MAX_NUM_CPUS);
+
+	zassert_true(set[target] == 1, "CPU%u got %u IPIs", target, set[target]);
+	zassert_false(atomic_test_bit(&_kernel.ipi_in_flight, target),
+		      "CPU%u in-flight bit was not cleared", target);
+}
+
 static void *ipi_tests_setup(void)
 {
 	/*
@@ -469,6 +599,13 @@ static void cleanup_threads(void *fixture)
 	}
 	alt_thread_created = false;
 
+	if (waiter_threads_created) {
+		for (i = 0; i < NUM_THREADS; i++) {
+			k_thread_abort(&waiter_thread[i]);
+		}
+	}
+	waiter_threads_created = false;
+
 	alt_thread_done = false;
 }
 
@@ -22,6 +22,9 @@ K_HEAP_DEFINE(k_heap_test, HEAP_SIZE);
 #define CALLOC_NUM   256
 #define CALLOC_SIZE  sizeof(uint32_t)
 
+/* Small enough to be kept in the sys_heap cache when it is enabled */
+#define DOUBLE_FREE_SIZE 32
+
 static void tIsr_kheap_alloc_nowait(void *data)
 {
 	ARG_UNUSED(data);
@@ -489,14 +492,15 @@ ZTEST(k_heap_api, test_k_heap_aligned_alloc)
  *
  * @ingroup k_heap_api_tests
  *
- * @details The test validates that double-freeing a pointer asserts
+ * @details The test validates that double-freeing a pointer asserts,
+ * including when the first free put it in the sys_heap cache.
  *
  * @see k_heap_alloc, k_heap_free()
  */
 ZTEST(k_heap_api, test_z_k_heap_double_free)
 {
 	k_timeout_t timeout = Z_TIMEOUT_US(TIMEOUT);
-	char *p = (char *)k_heap_alloc(&k_heap_test, ALLOC_SIZE_1, timeout);
+	char *p = (char *)k_heap_alloc(&k_heap_test, DOUBLE_FREE_SIZE, timeout);
 
 	zassert_not_null(p, "k_heap_alloc operation failed");
 
@@ -113,6 +113,14 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 	       stats->eviction.clean);
 	printk("    - Dirty pages evicted: %lu\n",
 	       stats->eviction.dirty);
+
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+	printk("* Clustering (%s):\n", scope);
+	printk("    - Pages read ahead: %lu\n", stats->cluster.readahead);
+	printk("    - Read-ahead hits: %lu\n", stats->cluster.readahead_hit);
+	printk("    - Read-ahead misses: %lu\n", stats->cluster.readahead_miss);
+	printk("    - Clustered page-outs: %lu\n", stats->cluster.pageout);
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 }
 
 static void touch_anon_pages(bool zig, bool zag)
@@ -236,12 +244,20 @@ static void test_k_mem_page_out(void)
 {
 	unsigned long faults;
 	int key, ret;
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+	struct k_mem_paging_stats_t stats;
+	unsigned long readahead;
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 
 	/* Lock IRQs to prevent other pagefaults from happening while we
 	 * are measuring stuff
 	 */
 	key = irq_lock();
 	faults = k_mem_num_pagefaults_get();
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+	k_mem_paging_stats_get(&stats);
+	readahead = stats.cluster.readahead;
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 	ret = k_mem_page_out(arena, HALF_BYTES);
 	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
 
@@ -250,11 +266,24 @@ static void test_k_mem_page_out(void)
 		arena[i] = nums[i % 10];
 	}
 	faults = k_mem_num_pagefaults_get() - faults;
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+	k_mem_paging_stats_get(&stats);
+	readahead = stats.cluster.readahead - readahead;
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 	irq_unlock(key);
 
+#ifdef CONFIG_DEMAND_PAGING_CLUSTER
+	/* Every evicted page was either faulted in or read ahead */
+	zassert_true(faults < HALF_PAGES,
+		     "no page was read ahead, got %lu pagefaults", faults);
+	zassert_true(faults + readahead >= HALF_PAGES,
+		     "unexpected num pagefaults %lu and read-aheads %lu",
+		     faults, readahead);
+#else
 	zassert_equal(faults, HALF_PAGES,
 		      "unexpected num pagefaults expected %d got %lu",
 		      HALF_PAGES, faults);
+#endif /* CONFIG_DEMAND_PAGING_CLUSTER */
 
 	ret = k_mem_page_out(arena, arena_size);
 	zassert_equal(ret, -ENOMEM, "k_mem_page_out should have failed");
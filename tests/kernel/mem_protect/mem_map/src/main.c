@@ -14,6 +14,11 @@
 #include <zephyr/kernel/mm/demand_paging.h>
 #endif /* CONFIG_DEMAND_PAGING */
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+#include <kernel_arch_interface.h>
+#include <x86_mmu.h>
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 /* 32-bit IA32 page tables have no mechanism to restrict execution */
 #if defined(CONFIG_X86) && !defined(CONFIG_X86_64) && !defined(CONFIG_X86_PAE)
 #define SKIP_EXECUTE_TESTS
@@ -579,6 +584,191 @@ ZTEST(mem_map_api, test_k_mem_map_user)
 #endif /* CONFIG_USERSPACE */
 }
 
+#ifdef CONFIG_X86_MMU_LARGE_PAGES
+#ifdef CONFIG_X86_64
+#define PT_LEVEL	3
+#else
+#define PT_LEVEL	2
+#endif
+
+#define LARGE_PAGE_SZ	MB(2)
+
+/* Only the page tables are examined, the memory itself is never accessed */
+#define LARGE_PHYS	0x40000000UL
+#define LARGE_PHYS_SZ	(2 * LARGE_PAGE_SZ)
+
+/* Page table level of the entry mapping a virtual address, or -1 if it is
+ * not mapped
+ */
+static int mapped_level(void *virt, pentry_t *entry)
+{
+	int level;
+
+	z_x86_pentry_get(&level, entry, z_x86_page_tables_get(), virt);
+
+	return ((*entry & MMU_P) != 0U) ? level : -1;
+}
+
+static void assert_large_page(uint8_t *virt)
+{
+	pentry_t entry;
+
+	zassert_equal(mapped_level(virt, &entry), PT_LEVEL - 1,
+		      "%p not mapped with a large page", virt);
+	zassert_true((entry & MMU_PS) != 0U);
+}
+
+static void assert_phys(uint8_t *virt, uintptr_t expected)
+{
+	uintptr_t phys;
+
+	zassert_ok(arch_page_phys_get(virt, &phys), "%p not mapped", virt);
+	zassert_equal(phys, expected, "%p maps 0x%lx, not 0x%lx", virt, phys,
+		      expected);
+}
+
+static uint8_t *large_map(uint32_t flags)
+{
+	uint8_t *mapped;
+
+	k_mem_map_phys_bare(&mapped, LARGE_PHYS, LARGE_PHYS_SZ, flags);
+	zassert_equal(POINTER_TO_UINT(mapped) % LARGE_PAGE_SZ, 0,
+		      "region at %p not aligned to a large page", mapped);
+	assert_large_page(mapped);
+	assert_large_page(mapped + LARGE_PAGE_SZ);
+
+	return mapped;
+}
+
+/**
+ * Show that arch_page_phys_get() adds the offset within a large page
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+ZTEST(mem_map_large_pages, test_large_page_phys_get)
+{
+	static const size_t offsets[] = {
+		0,
+		CONFIG_MMU_PAGE_SIZE,
+		LARGE_PAGE_SZ / 2,
+		LARGE_PAGE_SZ - CONFIG_MMU_PAGE_SIZE,
+		LARGE_PAGE_SZ,
+		LARGE_PAGE_SZ + (5 * CONFIG_MMU_PAGE_SIZE),
+		LARGE_PHYS_SZ - CONFIG_MMU_PAGE_SIZE,
+	};
+	uint8_t *mapped = large_map(BASE_FLAGS);
+
+	for (size_t i = 0; i < ARRAY_SIZE(offsets); i++) {
+		assert_phys(mapped + offsets[i], LARGE_PHYS + offsets[i]);
+	}
+
+	k_mem_unmap_phys_bare(mapped, LARGE_PHYS_SZ);
+
+	zassert_equal(arch_page_phys_get(mapped, NULL), -EFAULT);
+	zassert_equal(arch_page_phys_get(mapped + LARGE_PAGE_SZ, NULL), -EFAULT);
+}
+
+/**
+ * Show that un-mapping or updating part of a large page splits it, keeping
+ * the mappings of the rest of it
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+ZTEST(mem_map_large_pages, test_large_page_split)
+{
+	uint8_t *mapped = large_map(BASE_FLAGS);
+	uint8_t *second = mapped + LARGE_PAGE_SZ;
+	pentry_t entry;
+
+	/* Partial un-map of the first large page */
+	k_mem_unmap_phys_bare(mapped + CONFIG_MMU_PAGE_SIZE, CONFIG_MMU_PAGE_SIZE);
+
+	zassert_equal(mapped_level(mapped, &entry), PT_LEVEL,
+		      "large page not split");
+	zassert_equal(arch_page_phys_get(mapped + CONFIG_MMU_PAGE_SIZE, NULL),
+		      -EFAULT, "un-mapped page still present");
+	assert_phys(mapped, LARGE_PHYS);
+	assert_phys(mapped + (2 * CONFIG_MMU_PAGE_SIZE),
+		    LARGE_PHYS + (2 * CONFIG_MMU_PAGE_SIZE));
+	assert_phys(mapped + LARGE_PAGE_SZ - CONFIG_MMU_PAGE_SIZE,
+		    LARGE_PHYS + LARGE_PAGE_SZ - CONFIG_MMU_PAGE_SIZE);
+	assert_large_page(second);
+
+	/* Attribute update of one page of the second large page */
+	zassert_ok(k_mem_update_flags(second + CONFIG_MMU_PAGE_SIZE,
+				      CONFIG_MMU_PAGE_SIZE,
+				      BASE_FLAGS | K_MEM_PERM_RW));
+
+	zassert_equal(mapped_level(second + CONFIG_MMU_PAGE_SIZE, &entry),
+		      PT_LEVEL, "large page not split");
+	zassert_true((entry & MMU_RW) != 0U, "updated page not writable");
+	zassert_equal(mapped_level(second, &entry), PT_LEVEL);
+	zassert_true((entry & MMU_RW) == 0U, "neighbouring page writable");
+	zassert_equal(mapped_level(second + (2 * CONFIG_MMU_PAGE_SIZE), &entry),
+		      PT_LEVEL);
+	zassert_true((entry & MMU_RW) == 0U, "neighbouring page writable");
+	for (size_t offset = 0; offset < LARGE_PAGE_SZ;
+	     offset += CONFIG_MMU_PAGE_SIZE) {
+		assert_phys(second + offset, LARGE_PHYS + LARGE_PAGE_SZ + offset);
+	}
+
+	k_mem_unmap_phys_bare(mapped, CONFIG_MMU_PAGE_SIZE);
+	k_mem_unmap_phys_bare(mapped + (2 * CONFIG_MMU_PAGE_SIZE),
+			      LARGE_PHYS_SZ - (2 * CONFIG_MMU_PAGE_SIZE));
+}
+
+/**
+ * Show that un-mapping a whole large page puts a page table back in its
+ * place, so that the region can be mapped with a large page again
+ *
+ * On SMP the page table displaced by a large page is only reused once the
+ * other CPUs have handled the TLB shootdown, so this also goes through the
+ * reclaim of stale page tables.
+ *
+ * @ingroup kernel_memprotect_tests
+ */
+ZTEST(mem_map_large_pages, test_large_page_table_reuse)
+{
+	uint8_t *mapped = NULL;
+	uint8_t *mapped_old;
+	pentry_t entry;
+
+	for (int i = 0; i < 8; i++) {
+		mapped_old = mapped;
+		mapped = large_map(BASE_FLAGS);
+		if (mapped_old != NULL) {
+			zassert_equal(mapped, mapped_old,
+				      "virtual region not reclaimed");
+		}
+
+		/* Let the other CPUs handle the shootdown for the tables
+		 * the large pages displaced
+		 */
+		if (IS_ENABLED(CONFIG_SMP)) {
+			k_msleep(10);
+		}
+
+		k_mem_unmap_phys_bare(mapped, LARGE_PHYS_SZ);
+
+		for (size_t offset = 0; offset < LARGE_PHYS_SZ;
+		     offset += LARGE_PAGE_SZ) {
+			int level;
+
+			z_x86_pentry_get(&level, &entry,
+					 z_x86_page_tables_get(),
+					 mapped + offset);
+			zassert_true((entry & MMU_P) == 0U,
+				     "large page still mapped");
+			zassert_equal(level, PT_LEVEL,
+				      "no page table put back at %p",
+				      mapped + offset);
+		}
+	}
+}
+
+ZTEST_SUITE(mem_map_large_pages, NULL, NULL, NULL, NULL, NULL);
+#endif /* CONFIG_X86_MMU_LARGE_PAGES */
+
 /* ztest main entry*/
 void *mem_map_env_setup(void)
 {
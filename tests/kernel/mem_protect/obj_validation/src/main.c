@@ -11,6 +11,10 @@
 
 #define SEM_ARRAY_SIZE	16
 
+/* More threads than a dynamic object has permission links for */
+#define PERM_THREADS	(CONFIG_DYNAMIC_OBJECTS_PERM_LINKS + 3)
+#define PERM_STACK_SIZE	(512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
 /* Show that extern declarations don't interfere with detecting kernel
  * objects, this was at one point a problem.
  */
@@ -21,6 +25,9 @@ static struct k_sem *dyn_sem[SEM_ARRAY_SIZE];
 
 static struct k_mutex *test_dyn_mutex;
 
+static struct k_thread perm_thread[PERM_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(perm_stack, PERM_THREADS, PERM_STACK_SIZE);
+
 K_SEM_DEFINE(sem1, 0, 1);
 static struct k_sem sem2;
 static char bad_sem[sizeof(struct k_sem)];
@@ -183,6 +190,77 @@ ZTEST(object_validation, test_no_ref_dyn_kobj_release_mem)
 	zassert_true(ret == -EBADF, "Dynamic kernel object not released");
 }
 
+static void perm_thread_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+}
+
+static bool has_perm(struct k_object *ko, struct k_thread *thread)
+{
+	return sys_bitfield_test_bit((mem_addr_t)&ko->perms,
+				     k_object_find(thread)->data.thread_id);
+}
+
+/**
+ * @brief Test permissions of more threads than a dynamic object has links for
+ *
+ * @details
+ * - Grant permission on a dynamically allocated semaphore to more threads
+ *   than CONFIG_DYNAMIC_OBJECTS_PERM_LINKS.
+ * - Revoke them one by one, checking the other threads keep their
+ *   permission.
+ * - Abort the last thread having permission, and check its permission is
+ *   cleared so that the object gets released.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_access_grant(), k_object_access_revoke()
+ */
+ZTEST(object_validation, test_dyn_kobj_perms_overflow)
+{
+	struct k_sem *sem = k_object_alloc(K_OBJ_SEM);
+	struct k_object *ko;
+
+	zassert_not_null(sem, "Cannot allocate sem k_object");
+	ko = k_object_find(sem);
+
+	for (int i = 0; i < PERM_THREADS; i++) {
+		k_thread_create(&perm_thread[i], perm_stack[i], PERM_STACK_SIZE,
+				perm_thread_entry, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(0), 0, K_FOREVER);
+		k_object_access_grant(sem, &perm_thread[i]);
+	}
+
+	for (int i = 0; i < PERM_THREADS; i++) {
+		zassert_true(has_perm(ko, &perm_thread[i]),
+			     "thread %d has no permission", i);
+	}
+
+	/* Drop the permission of the current thread, which has a link */
+	k_object_access_revoke(sem, k_current_get());
+	zassert_false(has_perm(ko, k_current_get()));
+
+	for (int i = 0; i < (PERM_THREADS - 1); i++) {
+		k_object_access_revoke(sem, &perm_thread[i]);
+
+		for (int j = 0; j < PERM_THREADS; j++) {
+			zassert_equal(has_perm(ko, &perm_thread[j]), j > i,
+				      "wrong permission of thread %d", j);
+		}
+	}
+
+	/* Aborting the thread clears its permission, releasing the object */
+	k_thread_abort(&perm_thread[PERM_THREADS - 1]);
+	zassert_equal(k_object_validate(k_object_find(sem), K_OBJ_SEM, 0),
+		      -EBADF, "Dynamic kernel object not released");
+
+	for (int i = 0; i < (PERM_THREADS - 1); i++) {
+		k_thread_abort(&perm_thread[i]);
+	}
+}
+
 void *object_validation_setup(void)
 {
 	k_thread_system_pool_assign(k_current_get());
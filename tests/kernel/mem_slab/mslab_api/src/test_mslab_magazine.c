@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include "test_mslab.h"
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+
+/* Enough blocks for several magazine refills and flushes */
+#define MAG_BLK_NUM (CONFIG_MEM_SLAB_MAGAZINE_SIZE * 2)
+
+K_MEM_SLAB_DEFINE_STATIC(magslab, BLK_SIZE, MAG_BLK_NUM, BLK_ALIGN);
+
+static void *blocks[MAG_BLK_NUM];
+
+static void magslab_alloc_all(void)
+{
+	void *block;
+
+	for (int i = 0; i < MAG_BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&magslab, &blocks[i], K_NO_WAIT));
+		zassert_equal(k_mem_slab_num_used_get(&magslab), i + 1);
+		zassert_equal(k_mem_slab_num_free_get(&magslab), MAG_BLK_NUM - i - 1);
+	}
+
+	zassert_equal(k_mem_slab_alloc(&magslab, &block, K_NO_WAIT), -ENOMEM);
+}
+
+static void magslab_free_all(void)
+{
+	for (int i = 0; i < MAG_BLK_NUM; i++) {
+		k_mem_slab_free(&magslab, blocks[i]);
+		zassert_equal(k_mem_slab_num_used_get(&magslab), MAG_BLK_NUM - i - 1);
+		zassert_equal(k_mem_slab_num_free_get(&magslab), i + 1);
+	}
+}
+
+/**
+ * @brief Verify that blocks cached in magazines are reported as free and
+ * can all be allocated
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_api, test_mslab_magazine)
+{
+	struct sys_memory_stats stats;
+
+	magslab_alloc_all();
+	magslab_free_all();
+
+	/* Cached blocks must not be lost to a second round */
+	magslab_alloc_all();
+	magslab_free_all();
+
+	zassert_ok(k_mem_slab_runtime_stats_get(&magslab, &stats));
+	zassert_equal(stats.allocated_bytes, 0);
+	zassert_equal(stats.free_bytes, MAG_BLK_NUM * BLK_SIZE);
+
+#ifdef CONFIG_OBJ_CORE_STATS_MEM_SLAB
+	struct k_mem_slab_info raw;
+
+	zassert_ok(k_obj_core_stats_raw(K_OBJ_CORE(&magslab), &raw, sizeof(raw)));
+	zassert_equal(raw.num_used, 0);
+	zassert_true(raw.num_cached <= CONFIG_MEM_SLAB_MAGAZINE_SIZE);
+	zassert_true(raw.cache_hits > 0);
+	zassert_true(raw.cache_misses > 0);
+
+	zassert_ok(k_obj_core_stats_reset(K_OBJ_CORE(&magslab)));
+	zassert_ok(k_obj_core_stats_raw(K_OBJ_CORE(&magslab), &raw, sizeof(raw)));
+	zassert_equal(raw.cache_hits, 0);
+	zassert_equal(raw.cache_misses, 0);
+#endif /* CONFIG_OBJ_CORE_STATS_MEM_SLAB */
+}
+
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
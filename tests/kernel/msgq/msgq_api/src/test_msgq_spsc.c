@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#ifdef CONFIG_MSGQ_SPSC
+
+#define SPSC_LEN 3
+#define SPSC_ROUNDS 10
+
+K_MSGQ_SPSC_DEFINE(kmsgq_spsc, MSG_SIZE, SPSC_LEN, 4);
+static struct k_msgq msgq_spsc;
+static char __aligned(4) spsc_buffer[MSG_SIZE * SPSC_LEN];
+
+static K_THREAD_STACK_DEFINE(spsc_stack, STACK_SIZE);
+static struct k_thread spsc_thread;
+static K_SEM_DEFINE(spsc_sem, 0, 1);
+
+static void spsc_put_get(struct k_msgq *q)
+{
+	uint32_t tx = 0;
+	uint32_t rx;
+
+	/* Run enough rounds for both indices to wrap more than once */
+	for (int round = 0; round < SPSC_ROUNDS; round++) {
+		for (int i = 0; i < SPSC_LEN; i++) {
+			zassert_ok(k_msgq_put(q, &tx, K_NO_WAIT));
+			tx++;
+			zassert_equal(k_msgq_num_used_get(q), i + 1);
+			zassert_equal(k_msgq_num_free_get(q), SPSC_LEN - i - 1);
+		}
+		zassert_equal(k_msgq_put(q, &tx, K_NO_WAIT), -ENOMSG);
+
+		for (int i = 0; i < SPSC_LEN; i++) {
+			zassert_ok(k_msgq_peek_at(q, &rx, i));
+			zassert_equal(rx, tx - SPSC_LEN + i);
+		}
+		zassert_equal(k_msgq_peek_at(q, &rx, SPSC_LEN), -ENOMSG);
+
+		/* Leave one message behind so the next round is offset */
+		for (int i = 0; i < SPSC_LEN - 1; i++) {
+			zassert_ok(k_msgq_get(q, &rx, K_NO_WAIT));
+			zassert_equal(rx, tx - SPSC_LEN + i);
+		}
+		zassert_ok(k_msgq_peek(q, &rx));
+		zassert_equal(rx, tx - 1);
+		zassert_ok(k_msgq_get(q, &rx, K_NO_WAIT));
+		zassert_equal(rx, tx - 1);
+	}
+
+	zassert_equal(k_msgq_get(q, &rx, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get(q, &rx, TIMEOUT), -EAGAIN);
+	zassert_equal(k_msgq_put_front(q, &tx), -ENOTSUP);
+}
+
+/**
+ * @brief Test put, get and peek on single producer single consumer queues
+ * @see k_msgq_spsc_init(), K_MSGQ_SPSC_DEFINE()
+ */
+ZTEST(msgq_api, test_msgq_spsc_put_get)
+{
+	k_msgq_spsc_init(&msgq_spsc, spsc_buffer, MSG_SIZE, SPSC_LEN);
+	spsc_put_get(&msgq_spsc);
+	spsc_put_get(&kmsgq_spsc);
+}
+
+static void spsc_consumer_entry(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+	uint32_t rx;
+
+	for (uint32_t i = 0; i < (SPSC_LEN * SPSC_ROUNDS); i++) {
+		zassert_ok(k_msgq_get(q, &rx, K_FOREVER));
+		zassert_equal(rx, i);
+	}
+
+	k_sem_give(&spsc_sem);
+}
+
+/**
+ * @brief Test a consumer blocking on an empty queue and a producer
+ * blocking on a full one
+ * @see k_msgq_spsc_init(), k_msgq_put(), k_msgq_get()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_spsc_pend)
+{
+	k_tid_t tid;
+
+	k_msgq_spsc_init(&msgq_spsc, spsc_buffer, MSG_SIZE, SPSC_LEN);
+
+	/* The consumer runs first and pends on the empty queue */
+	tid = k_thread_create(&spsc_thread, spsc_stack, STACK_SIZE,
+			      spsc_consumer_entry, &msgq_spsc, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	for (uint32_t i = 0; i < SPSC_LEN; i++) {
+		zassert_ok(k_msgq_put(&msgq_spsc, &i, K_FOREVER));
+	}
+
+	/* Keep the consumer away so that the producer has to pend */
+	k_thread_suspend(tid);
+	for (uint32_t i = SPSC_LEN; i < (SPSC_LEN * SPSC_ROUNDS); i++) {
+		if (k_msgq_num_free_get(&msgq_spsc) == 0U) {
+			k_thread_resume(tid);
+		}
+		zassert_ok(k_msgq_put(&msgq_spsc, &i, K_FOREVER));
+	}
+
+	zassert_ok(k_sem_take(&spsc_sem, K_FOREVER));
+	k_thread_join(tid, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&msgq_spsc), 0);
+}
+
+static void spsc_isr_entry(const void *p)
+{
+	struct k_msgq *q = (struct k_msgq *)p;
+
+	for (uint32_t i = 0; i < SPSC_LEN; i++) {
+		zassert_ok(k_msgq_put(q, &i, K_NO_WAIT));
+	}
+}
+
+/**
+ * @brief Test an ISR producing for a thread, and purging by the consumer
+ * @see k_msgq_spsc_init(), k_msgq_purge()
+ */
+ZTEST(msgq_api, test_msgq_spsc_isr)
+{
+	uint32_t rx;
+
+	k_msgq_spsc_init(&msgq_spsc, spsc_buffer, MSG_SIZE, SPSC_LEN);
+
+	irq_offload(spsc_isr_entry, &msgq_spsc);
+	zassert_ok(k_msgq_get(&msgq_spsc, &rx, K_NO_WAIT));
+	zassert_equal(rx, 0);
+
+	k_msgq_purge(&msgq_spsc);
+	zassert_equal(k_msgq_num_used_get(&msgq_spsc), 0);
+	zassert_equal(k_msgq_num_free_get(&msgq_spsc), SPSC_LEN);
+
+	irq_offload(spsc_isr_entry, &msgq_spsc);
+	for (uint32_t i = 0; i < SPSC_LEN; i++) {
+		zassert_ok(k_msgq_get(&msgq_spsc, &rx, K_NO_WAIT));
+		zassert_equal(rx, i);
+	}
+}
+
+#endif /* CONFIG_MSGQ_SPSC */
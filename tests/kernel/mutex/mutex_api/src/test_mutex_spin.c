@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+
+#define SPIN_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define SPIN_ROUNDS 100
+
+static K_THREAD_STACK_DEFINE(spin_stack, SPIN_STACK_SIZE);
+static struct k_thread spin_thread;
+static struct k_mutex spin_mutex;
+static K_SEM_DEFINE(spin_locked, 0, SPIN_ROUNDS);
+static volatile uint32_t spin_counter;
+static int owner_prio;
+
+/* Hold the mutex for short busy periods, as a running owner would */
+static void busy_owner_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < SPIN_ROUNDS; i++) {
+		zassert_ok(k_mutex_lock(&spin_mutex, K_FOREVER));
+		k_sem_give(&spin_locked);
+		k_busy_wait(CONFIG_MUTEX_ADAPTIVE_SPIN_US / 2);
+		spin_counter++;
+		zassert_ok(k_mutex_unlock(&spin_mutex));
+	}
+}
+
+/**
+ * @brief Test locking a mutex held by a thread running on another CPU
+ *
+ * @ingroup kernel_mutex_tests
+ *
+ * @see k_mutex_lock()
+ */
+ZTEST(mutex_api, test_mutex_adaptive_spin_running_owner)
+{
+	if (arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+	k_mutex_init(&spin_mutex);
+	k_sem_reset(&spin_locked);
+	spin_counter = 0;
+
+	k_thread_create(&spin_thread, spin_stack, SPIN_STACK_SIZE,
+			busy_owner_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	for (int i = 0; i < SPIN_ROUNDS; i++) {
+		zassert_ok(k_sem_take(&spin_locked, K_FOREVER));
+		zassert_ok(k_mutex_lock(&spin_mutex, K_FOREVER));
+		spin_counter++;
+		zassert_ok(k_mutex_unlock(&spin_mutex));
+	}
+
+	k_thread_join(&spin_thread, K_FOREVER);
+	zassert_equal(spin_counter, 2 * SPIN_ROUNDS);
+}
+
+/* Hold the mutex while sleeping, which must stop waiters from spinning */
+static void sleeping_owner_entry(void *p1, void *p2, void *p3)
+{
+	zassert_ok(k_mutex_lock(&spin_mutex, K_FOREVER));
+	k_sem_give(&spin_locked);
+	k_msleep(100);
+	owner_prio = k_thread_priority_get(k_current_get());
+	zassert_ok(k_mutex_unlock(&spin_mutex));
+}
+
+/**
+ * @brief Test that a waiter falls back to pending, with priority
+ * inheritance, when the owner of the mutex is not running
+ *
+ * @ingroup kernel_mutex_tests
+ *
+ * @see k_mutex_lock()
+ */
+ZTEST(mutex_api, test_mutex_adaptive_spin_sleeping_owner)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	k_mutex_init(&spin_mutex);
+	k_sem_reset(&spin_locked);
+
+	k_thread_create(&spin_thread, spin_stack, SPIN_STACK_SIZE,
+			sleeping_owner_entry, NULL, NULL, NULL,
+			prio + 1, 0, K_NO_WAIT);
+
+	zassert_ok(k_sem_take(&spin_locked, K_FOREVER));
+	zassert_equal(k_mutex_lock(&spin_mutex, K_MSEC(10)), -EAGAIN);
+	zassert_ok(k_mutex_lock(&spin_mutex, K_FOREVER));
+	zassert_equal(owner_prio, prio);
+	zassert_ok(k_mutex_unlock(&spin_mutex));
+
+	k_thread_join(&spin_thread, K_FOREVER);
+}
+
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
@@ -0,0 +1,214 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+ZTEST_SUITE(k_pipe_claim, NULL, NULL, NULL, NULL, NULL);
+
+#define CLAIM_BUFFER_SIZE 12
+static const int claim_wait_time = 2000;
+
+static struct k_thread thread;
+static K_THREAD_STACK_DEFINE(stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_pipe pipe;
+static uint8_t buffer[CLAIM_BUFFER_SIZE];
+static uint8_t input[CLAIM_BUFFER_SIZE];
+
+static void mkrandom(uint8_t *data, size_t size)
+{
+	sys_rand_get(data, size);
+}
+
+ZTEST(k_pipe_claim, test_claim_write_read)
+{
+	uint8_t *data;
+
+	mkrandom(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_read_claim(&pipe, &data, 1, K_NO_WAIT) == -EAGAIN,
+		"Should not be able to claim data in an empty pipe");
+	zassert_true(k_pipe_write_claim(&pipe, &data, 0, K_NO_WAIT) == -EINVAL,
+		"Should not be able to claim nothing");
+
+	zassert_true(k_pipe_write_claim(&pipe, &data, 8, K_NO_WAIT) == 8,
+		"Failed to claim space in pipe");
+	memcpy(data, input, 8);
+
+	/* Nothing is visible to readers until the write is finished */
+	zassert_true(k_pipe_read_claim(&pipe, &data, 8, K_NO_WAIT) == -EAGAIN,
+		"Claimed space should not be readable");
+	zassert_true(k_pipe_write_finish(&pipe, 9) == -EINVAL,
+		"Should not be able to finish more than was claimed");
+	zassert_true(k_pipe_write_finish(&pipe, 8) == 0, "Failed to finish write");
+	zassert_true(k_pipe_write_finish(&pipe, 0) == -EINVAL,
+		"Should not be able to finish without a claim");
+
+	zassert_true(k_pipe_read_claim(&pipe, &data, 16, K_NO_WAIT) == 8,
+		"Failed to claim data in pipe");
+	zassert_true(data == buffer, "Data should be read in place");
+	zassert_true(memcmp(data, input, 8) == 0, "Unexpected data claimed from pipe");
+	zassert_true(k_pipe_read_finish(&pipe, 5) == 0, "Failed to finish read");
+
+	/* What was not consumed is claimed again */
+	zassert_true(k_pipe_read_claim(&pipe, &data, 16, K_NO_WAIT) == 3,
+		"Failed to claim remaining data in pipe");
+	zassert_true(memcmp(data, &input[5], 3) == 0, "Unexpected data claimed from pipe");
+	zassert_true(k_pipe_read_finish(&pipe, 3) == 0, "Failed to finish read");
+	zassert_true(k_pipe_read_finish(&pipe, 0) == -EINVAL,
+		"Should not be able to finish without a claim");
+}
+
+ZTEST(k_pipe_claim, test_claim_wrap_around)
+{
+	uint8_t *data;
+	uint8_t res[CLAIM_BUFFER_SIZE];
+
+	mkrandom(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_write(&pipe, input, 8, K_NO_WAIT) == 8,
+		"Failed to write bytes to pipe");
+	zassert_true(k_pipe_read(&pipe, res, 8, K_NO_WAIT) == 8,
+		"Failed to read bytes from pipe");
+
+	/* Free space wraps around the end of the ring buffer */
+	zassert_true(k_pipe_write_claim(&pipe, &data, 8, K_NO_WAIT) == 4,
+		"Claim should stop at the end of the ring buffer");
+	memcpy(data, input, 4);
+	zassert_true(k_pipe_write_finish(&pipe, 4) == 0, "Failed to finish write");
+	zassert_true(k_pipe_write_claim(&pipe, &data, 4, K_NO_WAIT) == 4,
+		"Failed to claim space at the start of the ring buffer");
+	zassert_true(data == buffer, "Claim should continue at the start of the ring buffer");
+	memcpy(data, &input[4], 4);
+	zassert_true(k_pipe_write_finish(&pipe, 4) == 0, "Failed to finish write");
+
+	/* Claimed and copied data interleave */
+	zassert_true(k_pipe_read(&pipe, res, 8, K_NO_WAIT) == 8,
+		"Failed to read bytes from pipe");
+	zassert_true(memcmp(res, input, 8) == 0, "Unexpected data received from pipe");
+}
+
+ZTEST(k_pipe_claim, test_claim_busy)
+{
+	uint8_t *data;
+	uint8_t *other;
+	uint8_t res;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_write_claim(&pipe, &data, 4, K_NO_WAIT) == 4,
+		"Failed to claim space in pipe");
+	zassert_true(k_pipe_write_claim(&pipe, &other, 4, K_NO_WAIT) == -EBUSY,
+		"Only one write claim should be allowed");
+	zassert_true(k_pipe_write(&pipe, input, 1, K_NO_WAIT) == -EBUSY,
+		"Should not be able to write while space is claimed");
+	zassert_true(k_pipe_write_finish(&pipe, 4) == 0, "Failed to finish write");
+
+	zassert_true(k_pipe_read_claim(&pipe, &data, 2, K_NO_WAIT) == 2,
+		"Failed to claim data in pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &other, 2, K_NO_WAIT) == -EBUSY,
+		"Only one read claim should be allowed");
+	zassert_true(k_pipe_read(&pipe, &res, 1, K_NO_WAIT) == -EBUSY,
+		"Should not be able to read while data is claimed");
+
+	/* Writers and readers do not get in each other's way */
+	zassert_true(k_pipe_write(&pipe, input, 1, K_NO_WAIT) == 1,
+		"Failed to write while data is claimed");
+	zassert_true(k_pipe_read_finish(&pipe, 2) == 0, "Failed to finish read");
+}
+
+ZTEST(k_pipe_claim, test_claim_reset_close)
+{
+	uint8_t *data;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	zassert_true(k_pipe_write_claim(&pipe, &data, 4, K_NO_WAIT) == 4,
+		"Failed to claim space in pipe");
+	k_pipe_reset(&pipe);
+	zassert_true(k_pipe_write_finish(&pipe, 4) == -EINVAL,
+		"A reset should cancel claims");
+
+	zassert_true(k_pipe_write(&pipe, input, 4, K_NO_WAIT) == 4,
+		"Failed to write bytes to pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &data, 2, K_NO_WAIT) == 2,
+		"Failed to claim data in pipe");
+	k_pipe_close(&pipe);
+
+	/* Data claimed before closing can still be consumed */
+	zassert_true(k_pipe_read_finish(&pipe, 2) == 0, "Failed to finish read");
+	zassert_true(k_pipe_write_claim(&pipe, &data, 4, K_NO_WAIT) == -EPIPE,
+		"Should not be able to claim space in a closed pipe");
+	zassert_true(k_pipe_read_claim(&pipe, &data, 4, K_NO_WAIT) == 2,
+		"Failed to claim remaining data in closed pipe");
+	zassert_true(k_pipe_read_finish(&pipe, 2) == 0, "Failed to finish read");
+	zassert_true(k_pipe_read_claim(&pipe, &data, 4, K_NO_WAIT) == -EPIPE,
+		"Should not be able to claim data in an empty closed pipe");
+}
+
+static void thread_claim_write(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *data;
+	int rc;
+
+	rc = k_pipe_write_claim((struct k_pipe *)arg1, &data, sizeof(input),
+				K_MSEC(claim_wait_time));
+	zassert_true(rc > 0, "Failed to claim space in pipe");
+	memcpy(data, input, rc);
+	zassert_true(k_pipe_write_finish((struct k_pipe *)arg1, rc) == 0,
+		"Failed to finish write");
+}
+
+ZTEST(k_pipe_claim, test_claim_read_wakeup)
+{
+	k_tid_t tid;
+	uint8_t *data;
+
+	mkrandom(input, sizeof(input));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_claim_write, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+	zassert_true(k_pipe_read_claim(&pipe, &data, sizeof(input),
+		K_MSEC(claim_wait_time)) == sizeof(input),
+		"Reader should be woken up by a finished write");
+	zassert_true(memcmp(data, input, sizeof(input)) == 0,
+		"Unexpected data claimed from pipe");
+	zassert_true(k_pipe_read_finish(&pipe, sizeof(input)) == 0, "Failed to finish read");
+	k_thread_join(tid, K_FOREVER);
+}
+
+static void thread_claim_read(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *data;
+
+	zassert_true(k_pipe_read_claim((struct k_pipe *)arg1, &data, 4,
+		K_MSEC(claim_wait_time)) == 4, "Failed to claim data in pipe");
+	zassert_true(k_pipe_read_finish((struct k_pipe *)arg1, 4) == 0,
+		"Failed to finish read");
+}
+
+ZTEST(k_pipe_claim, test_claim_write_wakeup)
+{
+	k_tid_t tid;
+	uint8_t *data;
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_true(k_pipe_write(&pipe, input, sizeof(input), K_NO_WAIT) == sizeof(input),
+		"Failed to fill pipe");
+
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_claim_read, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_true(tid, "k_thread_create failed");
+	zassert_true(k_pipe_write_claim(&pipe, &data, sizeof(input),
+		K_MSEC(claim_wait_time)) == 4,
+		"Writer should be woken up by a finished read");
+	zassert_true(k_pipe_write_finish(&pipe, 0) == 0, "Failed to cancel write");
+	k_thread_join(tid, K_FOREVER);
+}
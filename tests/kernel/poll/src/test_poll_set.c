@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#ifdef CONFIG_POLL_SET
+
+#define NUM_SIGNALS 32
+#define SET_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_poll_set set;
+static struct k_poll_signal signals[NUM_SIGNALS];
+static struct k_poll_event signal_events[NUM_SIGNALS];
+static struct k_poll_event sem_event;
+static struct k_poll_event fifo_event;
+static struct k_poll_event *ready[NUM_SIGNALS];
+
+static K_SEM_DEFINE(set_sem, 0, 1);
+static K_FIFO_DEFINE(set_fifo);
+
+static K_THREAD_STACK_DEFINE(set_stack, SET_STACK_SIZE);
+static struct k_thread set_thread;
+
+static void set_init_signals(void)
+{
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < NUM_SIGNALS; i++) {
+		k_poll_signal_init(&signals[i]);
+		k_poll_event_init(&signal_events[i], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &signals[i]);
+		signal_events[i].tag = i;
+		zassert_ok(k_poll_set_add(&set, &signal_events[i]));
+	}
+}
+
+static void set_remove_signals(void)
+{
+	for (int i = 0; i < NUM_SIGNALS; i++) {
+		zassert_ok(k_poll_set_remove(&set, &signal_events[i]));
+	}
+}
+
+/**
+ * @brief Test that only the raised events of a set are returned, and that
+ * they are returned for as long as they stay signaled
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait(), k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_level)
+{
+	set_init_signals();
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SIGNALS, K_NO_WAIT), -EAGAIN);
+	zassert_equal(k_poll_set_wait(&set, ready, 0, K_NO_WAIT), -EINVAL);
+
+	zassert_ok(k_poll_signal_raise(&signals[3], 3));
+	zassert_ok(k_poll_signal_raise(&signals[17], 17));
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SIGNALS, K_NO_WAIT), 2);
+	zassert_equal(ready[0]->tag, 3);
+	zassert_equal(ready[1]->tag, 17);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED);
+
+	/* Still signaled, so returned again, one at a time if asked to */
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal(ready[0]->tag, 3);
+	k_poll_signal_reset(&signals[3]);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal(ready[0]->tag, 17);
+	k_poll_signal_reset(&signals[17]);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SIGNALS, K_MSEC(10)), -EAGAIN);
+	zassert_equal(signal_events[3].state, K_POLL_STATE_NOT_READY);
+
+	set_remove_signals();
+}
+
+/**
+ * @brief Test adding and removing events
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_add_remove)
+{
+	struct k_poll_set other;
+
+	set_init_signals();
+	k_poll_set_init(&other);
+
+	zassert_equal(k_poll_set_add(&set, &signal_events[0]), -EBUSY);
+	zassert_equal(k_poll_set_add(&other, &signal_events[0]), -EBUSY);
+	zassert_equal(k_poll_set_remove(&other, &signal_events[0]), -EINVAL);
+
+	/* Removed events are never returned, wherever they are queued */
+	zassert_ok(k_poll_signal_raise(&signals[0], 0));
+	zassert_ok(k_poll_signal_raise(&signals[1], 1));
+	zassert_ok(k_poll_set_remove(&set, &signal_events[0]));
+	zassert_equal(k_poll_set_remove(&set, &signal_events[0]), -EINVAL);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SIGNALS, K_NO_WAIT), 1);
+	zassert_equal(ready[0]->tag, 1);
+	zassert_ok(k_poll_set_remove(&set, &signal_events[1]));
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SIGNALS, K_NO_WAIT), -EAGAIN);
+
+	/* An event already ready when added is returned right away */
+	zassert_ok(k_poll_set_add(&other, &signal_events[0]));
+	zassert_equal(k_poll_set_wait(&other, ready, NUM_SIGNALS, K_NO_WAIT), 1);
+	zassert_equal(ready[0], &signal_events[0]);
+	zassert_ok(k_poll_set_remove(&other, &signal_events[0]));
+
+	for (int i = 2; i < NUM_SIGNALS; i++) {
+		zassert_ok(k_poll_set_remove(&set, &signal_events[i]));
+	}
+}
+
+static void set_giver_entry(void *p1, void *p2, void *p3)
+{
+	static struct {
+		void *private;
+		uint32_t msg;
+	} msg;
+
+	k_sem_give(&set_sem);
+	k_msleep(10);
+	k_fifo_put(&set_fifo, &msg);
+}
+
+/**
+ * @brief Test a thread waiting on a set of kernel objects
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	k_poll_set_init(&set);
+	k_poll_event_init(&sem_event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_sem);
+	k_poll_event_init(&fifo_event, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	zassert_ok(k_poll_set_add(&set, &sem_event));
+	zassert_ok(k_poll_set_add(&set, &fifo_event));
+
+	k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			set_giver_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_MSEC(10));
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SIGNALS, K_FOREVER), 1);
+	zassert_equal(ready[0], &sem_event);
+	zassert_equal(sem_event.state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_ok(k_sem_take(&set_sem, K_NO_WAIT));
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SIGNALS, K_FOREVER), 1);
+	zassert_equal(ready[0], &fifo_event);
+	zassert_equal(fifo_event.state, K_POLL_STATE_FIFO_DATA_AVAILABLE);
+	zassert_not_null(k_fifo_get(&set_fifo, K_NO_WAIT));
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SIGNALS, K_MSEC(10)), -EAGAIN);
+
+	k_thread_join(&set_thread, K_FOREVER);
+	zassert_ok(k_poll_set_remove(&set, &sem_event));
+	zassert_ok(k_poll_set_remove(&set, &fifo_event));
+}
+
+#endif /* CONFIG_POLL_SET */
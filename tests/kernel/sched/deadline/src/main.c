@@ -321,4 +321,137 @@ ZTEST(suite_deadline, test_thread_reschedule)
 }
 #endif /* CONFIG_MP_MAX_NUM_CPUS == 1 */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+static void cbs_idle_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+}
+
+/**
+ * @brief Validate CBS admission control
+ *
+ * @details Reservations with a budget larger than their period are
+ * invalid, and reservations that would take the total bandwidth over
+ * CONFIG_SCHED_DEADLINE_CBS_MAX_UTILIZATION are refused until some
+ * bandwidth is released, either explicitly or by aborting a thread.
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(suite_deadline, test_cbs_admission)
+{
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		worker_tids[i] = k_thread_create(&worker_threads[i],
+				worker_stacks[i], STACK_SIZE,
+				cbs_idle_worker, NULL, NULL, NULL,
+				K_LOWEST_APPLICATION_THREAD_PRIO,
+				0, K_FOREVER);
+	}
+
+	zassert_equal(k_thread_cbs_set(worker_tids[0], 2000, 1000), -EINVAL,
+		      "budget larger than period accepted");
+	zassert_equal(k_thread_cbs_set(worker_tids[0], 1000, 0), -EINVAL,
+		      "zero period accepted");
+
+	zassert_equal(k_thread_cbs_set(worker_tids[0], 50000, 100000), 0,
+		      "reservation refused");
+	zassert_equal(k_thread_cbs_set(worker_tids[1], 50000, 100000), -EBUSY,
+		      "over-utilization accepted");
+
+	/* Changing a reservation only accounts for the difference */
+	zassert_equal(k_thread_cbs_set(worker_tids[0], 40000, 100000), 0,
+		      "reservation change refused");
+	zassert_equal(k_thread_cbs_set(worker_tids[1], 50000, 100000), 0,
+		      "reservation refused");
+
+	/* Released bandwidth is available again */
+	zassert_equal(k_thread_cbs_set(worker_tids[0], 0, 0), 0,
+		      "reservation not removed");
+	k_thread_abort(worker_tids[1]);
+	zassert_equal(k_thread_cbs_set(worker_tids[2], 90000, 100000), 0,
+		      "bandwidth not released");
+
+	k_thread_abort(worker_tids[0]);
+	k_thread_abort(worker_tids[2]);
+}
+
+static void cbs_busy_worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_busy_wait(POINTER_TO_UINT(p1));
+
+	/* Block rather than exit, exiting drops the reservation */
+	k_sleep(K_FOREVER);
+}
+
+/**
+ * @brief Validate CBS budget overrun accounting
+ *
+ * @details A thread running for several times its budget has its deadline
+ * postponed each time the budget is used up, and each of these overruns is
+ * reported in its runtime statistics.
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(suite_deadline, test_cbs_overrun)
+{
+	k_thread_runtime_stats_t stats;
+
+	worker_tids[0] = k_thread_create(&worker_threads[0],
+			worker_stacks[0], STACK_SIZE,
+			cbs_busy_worker, UINT_TO_POINTER(100000), NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO,
+			0, K_FOREVER);
+
+	zassert_equal(k_thread_cbs_set(worker_tids[0], 10000, 50000), 0,
+		      "reservation refused");
+	k_thread_start(worker_tids[0]);
+
+	k_sleep(K_MSEC(200));
+
+	k_thread_runtime_stats_get(worker_tids[0], &stats);
+	zassert_true(stats.budget_overruns > 0, "no budget overrun reported");
+	zassert_equal(stats.deadline_misses, 0, "unexpected deadline miss");
+
+	k_thread_abort(worker_tids[0]);
+}
+
+/**
+ * @brief Validate CBS deadline miss accounting
+ *
+ * @details A thread kept from running past its deadline by a thread of
+ * higher static priority has a deadline miss reported when it blocks.
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(suite_deadline, test_cbs_deadline_miss)
+{
+	k_thread_runtime_stats_t stats;
+
+	worker_tids[0] = k_thread_create(&worker_threads[0],
+			worker_stacks[0], STACK_SIZE,
+			cbs_busy_worker, UINT_TO_POINTER(1000), NULL, NULL,
+			K_LOWEST_APPLICATION_THREAD_PRIO,
+			0, K_FOREVER);
+
+	zassert_equal(k_thread_cbs_set(worker_tids[0], 10000, 50000), 0,
+		      "reservation refused");
+	k_thread_start(worker_tids[0]);
+
+	/* Hog the CPU for longer than the period of the worker */
+	k_busy_wait(100000);
+	k_sleep(K_MSEC(50));
+
+	k_thread_runtime_stats_get(worker_tids[0], &stats);
+	zassert_equal(stats.deadline_misses, 1, "deadline miss not reported");
+
+	k_thread_abort(worker_tids[0]);
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 ZTEST_SUITE(suite_deadline, NULL, NULL, NULL, NULL, NULL);
@@ -1234,6 +1234,68 @@ ZTEST(smp, test_smp_affinity)
 		k_thread_join(&tthread[i], K_FOREVER);
 	}
 }
+
+static volatile int repin_cpu;
+static volatile bool repin_done;
+
+static void repin_entry(void *arg0, void *arg1, void *arg2)
+{
+	ARG_UNUSED(arg0);
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	k_thread_suspend(k_current_get());
+	repin_cpu = curr_cpu();
+}
+
+static void repin_busy_entry(void *arg0, void *arg1, void *arg2)
+{
+	ARG_UNUSED(arg0);
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	while (!repin_done) {
+		k_yield();
+	}
+}
+
+/**
+ * @brief Test that a thread pinned to another CPU runs there
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Run a thread on CPU 1, pin it to CPU 0 while it is suspended,
+ *          then resume it while CPU 0 runs a thread of the same priority.
+ *          The thread must run on CPU 0 rather than wait on CPU 1.
+ */
+ZTEST(smp, test_smp_affinity_repin)
+{
+	k_thread_create(&tthread[0], tstack[0], STACK_SIZE, repin_entry,
+			NULL, NULL, NULL, EQUAL_PRIORITY, 0, K_FOREVER);
+	k_thread_cpu_pin(&tthread[0], 1);
+	k_thread_start(&tthread[0]);
+
+	/* Sleep, this thread may be on CPU 1 */
+	k_sleep(K_USEC(DELAY_US));
+	zassert_true(z_is_thread_suspended(&tthread[0]), "thread did not run on CPU 1");
+
+	zassert_ok(k_thread_cpu_pin(&tthread[0], 0), "could not pin a suspended thread");
+
+	repin_cpu = -1;
+	repin_done = false;
+	k_thread_create(&tthread[1], tstack[1], STACK_SIZE, repin_busy_entry,
+			NULL, NULL, NULL, EQUAL_PRIORITY, 0, K_FOREVER);
+	k_thread_cpu_pin(&tthread[1], 0);
+	k_thread_start(&tthread[1]);
+
+	k_thread_resume(&tthread[0]);
+	zassert_ok(k_thread_join(&tthread[0], K_MSEC(TIMEOUT)),
+		   "repinned thread did not run");
+	zassert_equal(repin_cpu, 0, "repinned thread ran on CPU %d", repin_cpu);
+
+	repin_done = true;
+	k_thread_join(&tthread[1], K_FOREVER);
+}
 #endif
 
 static void *smp_tests_setup(void)
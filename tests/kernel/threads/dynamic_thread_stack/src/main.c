@@ -168,6 +168,51 @@ ZTEST(dynamic_thread_stack, test_dynamic_thread_stack_alloc)
 	}
 }
 
+/** @brief Check that released dynamic threads are reused with a clean stack */
+ZTEST(dynamic_thread_stack, test_dynamic_thread_recycle)
+{
+	size_t fresh_unused;
+	size_t unused;
+	k_tid_t tid;
+	k_tid_t tid2;
+
+	if (!IS_ENABLED(CONFIG_DYNAMIC_THREAD_ALLOC)) {
+		ztest_test_skip();
+	}
+
+	if (IS_ENABLED(CONFIG_USERSPACE)) {
+		zassert_is_null(k_thread_dynamic_create(CONFIG_DYNAMIC_THREAD_STACK_SIZE,
+							func, &tflag[0], NULL, NULL, 0,
+							K_USER, K_NO_WAIT));
+	}
+
+	tflag[0] = false;
+	tid = k_thread_dynamic_create(CONFIG_DYNAMIC_THREAD_STACK_SIZE, func,
+				      &tflag[0], NULL, NULL, 0, 0, K_FOREVER);
+	zassert_not_null(tid);
+	zassert_ok(k_thread_stack_space_get(tid, &fresh_unused));
+
+	zassert_equal(k_thread_dynamic_release(tid), -EBUSY);
+
+	k_thread_start(tid);
+	zassert_ok(k_thread_join(tid, K_MSEC(TIMEOUT_MS)));
+	zassert_true(tflag[0]);
+	zassert_ok(k_thread_dynamic_release(tid));
+
+	/* The released thread and stack are reused, as if never used */
+	tflag[0] = false;
+	tid2 = k_thread_dynamic_create(CONFIG_DYNAMIC_THREAD_STACK_SIZE, func,
+				       &tflag[0], NULL, NULL, 0, 0, K_FOREVER);
+	zassert_equal(tid2, tid);
+	zassert_ok(k_thread_stack_space_get(tid2, &unused));
+	zassert_equal(unused, fresh_unused);
+
+	k_thread_start(tid2);
+	zassert_ok(k_thread_join(tid2, K_MSEC(TIMEOUT_MS)));
+	zassert_true(tflag[0]);
+	zassert_ok(k_thread_dynamic_release(tid2));
+}
+
 K_SEM_DEFINE(perm_sem, 0, 1);
 ZTEST_BMEM static volatile bool expect_fault;
 ZTEST_BMEM static volatile unsigned int expected_reason;
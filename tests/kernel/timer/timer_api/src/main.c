@@ -901,6 +901,136 @@ ZTEST_USER(timer_api, test_sleep_abs)
 
 }
 
+static void wait_ticks(uint32_t ticks)
+{
+	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
+		k_sleep(K_TICKS(ticks));
+	} else {
+		uint32_t wait_us = k_ticks_to_us_ceil32(ticks);
+
+		k_busy_wait(wait_us + (wait_us * BUSY_TICK_SLEW_PPM) / PPM_DIVISOR);
+	}
+}
+
+#define BATCH_TIMERS 4
+
+static struct k_timer batch_timer[BATCH_TIMERS];
+static int64_t batch_expiry[BATCH_TIMERS];
+static int batch_expired;
+
+static void batch_expire(struct k_timer *timer)
+{
+	int i = timer - batch_timer;
+
+	batch_expiry[i] = k_uptime_ticks();
+	batch_expired++;
+
+	/* Restart the next timer, which is due on the same tick */
+	if (i == 0) {
+		k_timer_start(&batch_timer[1], K_TICKS(1), K_NO_WAIT);
+	}
+}
+
+/**
+ * @brief Test timers expiring on the same tick
+ *
+ * Starts several timers with the same absolute expiry. All of them must
+ * expire on that tick, in the order they were started, and a timer restarted
+ * from the expiry function of another one due on the same tick must only
+ * expire at its new time.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start()
+ */
+ZTEST(timer_api, test_timer_same_tick)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	int64_t target = k_uptime_ticks() + k_ms_to_ticks_ceil32(DURATION);
+
+	batch_expired = 0;
+	for (int i = 0; i < BATCH_TIMERS; i++) {
+		k_timer_init(&batch_timer[i], batch_expire, NULL);
+		batch_expiry[i] = 0;
+	}
+
+	for (int i = 0; i < BATCH_TIMERS; i++) {
+		k_timer_start(&batch_timer[i], K_TIMEOUT_ABS_TICKS(target), K_NO_WAIT);
+	}
+
+	wait_ticks(k_ms_to_ticks_ceil32(2 * DURATION));
+
+	zassert_equal(batch_expired, BATCH_TIMERS);
+	zassert_true(batch_expiry[1] > target, "restarted timer expired early");
+	zassert_equal(k_timer_status_get(&batch_timer[1]), 1);
+	for (int i = 0; i < BATCH_TIMERS; i++) {
+		if (i != 1) {
+			zassert_equal(batch_expiry[i], target);
+			zassert_equal(k_timer_status_get(&batch_timer[i]), 1);
+		}
+	}
+#else
+	ztest_test_skip();
+#endif /* CONFIG_TIMEOUT_64BIT */
+}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+#define SLACK_TIMERS 8
+#define SLACK_TICKS 16
+
+static struct k_timer slack_timer[SLACK_TIMERS];
+static int64_t slack_expiry[SLACK_TIMERS];
+
+static void slack_expire(struct k_timer *timer)
+{
+	slack_expiry[timer - slack_timer] = k_uptime_ticks();
+}
+
+/**
+ * @brief Test coalescing of timers with slack
+ *
+ * Starts timers with staggered durations and a slack of SLACK_TICKS. Each
+ * one must expire within its slack, on a tick aligned to SLACK_TICKS, so
+ * that all of them expire on at most two distinct ticks.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set(), k_timer_start()
+ */
+ZTEST(timer_api, test_timer_slack)
+{
+	int64_t start, end;
+	int distinct = 0;
+
+	for (int i = 0; i < SLACK_TIMERS; i++) {
+		k_timer_init(&slack_timer[i], slack_expire, NULL);
+		k_timer_slack_set(&slack_timer[i], K_TICKS(SLACK_TICKS));
+		slack_expiry[i] = 0;
+	}
+
+	start = k_uptime_ticks();
+	for (int i = 0; i < SLACK_TIMERS; i++) {
+		k_timer_start(&slack_timer[i], K_TICKS(20 + i), K_NO_WAIT);
+	}
+	end = k_uptime_ticks();
+
+	wait_ticks(20 + SLACK_TIMERS + (2 * SLACK_TICKS));
+
+	for (int i = 0; i < SLACK_TIMERS; i++) {
+		zassert_true(slack_expiry[i] >= start + 20 + i,
+			     "timer %d expired early", i);
+		zassert_true(slack_expiry[i] <= end + 20 + i + SLACK_TICKS,
+			     "timer %d expired past its slack", i);
+		zassert_equal(slack_expiry[i] % SLACK_TICKS, 0);
+		if ((i == 0) || (slack_expiry[i] != slack_expiry[i - 1])) {
+			distinct++;
+		}
+	}
+
+	zassert_true(distinct <= 2, "%d expiry ticks", distinct);
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -550,5 +550,75 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_USAGE_HISTOGRAM
+#define HISTOGRAM_WAKEUPS 4
+
+static K_SEM_DEFINE(histogram_sem, 0, 1);
+
+/**
+ * @brief Helper thread to test_thread_stats_histogram()
+ */
+void helper_waiter(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_sem_take(&histogram_sem, K_FOREVER);
+	}
+}
+
+static uint32_t histogram_sum(const k_thread_runtime_stats_t *stats)
+{
+	uint32_t sum = 0;
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(stats->histogram); i++) {
+		sum += stats->histogram[i];
+	}
+
+	return sum;
+}
+
+/**
+ * @brief Test the scheduling latency and run queue depth histograms
+ *
+ * 1. Create a higher priority helper thread that waits on a semaphore.
+ * 2. Wake it up several times.
+ *    - Each wakeup adds a sample to the helper's latency histogram
+ *    - Each context switch adds a sample to the CPU's run queue histogram
+ */
+ZTEST(usage_api, test_thread_stats_histogram)
+{
+	k_thread_runtime_stats_t  stats1;
+	k_thread_runtime_stats_t  stats2;
+	k_thread_runtime_stats_t  cpu_stats1;
+	k_thread_runtime_stats_t  cpu_stats2;
+	k_tid_t  tid;
+	int  priority;
+
+	priority = k_thread_priority_get(_current);
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_waiter, NULL, NULL, NULL,
+			      priority - 1, 0, K_NO_WAIT);
+
+	/* The helper has run and is now waiting on the semaphore */
+
+	k_thread_runtime_stats_get(tid, &stats1);
+	k_thread_runtime_stats_cpu_get(0, &cpu_stats1);
+
+	for (int i = 0; i < HISTOGRAM_WAKEUPS; i++) {
+		k_sem_give(&histogram_sem);
+	}
+
+	k_thread_runtime_stats_get(tid, &stats2);
+	k_thread_runtime_stats_cpu_get(0, &cpu_stats2);
+
+	zassert_true(histogram_sum(&stats2) >=
+		     histogram_sum(&stats1) + HISTOGRAM_WAKEUPS);
+	zassert_true(histogram_sum(&cpu_stats2) >=
+		     histogram_sum(&cpu_stats1) + 2 * HISTOGRAM_WAKEUPS);
+
+	k_thread_abort(tid);
+}
+#endif /* CONFIG_SCHED_THREAD_USAGE_HISTOGRAM */
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
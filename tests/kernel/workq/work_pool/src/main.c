@@ -0,0 +1,244 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define NUM_WORKERS 3
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORKER_PRIORITY K_PRIO_PREEMPT(1)
+#define WAIT_TIMEOUT K_MSEC(1000)
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q_worker pool_workers[NUM_WORKERS];
+static struct k_work_q pool_queue;
+
+static struct k_work works[NUM_WORKERS];
+static k_tid_t work_threads[NUM_WORKERS];
+
+/* Given by handlers once they start running */
+static K_SEM_DEFINE(started_sem, 0, NUM_WORKERS);
+
+/* Given by the test to release blocked handlers */
+static K_SEM_DEFINE(rel_sem, 0, NUM_WORKERS);
+
+static atomic_t run_count;
+static atomic_t active_count;
+static atomic_t max_active;
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+static void track_enter(void)
+{
+	atomic_val_t active = atomic_inc(&active_count) + 1;
+	atomic_val_t max = atomic_get(&max_active);
+
+	while ((active > max) && !atomic_cas(&max_active, max, active)) {
+		max = atomic_get(&max_active);
+	}
+}
+
+static void track_exit(void)
+{
+	(void)atomic_dec(&active_count);
+	(void)atomic_inc(&run_count);
+}
+
+/* Record the worker, then block until released by the test. */
+static void blocking_handler(struct k_work *work)
+{
+	size_t idx = work - works;
+
+	track_enter();
+	work_threads[idx] = k_current_get();
+	k_sem_give(&started_sem);
+	k_sem_take(&rel_sem, K_FOREVER);
+	track_exit();
+}
+
+static void sleeping_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	track_enter();
+	k_msleep(10);
+	track_exit();
+}
+
+static void chaining_handler(struct k_work *work)
+{
+	size_t idx = work - works;
+
+	track_enter();
+	if ((idx + 1) < NUM_WORKERS) {
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &works[idx + 1]), 1);
+	}
+	k_msleep(10);
+	track_exit();
+}
+
+static void pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_set(&run_count, 0);
+	atomic_set(&active_count, 0);
+	atomic_set(&max_active, 0);
+	k_sem_reset(&started_sem);
+	k_sem_reset(&rel_sem);
+}
+
+static void *pool_setup(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "work_pool",
+	};
+
+	k_work_queue_init(&pool_queue);
+	k_work_queue_pool_start(&pool_queue, pool_workers, &pool_stacks[0][0],
+				NUM_WORKERS, STACK_SIZE, WORKER_PRIORITY, &cfg);
+
+	zassert_equal(k_work_queue_thread_get(&pool_queue), &pool_workers[0].thread);
+
+	return NULL;
+}
+
+/* Blocked items occupy one worker each and are all started at once. */
+ZTEST(work_pool, test_parallel)
+{
+	for (size_t i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&works[i], blocking_handler);
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &works[i]), 1);
+	}
+
+	for (size_t i = 0; i < NUM_WORKERS; i++) {
+		zassert_ok(k_sem_take(&started_sem, WAIT_TIMEOUT));
+	}
+
+	for (size_t i = 0; i < NUM_WORKERS; i++) {
+		for (size_t j = i + 1; j < NUM_WORKERS; j++) {
+			zassert_not_equal(work_threads[i], work_threads[j]);
+		}
+	}
+
+	for (size_t i = 0; i < NUM_WORKERS; i++) {
+		k_sem_give(&rel_sem);
+	}
+
+	zassert_true(k_work_queue_drain(&pool_queue, false) >= 0);
+	zassert_equal(atomic_get(&run_count), NUM_WORKERS);
+	zassert_equal(atomic_get(&max_active), NUM_WORKERS);
+}
+
+/* A running item that is resubmitted runs again on the same worker,
+ * never concurrently with itself.
+ */
+ZTEST(work_pool, test_resubmit_running)
+{
+	k_work_init(&works[0], blocking_handler);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), 1);
+	zassert_ok(k_sem_take(&started_sem, WAIT_TIMEOUT));
+
+	k_tid_t first = work_threads[0];
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), 2);
+	zassert_equal(k_work_busy_get(&works[0]), K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* Idle workers must not pick up the resubmission */
+	zassert_equal(k_sem_take(&started_sem, K_MSEC(50)), -EAGAIN);
+
+	k_sem_give(&rel_sem);
+	zassert_ok(k_sem_take(&started_sem, WAIT_TIMEOUT));
+	zassert_equal(work_threads[0], first);
+	k_sem_give(&rel_sem);
+
+	(void)k_work_flush(&works[0], &work_sync);
+	zassert_equal(atomic_get(&run_count), 2);
+	zassert_equal(atomic_get(&max_active), 1);
+}
+
+/* Flushing waits for queued and running items wherever they are. */
+ZTEST(work_pool, test_flush)
+{
+	for (size_t i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&works[i], sleeping_handler);
+		zassert_equal(k_work_submit_to_queue(&pool_queue, &works[i]), 1);
+	}
+
+	for (size_t i = 0; i < NUM_WORKERS; i++) {
+		(void)k_work_flush(&works[i], &work_sync);
+		zassert_equal(k_work_busy_get(&works[i]), 0);
+	}
+
+	zassert_equal(atomic_get(&run_count), NUM_WORKERS);
+	zassert_false(k_work_flush(&works[0], &work_sync));
+}
+
+/* Cancelling a running item waits for its handler to return. */
+ZTEST(work_pool, test_cancel_sync)
+{
+	k_work_init(&works[0], blocking_handler);
+	k_work_init(&works[1], sleeping_handler);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), 1);
+	zassert_ok(k_sem_take(&started_sem, WAIT_TIMEOUT));
+
+	/* Queued behind the running copy, so removed by the cancel */
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), 2);
+	zassert_equal(k_work_cancel(&works[0]), K_WORK_RUNNING | K_WORK_CANCELING);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), -EBUSY);
+
+	/* Other items still run on the remaining workers */
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[1]), 1);
+	(void)k_work_flush(&works[1], &work_sync);
+	zassert_equal(k_work_busy_get(&works[0]), K_WORK_RUNNING | K_WORK_CANCELING);
+
+	k_sem_give(&rel_sem);
+	(void)k_work_cancel_sync(&works[0], &work_sync);
+	zassert_equal(k_work_busy_get(&works[0]), 0);
+	zassert_equal(atomic_get(&run_count), 2);
+}
+
+/* Items submitted from a worker are accepted while draining, and drain
+ * waits for all of them.
+ */
+ZTEST(work_pool, test_chained_drain)
+{
+	for (size_t i = 0; i < NUM_WORKERS; i++) {
+		k_work_init(&works[i], chaining_handler);
+	}
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), 1);
+	zassert_true(k_work_queue_drain(&pool_queue, true) >= 0);
+	zassert_equal(atomic_get(&run_count), NUM_WORKERS);
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), -EBUSY);
+	zassert_ok(k_work_queue_unplug(&pool_queue));
+}
+
+/* Stopping joins every worker; the queue can then be restarted. */
+ZTEST(work_pool, test_stop_restart)
+{
+	struct k_work_queue_config cfg = {
+		.name = "work_pool",
+	};
+
+	k_work_init(&works[0], sleeping_handler);
+
+	zassert_equal(k_work_queue_stop(&pool_queue, K_FOREVER), -EBUSY);
+	zassert_true(k_work_queue_drain(&pool_queue, true) >= 0);
+	zassert_ok(k_work_queue_stop(&pool_queue, K_FOREVER));
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), -ENODEV);
+
+	k_work_queue_pool_start(&pool_queue, pool_workers, &pool_stacks[0][0],
+				NUM_WORKERS, STACK_SIZE, WORKER_PRIORITY, &cfg);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &works[0]), 1);
+	(void)k_work_flush(&works[0], &work_sync);
+	zassert_equal(atomic_get(&run_count), 1);
+}
+
+ZTEST_SUITE(work_pool, NULL, pool_setup, pool_before, NULL, NULL);
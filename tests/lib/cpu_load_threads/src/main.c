@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/cpu_load.h>
+
+#define PERIOD_MS   CONFIG_CPU_LOAD_METRIC_THREADS_PERIOD
+#define NUM_WINDOWS CONFIG_CPU_LOAD_METRIC_THREADS_HISTORY
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(busy_stack, STACK_SIZE);
+static struct k_thread busy_thread;
+static struct cpu_load_window window;
+
+/* Busy for about half of each window */
+static void busy_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_busy_wait(PERIOD_MS * USEC_PER_MSEC / 20U);
+		k_msleep(PERIOD_MS / 20U);
+	}
+}
+
+static void wait_windows(unsigned int n)
+{
+	k_msleep(n * PERIOD_MS + (PERIOD_MS / 2U));
+}
+
+static const struct cpu_load_thread *window_find(const struct cpu_load_window *w,
+						 k_tid_t thread)
+{
+	for (unsigned int i = 0; i < w->num_threads; i++) {
+		if (w->threads[i].thread == thread) {
+			return &w->threads[i];
+		}
+	}
+
+	return NULL;
+}
+
+ZTEST(cpu_load_threads, test_invalid_age)
+{
+	struct cpu_load_thread top[1];
+
+	zassert_equal(cpu_load_threads_get(NUM_WINDOWS, &window), -EINVAL);
+	zassert_equal(cpu_load_threads_top(NUM_WINDOWS, top, ARRAY_SIZE(top)), -EINVAL);
+}
+
+ZTEST(cpu_load_threads, test_window)
+{
+	unsigned int total = 0U;
+
+	wait_windows(1);
+
+	zassert_ok(cpu_load_threads_get(0, &window));
+	zassert_true(window.num_threads > 0U);
+	zassert_true(window.num_threads <= CONFIG_CPU_LOAD_METRIC_THREADS_MAX);
+	zassert_true(window.cycles > 0U);
+	zassert_true(window.locked_cycles <= window.sample_cycles);
+
+	for (unsigned int i = 0; i < window.num_threads; i++) {
+		const struct cpu_load_thread *entry = &window.threads[i];
+
+		if (i > 0U) {
+			zassert_true(window.threads[i - 1].cycles >= entry->cycles,
+				     "window not sorted at %u", i);
+		}
+		zassert_true(entry->load <= 1000U);
+		total += entry->load;
+	}
+
+	/* Loads are in per mille of one CPU */
+	zassert_true(total <= 1050U * arch_num_cpus(), "total load %u", total);
+}
+
+ZTEST(cpu_load_threads, test_busy_thread)
+{
+	struct cpu_load_thread top[CONFIG_CPU_LOAD_METRIC_THREADS_MAX];
+	const struct cpu_load_thread *entry;
+	int n;
+
+	if (CONFIG_CPU_LOAD_METRIC_THREADS_MAX < 4) {
+		ztest_test_skip();
+	}
+
+	k_thread_create(&busy_thread, busy_stack, STACK_SIZE, busy_fn,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_thread_name_set(&busy_thread, "busy");
+
+	/* The first window may only cover part of the thread's life */
+	wait_windows(2);
+
+	zassert_ok(cpu_load_threads_get(0, &window));
+	entry = window_find(&window, &busy_thread);
+	zassert_not_null(entry, "busy thread not sampled");
+	zassert_within(entry->load, 500U, 150U);
+	zassert_str_equal(entry->name, "busy");
+
+	n = cpu_load_threads_top(0, top, 1);
+	zassert_equal(n, 1);
+	zassert_equal(top[0].thread, window.threads[0].thread);
+
+	k_thread_abort(&busy_thread);
+	wait_windows(2);
+
+	zassert_ok(cpu_load_threads_get(0, &window));
+	zassert_is_null(window_find(&window, &busy_thread), "exited thread still sampled");
+}
+
+ZTEST(cpu_load_threads, test_untracked)
+{
+	if (CONFIG_CPU_LOAD_METRIC_THREADS_MAX > 2) {
+		ztest_test_skip();
+	}
+
+	wait_windows(1);
+
+	/* At least main, idle and the system work queue are running */
+	zassert_ok(cpu_load_threads_get(0, &window));
+	zassert_equal(window.num_threads, CONFIG_CPU_LOAD_METRIC_THREADS_MAX);
+	zassert_true(window.untracked > 0U);
+}
+
+ZTEST_SUITE(cpu_load_threads, NULL, NULL, NULL, NULL, NULL);